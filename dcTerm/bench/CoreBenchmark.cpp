@@ -0,0 +1,443 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: CoreBenchmark.cpp - Measures the throughput of the receive path.
+--
+-- PROGRAM: dcterm_bench
+--
+-- FUNCTIONS:
+-- int main(int argc, char* argv[]);
+-- QByteArray makeFrames(int size, int frameSize);
+-- QByteArray slipEncode(const QByteArray &frames, int frameSize);
+-- QByteArray cobsEncode(const QByteArray &frames, int frameSize);
+-- QByteArray makeText(int size);
+-- void report(QTextStream &out, const char* name, qint64 bytes, qint64 nsecs);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Added control character glyphs against plain conversion to text.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- Runs each stage of the receive path over generated traffic fed in port-sized chunks and prints
+-- the throughput in MB/s. It is also the workload used for the GENERATE pass of a PGO build.
+--
+--     dcterm_bench [megabytes]
+--------------------------------------------------------------------------------------------------*/
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QTextStream>
+#include <QTime>
+#include <QVector>
+
+#include "ControlGlyphs.h"
+#include "FrameDecoder.h"
+#include "FrameFormat.h"
+#include "HighlightRules.h"
+#include "SerialSession.h"
+#include "TimingRecorder.h"
+#include "TriggerEngine.h"
+
+static const int CHUNK_SIZE = 4096;
+static const int FRAME_SIZE = 64;
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: makeFrames
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QByteArray makeFrames (int size, int frameSize)
+--
+-- RETURNS: QByteArray - size bytes of pseudo random payload, a whole number of frames long.
+--------------------------------------------------------------------------------------------------*/
+QByteArray makeFrames(int size, int frameSize)
+{
+	QByteArray data(size - size % frameSize, '\0');
+	quint32 seed = 12345;
+	for (int i = 0; i < data.size(); i++)
+	{
+		seed = seed * 1103515245 + 12345;
+		data[i] = static_cast<char>(seed >> 16);
+	}
+	return data;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: slipEncode
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QByteArray slipEncode (const QByteArray &frames, int frameSize)
+--
+-- RETURNS: QByteArray - the frames SLIP encoded, each ended by END.
+--------------------------------------------------------------------------------------------------*/
+QByteArray slipEncode(const QByteArray &frames, int frameSize)
+{
+	QByteArray out;
+	out.reserve(frames.size() * 2);
+	for (int i = 0; i < frames.size(); i++)
+	{
+		unsigned char c = static_cast<unsigned char>(frames[i]);
+		if (c == 0xC0)
+		{
+			out.append('\xDB').append('\xDC');
+		}
+		else if (c == 0xDB)
+		{
+			out.append('\xDB').append('\xDD');
+		}
+		else
+		{
+			out.append(static_cast<char>(c));
+		}
+
+		if ((i + 1) % frameSize == 0)
+		{
+			out.append('\xC0');
+		}
+	}
+	return out;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: cobsEncode
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QByteArray cobsEncode (const QByteArray &frames, int frameSize)
+--
+-- RETURNS: QByteArray - the frames COBS encoded, each ended by a zero byte.
+--
+-- NOTES:
+-- frameSize must be less than 254 so no frame needs a full 0xFF block.
+--------------------------------------------------------------------------------------------------*/
+QByteArray cobsEncode(const QByteArray &frames, int frameSize)
+{
+	QByteArray out;
+	out.reserve(frames.size() * 2);
+	for (int start = 0; start < frames.size(); start += frameSize)
+	{
+		int code = out.size();
+		out.append('\x01');
+		for (int i = start; i < start + frameSize; i++)
+		{
+			if (frames[i] == '\0')
+			{
+				code = out.size();
+				out.append('\x01');
+			}
+			else
+			{
+				out.append(frames[i]);
+				out[code] = static_cast<char>(out[code] + 1);
+			}
+		}
+		out.append('\0');
+	}
+	return out;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: makeText
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QByteArray makeText (int size)
+--
+-- RETURNS: QByteArray - size bytes of log-like text lines.
+--------------------------------------------------------------------------------------------------*/
+QByteArray makeText(int size)
+{
+	static const char* const lines[] =
+	{
+		"[    0.000000] Booting Linux on physical CPU 0x0\r\n",
+		"[    0.120431] serial8250: ttyS0 at I/O 0x3f8 (irq = 4) is a 16550A\r\n",
+		"sensor temp=41.5 hum=33 status=OK\r\n",
+		"login: ",
+	};
+
+	QByteArray text;
+	text.reserve(size);
+	for (int i = 0; text.size() < size; i++)
+	{
+		text.append(lines[i % 4]);
+	}
+	text.resize(size);
+	return text;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: report
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Set the alignment on the stream and end lines with '\n' and a flush, since
+--     the endl and left manipulators are deprecated from Qt 5.15 but Qt::endl is not in 5.9.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void report (QTextStream &out, const char* name, qint64 bytes, qint64 nsecs)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Each result is flushed as soon as it is known so a long run shows its progress.
+--------------------------------------------------------------------------------------------------*/
+void report(QTextStream &out, const char* name, qint64 bytes, qint64 nsecs)
+{
+	double seconds = nsecs / 1e9;
+	out.setFieldAlignment(QTextStream::AlignLeft);
+	out << qSetFieldWidth(24) << name << qSetFieldWidth(0)
+		<< QString::number(bytes / seconds / (1024.0 * 1024.0), 'f', 1) << " MB/s\n";
+	out.flush();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: main
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int main (int argc, char* argv[])
+--
+-- RETURNS: int - 0.
+--
+-- NOTES:
+-- Each benchmark counts what it consumes in a volatile sink so the work cannot be optimized away.
+--------------------------------------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+	QTextStream out(stdout);
+	int megabytes = argc > 1 ? QByteArray(argv[1]).toInt() : 16;
+	if (megabytes <= 0)
+	{
+		megabytes = 16;
+	}
+	const int size = megabytes * 1024 * 1024;
+
+	QByteArray frames = makeFrames(size, FRAME_SIZE);
+	QByteArray text = makeText(size);
+	volatile qint64 sink = 0;
+	QElapsedTimer timer;
+
+	// Frame decoders
+	{
+		QByteArray slip = slipEncode(frames, FRAME_SIZE);
+		SlipDecoder decoder;
+		qint64 count = 0;
+		timer.start();
+		for (int i = 0; i < slip.size(); i += CHUNK_SIZE)
+		{
+			decoder.feed(slip.constData() + i, qMin(CHUNK_SIZE, slip.size() - i),
+				[&count](const char*, int length, FrameDecoder::FrameStatus) { count += length; });
+		}
+		report(out, "slip decode", slip.size(), timer.nsecsElapsed());
+		sink += count;
+	}
+	{
+		QByteArray cobs = cobsEncode(frames, FRAME_SIZE);
+		CobsDecoder decoder;
+		qint64 count = 0;
+		timer.start();
+		for (int i = 0; i < cobs.size(); i += CHUNK_SIZE)
+		{
+			decoder.feed(cobs.constData() + i, qMin(CHUNK_SIZE, cobs.size() - i),
+				[&count](const char*, int length, FrameDecoder::FrameStatus) { count += length; });
+		}
+		report(out, "cobs decode", cobs.size(), timer.nsecsElapsed());
+		sink += count;
+	}
+
+	// Trigger rules
+	{
+		QVector<TriggerRule> rules;
+		for (int i = 0; i < 64; i++)
+		{
+			TriggerRule rule = { TriggerRule::Literal, QString("pattern-%1").arg(i), TriggerRule::Beep, QString() };
+			rules.append(rule);
+		}
+		TriggerRule login = { TriggerRule::Literal, "login: ", TriggerRule::Beep, QString() };
+		TriggerRule temp = { TriggerRule::Regex, "temp=(\\d+)", TriggerRule::Beep, QString() };
+		rules.append(login);
+		rules.append(temp);
+
+		TriggerEngine engine;
+		engine.setRules(rules);
+		QVector<TriggerMatch> matches;
+		timer.start();
+		for (int i = 0; i < text.size(); i += CHUNK_SIZE)
+		{
+			matches.clear();
+			engine.process(text.constData() + i, qMin(CHUNK_SIZE, text.size() - i), matches);
+			sink += matches.size();
+		}
+		report(out, "trigger rules", text.size(), timer.nsecsElapsed());
+	}
+
+	// Highlight rules, one line at a time as the console styles them, with none and with 24 rules
+	{
+		QList<QByteArray> lines = text.split('\n');
+		QStringList strings;
+		for (const QByteArray &line : lines)
+		{
+			strings << QString::fromLocal8Bit(line);
+		}
+
+		QVector<HighlightRule> rules;
+		for (int i = 0; i < 22; i++)
+		{
+			HighlightRule rule = { QString("\\bcode-%1\\b").arg(i), "cyan", QString(), false, false, false };
+			rules.append(rule);
+		}
+		HighlightRule error = { "\\b(ERROR|FATAL)\\b.*", "red", QString(), true, false, false };
+		HighlightRule status = { "status=\\w+", "yellow", QString(), false, false, false };
+		rules.append(error);
+		rules.append(status);
+
+		HighlightRules none;
+		HighlightRules many;
+		many.setRules(rules);
+		QVector<HighlightSpan> spans;
+
+		timer.start();
+		for (const QString &line : strings)
+		{
+			none.match(line, spans);
+			sink += spans.size();
+		}
+		report(out, "highlight 0 rules", text.size(), timer.nsecsElapsed());
+
+		timer.start();
+		for (const QString &line : strings)
+		{
+			many.match(line, spans);
+			sink += spans.size();
+		}
+		report(out, "highlight 24 rules", text.size(), timer.nsecsElapsed());
+	}
+
+	// Console text, as the console converts each chunk, plain and with control character glyphs,
+	// then with glyphs over text that has a control character or invalid byte every 256 bytes
+	{
+		QByteArray noisy = text;
+		for (int i = 255; i < noisy.size(); i += 256)
+		{
+			noisy[i] = (i & 256) ? '\x1b' : '\xff';
+		}
+
+		qint64 count = 0;
+		timer.start();
+		for (int i = 0; i < text.size(); i += CHUNK_SIZE)
+		{
+			QByteArray chunk = QByteArray::fromRawData(text.constData() + i, qMin(CHUNK_SIZE, text.size() - i));
+			count += QString(chunk).size();
+		}
+		report(out, "text plain", text.size(), timer.nsecsElapsed());
+
+		ControlGlyphs glyphs;
+		QString rendered;
+		QVector<GlyphSpan> spans;
+		timer.start();
+		for (int i = 0; i < text.size(); i += CHUNK_SIZE)
+		{
+			rendered.clear();
+			spans.clear();
+			glyphs.render(text.constData() + i, qMin(CHUNK_SIZE, text.size() - i), rendered, spans);
+			count += rendered.size() + spans.size();
+		}
+		report(out, "text glyphs", text.size(), timer.nsecsElapsed());
+
+		timer.start();
+		for (int i = 0; i < noisy.size(); i += CHUNK_SIZE)
+		{
+			rendered.clear();
+			spans.clear();
+			glyphs.render(noisy.constData() + i, qMin(CHUNK_SIZE, noisy.size() - i), rendered, spans);
+			count += rendered.size() + spans.size();
+		}
+		report(out, "text glyphs noisy", noisy.size(), timer.nsecsElapsed());
+		sink += count;
+	}
+
+	// Timing capture, one batch per chunk
+	{
+		TimingRecorder recorder;
+		recorder.setFormat(115200, 10);
+		qint64 timestamp = 0;
+		timer.start();
+		for (int i = 0; i < size; i += 16)
+		{
+			timestamp += 1389;
+			recorder.record(timestamp, 16);
+		}
+		report(out, "timing record", size, timer.nsecsElapsed());
+		sink += recorder.memoryUsage();
+	}
+
+	// Frame rows
+	{
+		QTime time = QTime::currentTime();
+		int rows = qMin(frames.size() / FRAME_SIZE, 100000);
+		timer.start();
+		for (int i = 0; i < rows; i++)
+		{
+			sink += formatFrameRow(frames.constData() + i * FRAME_SIZE, FRAME_SIZE, FrameDecoder::FrameOk, time,
+				1024).size();
+		}
+		report(out, "frame rows", static_cast<qint64>(rows) * FRAME_SIZE, timer.nsecsElapsed());
+	}
+
+	// Whole receive path of a session with SLIP framing and trigger rules, without a view
+	{
+		QByteArray slip = slipEncode(frames, FRAME_SIZE);
+		TriggerRule rule = { TriggerRule::Literal, "login: ", TriggerRule::Beep, QString() };
+		SerialSession session;
+		session.triggers().setRules(QVector<TriggerRule>() << rule);
+		session.setDecoder(new SlipDecoder());
+		session.setTimingEnabled(true);
+		timer.start();
+		for (int i = 0; i < slip.size(); i += CHUNK_SIZE)
+		{
+			session.receive(QByteArray::fromRawData(slip.constData() + i, qMin(CHUNK_SIZE, slip.size() - i)));
+		}
+		report(out, "session receive", slip.size(), timer.nsecsElapsed());
+		sink += session.statistics().frames;
+	}
+
+	return sink == -1 ? 1 : 0;
+}
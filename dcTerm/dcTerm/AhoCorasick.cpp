@@ -0,0 +1,254 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: AhoCorasick.cpp - Streaming multi-pattern matcher for the receive path.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- void clear();
+-- int addPattern(const QByteArray &pattern);
+-- void build();
+--
+-- bool isEmpty() const;
+-- int patternCount() const;
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- An Aho-Corasick automaton finds every occurrence of every pattern in a single pass over the
+-- input, so the cost per received byte does not depend on how many patterns there are.
+--
+-- The automaton is compiled into a dense state transition table (256 entries per state) with the
+-- failure links already folded in, which turns matching into one table lookup per byte. The
+-- caller keeps the current state between chunks, so a pattern split across two reads from the
+-- serial port is still found.
+--
+-- Typical use:
+--
+--     state = matcher.next(state, byte);
+--     for (int i = 0; i < matcher.matchCount(state); i++)
+--         handle(matcher.matches(state)[i]);
+--------------------------------------------------------------------------------------------------*/
+#include <algorithm>
+
+#include <QQueue>
+
+#include "AhoCorasick.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: AhoCorasick ()
+--
+-- NOTES:
+-- Constructor for a matcher with no patterns. It is usable immediately and never matches.
+--------------------------------------------------------------------------------------------------*/
+AhoCorasick::AhoCorasick()
+{
+	build();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: clear
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void clear (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Removes every pattern.
+--------------------------------------------------------------------------------------------------*/
+void AhoCorasick::clear()
+{
+	mPatterns.clear();
+	build();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: addPattern
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int addPattern (const QByteArray &pattern)
+--
+-- RETURNS: int - the id reported by matches() when this pattern is found.
+--
+-- NOTES:
+-- Queues a pattern to be compiled by the next call to build(). Ids are handed out in order
+-- starting at 0.
+--------------------------------------------------------------------------------------------------*/
+int AhoCorasick::addPattern(const QByteArray &pattern)
+{
+	mPatterns.append(pattern);
+	return mPatterns.size() - 1;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: build
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void build (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Compiles the patterns into the transition table.
+--
+-- First a trie of the patterns is built, with missing edges marked -1. A breadth first walk then
+-- computes each state's failure state and fills every missing edge with the edge taken from the
+-- failure state, which is already complete because it is shallower. The pattern ids of the
+-- failure state are added to each state's own ids so suffix matches are never missed. Finally the
+-- per-state id lists are flattened into one array.
+--------------------------------------------------------------------------------------------------*/
+void AhoCorasick::build()
+{
+	QVector<int> delta(256, -1);
+	QVector<QVector<int> > outputs(1);
+
+	for (int id = 0; id < mPatterns.size(); id++)
+	{
+		const QByteArray &pattern = mPatterns[id];
+		if (pattern.isEmpty())
+		{
+			continue;
+		}
+
+		int state = 0;
+		for (int i = 0; i < pattern.size(); i++)
+		{
+			int edge = (state << 8) | static_cast<unsigned char>(pattern[i]);
+			if (delta[edge] < 0)
+			{
+				delta[edge] = outputs.size();
+				delta.resize(delta.size() + 256);
+				std::fill(delta.end() - 256, delta.end(), -1);
+				outputs.append(QVector<int>());
+			}
+			state = delta[edge];
+		}
+		outputs[state].append(id);
+	}
+
+	const int states = outputs.size();
+	QVector<int> fail(states, 0);
+	QQueue<int> queue;
+
+	for (int c = 0; c < 256; c++)
+	{
+		if (delta[c] < 0)
+		{
+			delta[c] = 0;
+		}
+		else
+		{
+			queue.enqueue(delta[c]);
+		}
+	}
+
+	while (!queue.isEmpty())
+	{
+		int state = queue.dequeue();
+		outputs[state] += outputs[fail[state]];
+
+		for (int c = 0; c < 256; c++)
+		{
+			int edge = (state << 8) | c;
+			int target = delta[edge];
+			int fallback = delta[(fail[state] << 8) | c];
+
+			if (target < 0)
+			{
+				delta[edge] = fallback;
+			}
+			else
+			{
+				fail[target] = fallback;
+				queue.enqueue(target);
+			}
+		}
+	}
+
+	mDelta = delta;
+	mOutputStart.resize(states + 1);
+	mOutputs.clear();
+	for (int state = 0; state < states; state++)
+	{
+		mOutputStart[state] = mOutputs.size();
+		mOutputs += outputs[state];
+	}
+	mOutputStart[states] = mOutputs.size();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: isEmpty
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool isEmpty (void) const
+--
+-- RETURNS: bool - true if there are no patterns to match.
+--------------------------------------------------------------------------------------------------*/
+bool AhoCorasick::isEmpty() const
+{
+	return mPatterns.isEmpty();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: patternCount
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int patternCount (void) const
+--
+-- RETURNS: int - the number of patterns added since the last clear().
+--------------------------------------------------------------------------------------------------*/
+int AhoCorasick::patternCount() const
+{
+	return mPatterns.size();
+}
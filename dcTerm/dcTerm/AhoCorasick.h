@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QByteArray>
+#include <QVector>
+
+class AhoCorasick
+{
+public:
+	AhoCorasick();
+
+	void clear();
+	int addPattern(const QByteArray &pattern);
+	void build();
+
+	bool isEmpty() const;
+	int patternCount() const;
+
+	inline int next(int state, unsigned char c) const
+	{
+		return mDelta[(state << 8) | c];
+	}
+
+	inline int matchCount(int state) const
+	{
+		return mOutputStart[state + 1] - mOutputStart[state];
+	}
+
+	inline const int* matches(int state) const
+	{
+		return mOutputs.constData() + mOutputStart[state];
+	}
+
+private:
+	QVector<QByteArray> mPatterns;
+
+	QVector<int> mDelta;
+	QVector<int> mOutputStart;
+	QVector<int> mOutputs;
+};
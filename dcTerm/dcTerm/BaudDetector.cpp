@@ -0,0 +1,507 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: BaudDetector.cpp - Works out a port's bit rate and framing from what it receives.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- void start(const QVector<qint32> &bitRates);
+-- void stop();
+-- bool isRunning() const;
+--
+-- const BaudCandidate &current() const;
+-- int dwell() const;
+-- void feed(const char* data, int size);
+-- bool hasEnough() const;
+-- bool advance();
+--
+-- bool found() const;
+-- BaudCandidate best() const;
+-- int bestScore() const;
+--
+-- int score(int candidate, BaudCandidate* settings) const;
+-- int bestCandidate(BaudCandidate* settings) const;
+-- const quint8* byteClasses();
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- The detector holds a list of candidate settings and a tally of what was received under each.
+-- SerialSession puts the port in each candidate's settings in turn, feeds the detector what it
+-- reads and moves on once the candidate has enough bytes or its dwell time is up.
+--
+-- Candidates are every bit rate with 8 data bits and no, even and odd parity, the common 8N1 first
+-- and the bit rates in the order given, so the usual settings are tried first. 7 data bits need no
+-- candidates of their own: 7E1 and 7O1 have the same 10 bit frame as 8N1, and read as 8N1 the
+-- eighth bit is the parity bit. If the bytes carry a set high bit and every byte has an even (or
+-- every byte an odd) number of ones, the line is 7E1 (or 7O1).
+--
+-- A wrong bit rate or frame length turns text into bytes with no pattern: framing and parity
+-- errors arrive as 0x00, a break or line noise as 0xFF, and the rest is spread over all 256
+-- values. Each byte is looked up once in a 256 entry class table and counted as it arrives, so
+-- scoring is incremental and costs a table lookup per byte. A candidate scores
+--
+--     (printable - 2 * suspicious) * 1000 / bytes
+--
+-- where printable is printable ASCII, tab, CR and LF and suspicious is 0x00 and 0xFF. A candidate
+-- scoring CONFIDENT_SCORE over ENOUGH_SAMPLE bytes ends the search early; otherwise the best
+-- candidate with at least MIN_SAMPLE bytes wins if it scores MIN_SCORE or more.
+--
+-- The scoring assumes the device sends mostly text, which is what a terminal is used with. A
+-- binary protocol looks much the same at every setting and is not detected.
+--------------------------------------------------------------------------------------------------*/
+#include "BaudDetector.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: BaudDetector ()
+--
+-- NOTES:
+-- Constructor for a detector that is not running.
+--------------------------------------------------------------------------------------------------*/
+BaudDetector::BaudDetector()
+	: mCurrent(0)
+	, mRunning(false)
+{
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: start
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void start (const QVector<qint32> &bitRates)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Builds the candidates for bitRates, most likely first, and starts at the first one.
+--------------------------------------------------------------------------------------------------*/
+void BaudDetector::start(const QVector<qint32> &bitRates)
+{
+	static const QSerialPort::Parity parities[] =
+	{
+		QSerialPort::NoParity, QSerialPort::EvenParity, QSerialPort::OddParity
+	};
+
+	mCandidates.clear();
+	for (QSerialPort::Parity parity : parities)
+	{
+		for (qint32 bitRate : bitRates)
+		{
+			BaudCandidate candidate = { bitRate, QSerialPort::Data8, parity };
+			mCandidates.append(candidate);
+		}
+	}
+
+	Tally empty = { 0, 0, 0, 0, 0, 0 };
+	mTallies.fill(empty, mCandidates.size());
+	mCurrent = 0;
+	mRunning = !mCandidates.isEmpty();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: stop
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void stop (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Stops the search. What was tallied so far is kept, so best() still gives the best so far.
+--------------------------------------------------------------------------------------------------*/
+void BaudDetector::stop()
+{
+	mRunning = false;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: isRunning
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool isRunning (void) const
+--
+-- RETURNS: bool - true while candidates are being tried.
+--------------------------------------------------------------------------------------------------*/
+bool BaudDetector::isRunning() const
+{
+	return mRunning;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: current
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: const BaudCandidate &current (void) const
+--
+-- RETURNS: const BaudCandidate& - the settings the port should be in now. Only valid while
+--          running.
+--------------------------------------------------------------------------------------------------*/
+const BaudCandidate &BaudDetector::current() const
+{
+	return mCandidates[mCurrent];
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: dwell
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int dwell (void) const
+--
+-- RETURNS: int - how many milliseconds to listen at the current candidate.
+--
+-- NOTES:
+-- Long enough for ENOUGH_SAMPLE characters of 11 bits to arrive at the candidate's bit rate, so
+-- slow rates get as fair a sample as fast ones, within MIN_DWELL and MAX_DWELL.
+--------------------------------------------------------------------------------------------------*/
+int BaudDetector::dwell() const
+{
+	qint64 milliseconds = static_cast<qint64>(ENOUGH_SAMPLE) * 11 * 1000 / qMax(1, current().bitRate);
+	return static_cast<int>(qBound<qint64>(MIN_DWELL, milliseconds, MAX_DWELL));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: feed
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void feed (const char* data, int size)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Counts size bytes received under the current candidate.
+--------------------------------------------------------------------------------------------------*/
+void BaudDetector::feed(const char* data, int size)
+{
+	if (!mRunning)
+	{
+		return;
+	}
+
+	const quint8* classes = byteClasses();
+	Tally &tally = mTallies[mCurrent];
+	for (int i = 0; i < size; i++)
+	{
+		quint8 c = classes[static_cast<quint8>(data[i])];
+		tally.printable += c & Printable;
+		tally.printable7 += (c & Printable7) >> 1;
+		tally.suspicious += (c & Suspicious) >> 2;
+		tally.highBit += (c & HighBit) >> 3;
+		tally.evenOnes += (c & EvenOnes) >> 4;
+	}
+	tally.bytes += size;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: hasEnough
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool hasEnough (void) const
+--
+-- RETURNS: bool - true once the current candidate has enough bytes to be judged without waiting
+--                 out its dwell time.
+--------------------------------------------------------------------------------------------------*/
+bool BaudDetector::hasEnough() const
+{
+	return mRunning && mTallies[mCurrent].bytes >= ENOUGH_SAMPLE;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: advance
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool advance (void)
+--
+-- RETURNS: bool - true if there is another candidate to try, false if the search is over.
+--
+-- NOTES:
+-- Moves on to the next candidate, unless the current one is confident enough to stop at.
+--------------------------------------------------------------------------------------------------*/
+bool BaudDetector::advance()
+{
+	if (!mRunning)
+	{
+		return false;
+	}
+
+	if (mTallies[mCurrent].bytes >= ENOUGH_SAMPLE && score(mCurrent, nullptr) >= CONFIDENT_SCORE)
+	{
+		mRunning = false;
+		return false;
+	}
+
+	mCurrent++;
+	mRunning = mCurrent < mCandidates.size();
+	if (!mRunning)
+	{
+		mCurrent = mCandidates.size() - 1;
+	}
+	return mRunning;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: found
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool found (void) const
+--
+-- RETURNS: bool - true if a candidate scored well enough to be trusted.
+--------------------------------------------------------------------------------------------------*/
+bool BaudDetector::found() const
+{
+	return bestScore() >= MIN_SCORE;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: best
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: BaudCandidate best (void) const
+--
+-- RETURNS: BaudCandidate - the best settings found, with 7 data bits if the parity bit showed in
+--                          the eighth. Only meaningful if found() is true.
+--------------------------------------------------------------------------------------------------*/
+BaudCandidate BaudDetector::best() const
+{
+	BaudCandidate settings = { 0, QSerialPort::Data8, QSerialPort::NoParity };
+	bestCandidate(&settings);
+	return settings;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: bestScore
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int bestScore (void) const
+--
+-- RETURNS: int - the best score in thousandths, 0 if no candidate received enough to be judged.
+--------------------------------------------------------------------------------------------------*/
+int BaudDetector::bestScore() const
+{
+	return bestCandidate(nullptr);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: score
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int score (int candidate, BaudCandidate* settings) const
+--
+-- RETURNS: int - how much what candidate received looks like text, in thousandths.
+--
+-- NOTES:
+-- A candidate without parity is also scored as 7E1 or 7O1 when its bytes show a parity bit, on
+-- the low 7 bits of each byte. settings, if given, is set to the settings that were scored.
+--------------------------------------------------------------------------------------------------*/
+int BaudDetector::score(int candidate, BaudCandidate* settings) const
+{
+	const Tally &tally = mTallies[candidate];
+	if (settings)
+	{
+		*settings = mCandidates[candidate];
+	}
+	if (tally.bytes < MIN_SAMPLE)
+	{
+		return 0;
+	}
+
+	int printable = tally.printable;
+	if (mCandidates[candidate].parity == QSerialPort::NoParity && tally.highBit * 20 >= tally.bytes)
+	{
+		bool even = tally.evenOnes * 50 >= tally.bytes * 49;
+		bool odd = (tally.bytes - tally.evenOnes) * 50 >= tally.bytes * 49;
+		if (even || odd)
+		{
+			printable = tally.printable7;
+			if (settings)
+			{
+				settings->dataBits = QSerialPort::Data7;
+				settings->parity = even ? QSerialPort::EvenParity : QSerialPort::OddParity;
+			}
+		}
+	}
+
+	return qMax(0, static_cast<int>((static_cast<qint64>(printable) - 2 * tally.suspicious) * 1000 / tally.bytes));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: bestCandidate
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int bestCandidate (BaudCandidate* settings) const
+--
+-- RETURNS: int - the highest score of any candidate.
+--
+-- NOTES:
+-- settings, if given, is set to the best candidate's settings. Of equal scores the earlier, more
+-- common candidate wins.
+--------------------------------------------------------------------------------------------------*/
+int BaudDetector::bestCandidate(BaudCandidate* settings) const
+{
+	int best = 0;
+	for (int i = 0; i < mCandidates.size(); i++)
+	{
+		BaudCandidate candidate;
+		int s = score(i, &candidate);
+		if (s > best)
+		{
+			best = s;
+			if (settings)
+			{
+				*settings = candidate;
+			}
+		}
+	}
+	return best;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: byteClasses
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: static const quint8* byteClasses (void)
+--
+-- RETURNS: const quint8* - the ByteClass flags of each of the 256 byte values.
+--
+-- NOTES:
+-- The table is built the first time it is asked for.
+--------------------------------------------------------------------------------------------------*/
+const quint8* BaudDetector::byteClasses()
+{
+	static const QVector<quint8> table = []()
+	{
+		QVector<quint8> t(256, 0);
+		for (int b = 0; b < 256; b++)
+		{
+			int low = b & 0x7F;
+			bool printable7 = (low >= 0x20 && low < 0x7F) || low == '\t' || low == '\r' || low == '\n';
+			int ones = 0;
+			for (int bit = b; bit; bit >>= 1)
+			{
+				ones += bit & 1;
+			}
+
+			quint8 c = 0;
+			c |= (printable7 && b < 0x80) ? Printable : 0;
+			c |= printable7 ? Printable7 : 0;
+			c |= (b == 0x00 || b == 0xFF) ? Suspicious : 0;
+			c |= (b & 0x80) ? HighBit : 0;
+			c |= (ones % 2 == 0) ? EvenOnes : 0;
+			t[b] = c;
+		}
+		return t;
+	}();
+	return table.constData();
+}
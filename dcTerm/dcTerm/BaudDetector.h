@@ -0,0 +1,68 @@
+#pragma once
+
+#include <QSerialPort>
+#include <QVector>
+
+struct BaudCandidate
+{
+	qint32 bitRate;
+	QSerialPort::DataBits dataBits;
+	QSerialPort::Parity parity;
+};
+
+class BaudDetector
+{
+public:
+	static const int MIN_SAMPLE = 32;
+	static const int ENOUGH_SAMPLE = 128;
+	static const int CONFIDENT_SCORE = 980;
+	static const int MIN_SCORE = 700;
+	static const int MIN_DWELL = 100;
+	static const int MAX_DWELL = 1000;
+
+	BaudDetector();
+
+	void start(const QVector<qint32> &bitRates);
+	void stop();
+	bool isRunning() const;
+
+	const BaudCandidate &current() const;
+	int dwell() const;
+	void feed(const char* data, int size);
+	bool hasEnough() const;
+	bool advance();
+
+	bool found() const;
+	BaudCandidate best() const;
+	int bestScore() const;
+
+private:
+	enum ByteClass
+	{
+		Printable = 0x01,
+		Printable7 = 0x02,
+		Suspicious = 0x04,
+		HighBit = 0x08,
+		EvenOnes = 0x10
+	};
+
+	struct Tally
+	{
+		int bytes;
+		int printable;
+		int printable7;
+		int suspicious;
+		int highBit;
+		int evenOnes;
+	};
+
+	QVector<BaudCandidate> mCandidates;
+	QVector<Tally> mTallies;
+	int mCurrent;
+	bool mRunning;
+
+	int score(int candidate, BaudCandidate* settings) const;
+	int bestCandidate(BaudCandidate* settings) const;
+
+	static const quint8* byteClasses();
+};
@@ -0,0 +1,239 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: BlockPool.cpp - Recycles fixed-size byte buffers.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- QByteArray acquire();
+-- void release(QByteArray &block);
+--
+-- int blockSize() const;
+-- int freeBlocks() const;
+-- qint64 allocations() const;
+-- qint64 reuses() const;
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- Reading the port and writing captures used to allocate a new buffer for every chunk. Over weeks
+-- of traffic that churn fragments the heap and memory use creeps up even though nothing is kept.
+-- A pool hands out QByteArrays with blockSize bytes of capacity reserved and takes them back when
+-- the holder is done, so the same few blocks are used over and over.
+--
+-- Blocks are ordinary QByteArrays, so handing one to code that keeps a copy is safe: a block that
+-- is still shared when it is released is simply left to its other holders and not recycled. At
+-- most maxFree blocks are kept idle; the rest are freed.
+--
+-- Every block the pool allocates is charged to a subsystem of the memory budget until it is freed
+-- or given up to another holder.
+--------------------------------------------------------------------------------------------------*/
+#include "BlockPool.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: BlockPool (int blockSize, int maxFree, MemoryBudget* budget,
+--                       MemoryBudget::Subsystem subsystem)
+--
+-- NOTES:
+-- Constructor for an empty pool of blockSize byte blocks, charging subsystem of budget if given.
+--------------------------------------------------------------------------------------------------*/
+BlockPool::BlockPool(int blockSize, int maxFree, MemoryBudget* budget, MemoryBudget::Subsystem subsystem)
+	: mBlockSize(blockSize)
+	, mMaxFree(maxFree)
+	, mBudget(budget)
+	, mSubsystem(subsystem)
+	, mAllocations(0)
+	, mReuses(0)
+{
+	mFree.reserve(maxFree);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Deconstructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: ~BlockPool ()
+--
+-- NOTES:
+-- Frees the idle blocks. Blocks still handed out stay charged until their holder releases them.
+--------------------------------------------------------------------------------------------------*/
+BlockPool::~BlockPool()
+{
+	if (mBudget)
+	{
+		mBudget->release(mSubsystem, static_cast<qint64>(mFree.size()) * mBlockSize);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: acquire
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QByteArray acquire (void)
+--
+-- RETURNS: QByteArray - an empty block with blockSize bytes reserved.
+--
+-- NOTES:
+-- Reuses an idle block if there is one. Because the capacity is reserved, resizing the block
+-- anywhere within blockSize, including to 0, never reallocates.
+--------------------------------------------------------------------------------------------------*/
+QByteArray BlockPool::acquire()
+{
+	if (!mFree.isEmpty())
+	{
+		QByteArray block = mFree.takeLast();
+		mReuses++;
+		return block;
+	}
+
+	QByteArray block;
+	block.reserve(mBlockSize);
+	mAllocations++;
+	if (mBudget)
+	{
+		mBudget->charge(mSubsystem, mBlockSize);
+	}
+	return block;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: release
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void release (QByteArray &block)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Takes block back and leaves the caller's array empty. The block is kept for reuse unless it is
+-- shared, has grown past blockSize or enough blocks are already idle.
+--------------------------------------------------------------------------------------------------*/
+void BlockPool::release(QByteArray &block)
+{
+	if (block.isDetached() && block.capacity() == mBlockSize && mFree.size() < mMaxFree)
+	{
+		block.resize(0);
+		mFree.append(block);
+	}
+	else if (mBudget)
+	{
+		mBudget->release(mSubsystem, mBlockSize);
+	}
+	block = QByteArray();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: blockSize
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int blockSize (void) const
+--
+-- RETURNS: int - the capacity of every block.
+--------------------------------------------------------------------------------------------------*/
+int BlockPool::blockSize() const
+{
+	return mBlockSize;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: freeBlocks
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int freeBlocks (void) const
+--
+-- RETURNS: int - the number of idle blocks waiting to be reused.
+--------------------------------------------------------------------------------------------------*/
+int BlockPool::freeBlocks() const
+{
+	return mFree.size();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: allocations
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 allocations (void) const
+--
+-- RETURNS: qint64 - the number of blocks allocated from the heap.
+--------------------------------------------------------------------------------------------------*/
+qint64 BlockPool::allocations() const
+{
+	return mAllocations;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: reuses
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 reuses (void) const
+--
+-- RETURNS: qint64 - the number of times an idle block was handed out instead of a new one.
+--------------------------------------------------------------------------------------------------*/
+qint64 BlockPool::reuses() const
+{
+	return mReuses;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QByteArray>
+#include <QVector>
+
+#include "MemoryBudget.h"
+
+class BlockPool
+{
+public:
+	BlockPool(int blockSize, int maxFree, MemoryBudget* budget = nullptr,
+		MemoryBudget::Subsystem subsystem = MemoryBudget::Receive);
+	~BlockPool();
+
+	QByteArray acquire();
+	void release(QByteArray &block);
+
+	int blockSize() const;
+	int freeBlocks() const;
+	qint64 allocations() const;
+	qint64 reuses() const;
+
+private:
+	int mBlockSize;
+	int mMaxFree;
+	MemoryBudget* mBudget;
+	MemoryBudget::Subsystem mSubsystem;
+
+	QVector<QByteArray> mFree;
+	qint64 mAllocations;
+	qint64 mReuses;
+};
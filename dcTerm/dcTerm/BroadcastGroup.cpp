@@ -0,0 +1,589 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: BroadcastGroup.cpp - Sends the same input to a group of serial ports.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- bool addPort(const SerialSettings &settings);
+-- void removePort(const QString &portName);
+-- void clear();
+--
+-- int count() const;
+-- QStringList portNames() const;
+-- BroadcastStatus status(int index) const;
+-- QString errorString() const;
+--
+-- void setEnabled(bool enabled);
+-- bool isEnabled() const;
+--
+-- void write(const QByteArray &data);
+--
+-- Member* memberFor(QObject* port) const;
+-- void drain(Member* member);
+-- void removeMember(Member* member);
+--
+-- void portWritten();
+-- void portRead();
+-- void portFailed(QSerialPort::SerialPortError error);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- A broadcast group is a set of extra serial ports, usually a rack of identical devices, that
+-- receive whatever is typed, pasted or sent by a script in the console as well as the session's
+-- own port.
+--
+-- Every member is given the same implicitly shared QByteArray, so fanning out to many ports never
+-- copies the data inside dcTerm. Each member has its own queue and is only handed up to
+-- WRITE_WINDOW bytes at a time; more is passed on as the port reports bytes written. The ports
+-- drain independently of each other, so a slow device only delays itself. A member whose queue
+-- reaches MAX_QUEUED bytes drops new data until it catches up, and the dropped bytes are counted.
+--
+-- Data received on the members is read and counted but not shown; only the session's port is
+-- displayed.
+--------------------------------------------------------------------------------------------------*/
+#include "BroadcastGroup.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: BroadcastGroup (QObject*)
+--
+-- NOTES:
+-- Constructor for an empty group that is enabled.
+--------------------------------------------------------------------------------------------------*/
+BroadcastGroup::BroadcastGroup(QObject* parent)
+	: QObject(parent)
+	, mEnabled(true)
+{
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Deconstructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: ~BroadcastGroup ()
+--
+-- NOTES:
+-- Closes every member.
+--------------------------------------------------------------------------------------------------*/
+BroadcastGroup::~BroadcastGroup()
+{
+	clear();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: addPort
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool addPort (const SerialSettings &settings)
+--
+-- RETURNS: bool - true if the port was opened and added.
+--
+-- NOTES:
+-- Opens the port named in settings with the rest of settings and adds it to the group. A port
+-- already in the group is not added twice.
+--------------------------------------------------------------------------------------------------*/
+bool BroadcastGroup::addPort(const SerialSettings &settings)
+{
+	if (portNames().contains(settings.portName))
+	{
+		mError = tr("%1 is already in the group.").arg(settings.portName);
+		return false;
+	}
+
+	QSerialPort* port = new QSerialPort(this);
+	port->setPortName(settings.portName);
+	port->setBaudRate(settings.bitRate);
+	port->setDataBits(settings.dataBits);
+	port->setParity(settings.parity);
+	port->setStopBits(settings.stopBits);
+	port->setFlowControl(settings.flowControl);
+
+	if (!port->open(QIODevice::ReadWrite))
+	{
+		mError = tr("%1: %2").arg(settings.portName, port->errorString());
+		delete port;
+		return false;
+	}
+
+	Member* member = new Member();
+	member->port = port;
+	member->offset = 0;
+	member->queued = 0;
+	member->sent = 0;
+	member->dropped = 0;
+	member->received = 0;
+	mMembers.append(member);
+
+	connect(port, &QSerialPort::bytesWritten, this, &BroadcastGroup::portWritten);
+	connect(port, &QSerialPort::readyRead, this, &BroadcastGroup::portRead);
+	connect(port, &QSerialPort::errorOccurred, this, &BroadcastGroup::portFailed);
+
+	emit membersChanged(count());
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: removePort
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void removePort (const QString &portName)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Closes the member named portName and removes it from the group. Anything still queued for it is
+-- discarded.
+--------------------------------------------------------------------------------------------------*/
+void BroadcastGroup::removePort(const QString &portName)
+{
+	for (Member* member : mMembers)
+	{
+		if (member->port->portName() == portName)
+		{
+			removeMember(member);
+			emit membersChanged(count());
+			return;
+		}
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: clear
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void clear (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Closes and removes every member.
+--------------------------------------------------------------------------------------------------*/
+void BroadcastGroup::clear()
+{
+	if (mMembers.isEmpty())
+	{
+		return;
+	}
+
+	while (!mMembers.isEmpty())
+	{
+		removeMember(mMembers.last());
+	}
+	emit membersChanged(0);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: count
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int count (void) const
+--
+-- RETURNS: int - the number of ports in the group.
+--------------------------------------------------------------------------------------------------*/
+int BroadcastGroup::count() const
+{
+	return mMembers.size();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: portNames
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QStringList portNames (void) const
+--
+-- RETURNS: QStringList - the names of the ports in the group, in the order they were added.
+--------------------------------------------------------------------------------------------------*/
+QStringList BroadcastGroup::portNames() const
+{
+	QStringList names;
+	for (const Member* member : mMembers)
+	{
+		names.append(member->port->portName());
+	}
+	return names;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: status
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: BroadcastStatus status (int index) const
+--
+-- RETURNS: BroadcastStatus - the byte counts of the member at index.
+--
+-- NOTES:
+-- queued counts bytes waiting in the group and in the port's own write buffer.
+--------------------------------------------------------------------------------------------------*/
+BroadcastStatus BroadcastGroup::status(int index) const
+{
+	const Member* member = mMembers[index];
+	BroadcastStatus status;
+	status.portName = member->port->portName();
+	status.queued = member->queued + member->port->bytesToWrite();
+	status.sent = member->sent;
+	status.dropped = member->dropped;
+	status.received = member->received;
+	return status;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: errorString
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QString errorString (void) const
+--
+-- RETURNS: QString - why the last addPort() failed.
+--------------------------------------------------------------------------------------------------*/
+QString BroadcastGroup::errorString() const
+{
+	return mError;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setEnabled
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setEnabled (bool enabled)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Turns broadcasting on or off. The members stay open while it is off, and what is already queued
+-- is still sent.
+--------------------------------------------------------------------------------------------------*/
+void BroadcastGroup::setEnabled(bool enabled)
+{
+	mEnabled = enabled;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: isEnabled
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool isEnabled (void) const
+--
+-- RETURNS: bool - true if written data is sent to the members.
+--------------------------------------------------------------------------------------------------*/
+bool BroadcastGroup::isEnabled() const
+{
+	return mEnabled;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: write
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void write (const QByteArray &data)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is connected to the same sources as the session's write: the
+-- console and scripts.
+--
+-- Queues data for every member, sharing the one buffer between them, and starts each idle member
+-- sending. A member with MAX_QUEUED bytes already waiting drops data instead.
+--------------------------------------------------------------------------------------------------*/
+void BroadcastGroup::write(const QByteArray &data)
+{
+	if (!mEnabled || data.isEmpty())
+	{
+		return;
+	}
+
+	for (Member* member : mMembers)
+	{
+		if (member->queued + data.size() > MAX_QUEUED)
+		{
+			member->dropped += data.size();
+			continue;
+		}
+
+		member->queue.enqueue(data);
+		member->queued += data.size();
+		drain(member);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: memberFor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: Member* memberFor (QObject* port) const
+--
+-- RETURNS: Member* - the member using port, or nullptr if it is not in the group.
+--------------------------------------------------------------------------------------------------*/
+BroadcastGroup::Member* BroadcastGroup::memberFor(QObject* port) const
+{
+	for (Member* member : mMembers)
+	{
+		if (member->port == port)
+		{
+			return member;
+		}
+	}
+	return nullptr;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: drain
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void drain (Member* member)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Hands the member's port as much of its queue as fits in WRITE_WINDOW, less what the port still
+-- has to write. The port copies it into its own buffer, after which the shared buffer is released.
+--------------------------------------------------------------------------------------------------*/
+void BroadcastGroup::drain(Member* member)
+{
+	qint64 room = WRITE_WINDOW - member->port->bytesToWrite();
+	while (room > 0 && !member->queue.isEmpty())
+	{
+		const QByteArray &head = member->queue.head();
+		qint64 length = qMin<qint64>(room, head.size() - member->offset);
+		qint64 written = member->port->write(head.constData() + member->offset, length);
+		if (written <= 0)
+		{
+			return;
+		}
+
+		member->offset += static_cast<int>(written);
+		member->queued -= written;
+		member->sent += written;
+		room -= written;
+
+		if (member->offset == head.size())
+		{
+			member->queue.dequeue();
+			member->offset = 0;
+		}
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: removeMember
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void removeMember (Member* member)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Closes the member's port and frees it. The port is deleted later since this may be called from
+-- one of its own signals.
+--------------------------------------------------------------------------------------------------*/
+void BroadcastGroup::removeMember(Member* member)
+{
+	mMembers.removeOne(member);
+	member->port->disconnect(this);
+	member->port->close();
+	member->port->deleteLater();
+	delete member;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: portWritten
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void portWritten (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when a member's port has written some of its
+-- buffer, making room for more of its queue.
+--------------------------------------------------------------------------------------------------*/
+void BroadcastGroup::portWritten()
+{
+	Member* member = memberFor(QObject::sender());
+	if (member)
+	{
+		drain(member);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: portRead
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void portRead (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when a member's port has data. The data is counted
+-- and discarded so the port's read buffer does not grow.
+--------------------------------------------------------------------------------------------------*/
+void BroadcastGroup::portRead()
+{
+	Member* member = memberFor(QObject::sender());
+	if (member)
+	{
+		member->received += member->port->readAll().size();
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: portFailed
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void portFailed (QSerialPort::SerialPortError error)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when a member's port reports an error. A port that
+-- has gone away, such as an unplugged USB adapter, is removed from the group; the rest carry on.
+--------------------------------------------------------------------------------------------------*/
+void BroadcastGroup::portFailed(QSerialPort::SerialPortError error)
+{
+	Member* member = memberFor(QObject::sender());
+	if (member == nullptr || error != QSerialPort::ResourceError)
+	{
+		return;
+	}
+
+	QString name = member->port->portName();
+	QString message = member->port->errorString();
+	removeMember(member);
+	emit portDropped(name, message);
+	emit membersChanged(count());
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QObject>
+#include <QQueue>
+#include <QSerialPort>
+#include <QString>
+#include <QStringList>
+
+#include "SerialSession.h"
+
+struct BroadcastStatus
+{
+	QString portName;
+	qint64 queued;
+	qint64 sent;
+	qint64 dropped;
+	qint64 received;
+};
+
+class BroadcastGroup
+	: public QObject
+{
+	Q_OBJECT
+
+public:
+	static const int WRITE_WINDOW = 4096;
+	static const int MAX_QUEUED = 256 * 1024;
+
+	explicit BroadcastGroup(QObject *parent = nullptr);
+	~BroadcastGroup();
+
+	bool addPort(const SerialSettings &settings);
+	void removePort(const QString &portName);
+	void clear();
+
+	int count() const;
+	QStringList portNames() const;
+	BroadcastStatus status(int index) const;
+	QString errorString() const;
+
+	void setEnabled(bool enabled);
+	bool isEnabled() const;
+
+public slots:
+	void write(const QByteArray &data);
+
+private:
+	struct Member
+	{
+		QSerialPort* port;
+		QQueue<QByteArray> queue;
+		int offset;
+		qint64 queued;
+		qint64 sent;
+		qint64 dropped;
+		qint64 received;
+	};
+
+	QList<Member*> mMembers;
+	QString mError;
+	bool mEnabled;
+
+	Member* memberFor(QObject* port) const;
+	void drain(Member* member);
+	void removeMember(Member* member);
+
+private slots:
+	void portWritten();
+	void portRead();
+	void portFailed(QSerialPort::SerialPortError error);
+
+signals:
+	void membersChanged(int count);
+	void portDropped(const QString &portName, const QString &message);
+};
@@ -0,0 +1,438 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: ByteStore.cpp - The most recent received bytes, kept once for every view.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- void append(const char* data, int size);
+-- void clear();
+--
+-- qint64 begin() const;
+-- qint64 end() const;
+-- int capacity() const;
+-- int read(qint64 offset, char* out, int size) const;
+--
+-- int lineCount() const;
+-- qint64 lineStart(int fromEnd) const;
+-- int lineFromEnd(qint64 offset) const;
+--
+-- int memoryUsage() const;
+--
+-- int storedLines() const;
+-- qint64 storedLine(int index) const;
+-- int firstValidLine() const;
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- A ring buffer of the last capacity received bytes. Bytes are addressed by their offset in the
+-- whole stream, so a view can hold on to a position while older bytes are dropped: begin() is the
+-- oldest offset still kept and end() is one past the newest. Views such as the hex pane read only
+-- the rows they draw, so showing the traffic costs no memory beyond the ring.
+--
+-- The store also remembers where the last LINE_INDEX_SIZE lines start, a line ending at every
+-- '\r' or '\n' just as it does in the console. That lets a position in the console be matched to
+-- a position in the bytes and back, counting lines from the newest.
+--
+-- The ring is allocated on the first append and its capacity is rounded down to a power of two,
+-- so a store never holds more than it was asked to.
+--------------------------------------------------------------------------------------------------*/
+#include <cstring>
+
+#include "ByteStore.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Rounds the capacity down instead of up, which could double it.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: ByteStore (int capacity)
+--
+-- NOTES:
+-- Constructor for an empty store holding up to capacity bytes, at least 1.
+--------------------------------------------------------------------------------------------------*/
+ByteStore::ByteStore(int capacity)
+	: mMask(1)
+	, mStart(0)
+	, mEnd(0)
+	, mLineTotal(0)
+{
+	while (mMask <= capacity / 2)
+	{
+		mMask <<= 1;
+	}
+	mMask -= 1;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: append
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void append (const char* data, int size)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Copies data into the ring, overwriting the oldest bytes once it is full, and indexes the line
+-- breaks in it. At most two memcpys are needed however the data wraps.
+--------------------------------------------------------------------------------------------------*/
+void ByteStore::append(const char* data, int size)
+{
+	if (size <= 0)
+	{
+		return;
+	}
+
+	if (mData.isEmpty())
+	{
+		mData.resize(mMask + 1);
+		mLines.resize(LINE_INDEX_SIZE);
+	}
+
+	const char* end = data + size;
+	for (const char* p = data; p < end; p++)
+	{
+		if (*p == '\n' || *p == '\r')
+		{
+			mLines[static_cast<int>(mLineTotal % LINE_INDEX_SIZE)] = mEnd + (p - data) + 1;
+			mLineTotal++;
+		}
+	}
+
+	int capacity = mMask + 1;
+	if (size > capacity)
+	{
+		mEnd += size - capacity;
+		data += size - capacity;
+		size = capacity;
+	}
+
+	int start = static_cast<int>(mEnd & mMask);
+	int first = qMin(size, capacity - start);
+	memcpy(mData.data() + start, data, first);
+	memcpy(mData.data(), data + first, size - first);
+	mEnd += size;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: clear
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Keeps the end where it was instead of moving it on by the capacity, which
+--     left begin() short of end() with stale bytes between them.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void clear (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Drops every byte. Offsets keep counting from where they were so views stay consistent.
+--------------------------------------------------------------------------------------------------*/
+void ByteStore::clear()
+{
+	mLineTotal = 0;
+	mStart = mEnd;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: begin
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Never before the end at the last clear().
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 begin (void) const
+--
+-- RETURNS: qint64 - the offset of the oldest byte kept.
+--------------------------------------------------------------------------------------------------*/
+qint64 ByteStore::begin() const
+{
+	return qMax<qint64>(mStart, mEnd - (mMask + 1));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: end
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 end (void) const
+--
+-- RETURNS: qint64 - the offset just past the newest byte, i.e. the number of bytes ever appended.
+--------------------------------------------------------------------------------------------------*/
+qint64 ByteStore::end() const
+{
+	return mEnd;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: capacity
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int capacity (void) const
+--
+-- RETURNS: int - the most bytes the store keeps.
+--------------------------------------------------------------------------------------------------*/
+int ByteStore::capacity() const
+{
+	return mMask + 1;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: read
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int read (qint64 offset, char* out, int size) const
+--
+-- RETURNS: int - the number of bytes copied to out.
+--
+-- NOTES:
+-- Copies up to size bytes starting at offset. Offsets before begin() are skipped, so the copy
+-- may start later than asked; callers that care compare offset with begin() first.
+--------------------------------------------------------------------------------------------------*/
+int ByteStore::read(qint64 offset, char* out, int size) const
+{
+	offset = qMax(offset, begin());
+	int count = static_cast<int>(qBound<qint64>(0, mEnd - offset, size));
+	if (count == 0)
+	{
+		return 0;
+	}
+
+	int start = static_cast<int>(offset & mMask);
+	int first = qMin(count, mMask + 1 - start);
+	memcpy(out, mData.constData() + start, first);
+	memcpy(out + first, mData.constData(), count - first);
+	return count;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: lineCount
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int lineCount (void) const
+--
+-- RETURNS: int - the number of lines that can be looked up, including the one in progress.
+--------------------------------------------------------------------------------------------------*/
+int ByteStore::lineCount() const
+{
+	return storedLines() - firstValidLine() + 1;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: lineStart
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 lineStart (int fromEnd) const
+--
+-- RETURNS: qint64 - the offset where the line fromEnd lines before the newest starts.
+--
+-- NOTES:
+-- Line 0 is the line in progress. Lines older than the index, or partly dropped from the ring,
+-- start at begin().
+--------------------------------------------------------------------------------------------------*/
+qint64 ByteStore::lineStart(int fromEnd) const
+{
+	int index = storedLines() - 1 - fromEnd;
+	if (fromEnd < 0 || index < firstValidLine())
+	{
+		return begin();
+	}
+	return storedLine(index);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: lineFromEnd
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int lineFromEnd (qint64 offset) const
+--
+-- RETURNS: int - how many lines before the newest the line holding offset is.
+--
+-- NOTES:
+-- The inverse of lineStart(), found by a binary search of the line index.
+--------------------------------------------------------------------------------------------------*/
+int ByteStore::lineFromEnd(qint64 offset) const
+{
+	int low = firstValidLine();
+	int high = storedLines();
+	while (low < high)
+	{
+		int middle = (low + high) / 2;
+		if (storedLine(middle) <= offset)
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+	return storedLines() - low;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: memoryUsage
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int memoryUsage (void) const
+--
+-- RETURNS: int - the bytes held by the ring and the line index.
+--------------------------------------------------------------------------------------------------*/
+int ByteStore::memoryUsage() const
+{
+	return mData.size() + mLines.size() * static_cast<int>(sizeof(qint64));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: storedLines
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int storedLines (void) const
+--
+-- RETURNS: int - the number of line starts in the index, oldest first.
+--------------------------------------------------------------------------------------------------*/
+int ByteStore::storedLines() const
+{
+	return static_cast<int>(qMin<qint64>(mLineTotal, LINE_INDEX_SIZE));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: storedLine
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 storedLine (int index) const
+--
+-- RETURNS: qint64 - the start of the index'th line in the index, oldest first.
+--------------------------------------------------------------------------------------------------*/
+qint64 ByteStore::storedLine(int index) const
+{
+	return mLines[static_cast<int>((mLineTotal - storedLines() + index) % LINE_INDEX_SIZE)];
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: firstValidLine
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int firstValidLine (void) const
+--
+-- RETURNS: int - the index of the oldest line start still inside the ring.
+--------------------------------------------------------------------------------------------------*/
+int ByteStore::firstValidLine() const
+{
+	qint64 oldest = begin();
+	int low = 0;
+	int high = storedLines();
+	while (low < high)
+	{
+		int middle = (low + high) / 2;
+		if (storedLine(middle) < oldest)
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+	return low;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QByteArray>
+#include <QVector>
+
+class ByteStore
+{
+public:
+	static const int LINE_INDEX_SIZE = 4096;
+
+	explicit ByteStore(int capacity);
+
+	void append(const char* data, int size);
+	void clear();
+
+	qint64 begin() const;
+	qint64 end() const;
+	int capacity() const;
+	int read(qint64 offset, char* out, int size) const;
+
+	int lineCount() const;
+	qint64 lineStart(int fromEnd) const;
+	int lineFromEnd(qint64 offset) const;
+
+	int memoryUsage() const;
+
+private:
+	QByteArray mData;
+	int mMask;
+	qint64 mStart;
+	qint64 mEnd;
+
+	QVector<qint64> mLines;
+	qint64 mLineTotal;
+
+	int storedLines() const;
+	qint64 storedLine(int index) const;
+	int firstValidLine() const;
+};
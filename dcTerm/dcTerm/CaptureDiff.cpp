@@ -0,0 +1,715 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: CaptureDiff.cpp - Compares the text received in two sessions line by line.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- bool setIgnorePatterns(const QStringList &patterns, QString* error);
+--
+-- void clear();
+-- bool loadCapture(Side side, const QString &path, QString* error);
+-- void loadHistory(Side side, const ByteStore &history);
+-- void append(Side side, const char* data, int size);
+--
+-- bool compare();
+--
+-- int lineCount(Side side) const;
+-- qint64 lineOffset(Side side, int line) const;
+-- QByteArray lineText(Side side, int line) const;
+--
+-- int firstDifference() const;
+-- const QVector<DiffEdit> &edits() const;
+-- bool isComplete() const;
+--
+-- QString report() const;
+--
+-- void finishLine(Text &text, int end);
+-- quint64 hashLine(const char* data, int size) const;
+-- bool myers(int prefix, int oldCount, int newCount);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- Used to check a new boot log against a known-good one. Each side is the received text of a
+-- capture file or of the session's history, split into lines. Every line is reduced to a 64 bit
+-- hash as it is loaded, after removing anything matching the ignore patterns (timestamps, counters
+-- and other fields that change from run to run), so the comparison itself never touches the text.
+--
+-- The lines the two sides start and end with in common are skipped first, which leaves little or
+-- nothing to compare for logs that mostly agree. The rest is compared with Myers' O(ND) algorithm,
+-- which takes time in proportion to the lines times the number of differences D. D is capped at
+-- MAX_DISTANCE; logs that differ more than that only report where they first diverge.
+--------------------------------------------------------------------------------------------------*/
+#include <QHash>
+
+#include <algorithm>
+#include <cstring>
+
+#include "CaptureDiff.h"
+#include "CaptureReader.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: CaptureDiff ()
+--
+-- NOTES:
+-- Constructor for a comparison of two empty sides that ignores nothing.
+--------------------------------------------------------------------------------------------------*/
+CaptureDiff::CaptureDiff()
+{
+	clear();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setIgnorePatterns
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool setIgnorePatterns (const QStringList &patterns, QString* error)
+--
+-- RETURNS: bool - false if a pattern is not a valid regular expression.
+--
+-- NOTES:
+-- Sets the regular expressions whose matches are removed from every line before it is compared.
+-- The patterns are joined into one expression so each line is searched once. Only lines loaded
+-- afterwards are affected.
+--------------------------------------------------------------------------------------------------*/
+bool CaptureDiff::setIgnorePatterns(const QStringList &patterns, QString* error)
+{
+	QStringList alternatives;
+	for (const QString &pattern : patterns)
+	{
+		if (pattern.isEmpty())
+		{
+			continue;
+		}
+
+		QRegularExpression check(pattern);
+		if (!check.isValid())
+		{
+			*error = QString("%1: %2").arg(pattern, check.errorString());
+			return false;
+		}
+		alternatives.append("(?:" + pattern + ")");
+	}
+
+	mIgnore = QRegularExpression(alternatives.join('|'));
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: clear
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void clear (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Empties both sides and forgets the last comparison. The ignore patterns are kept.
+--------------------------------------------------------------------------------------------------*/
+void CaptureDiff::clear()
+{
+	for (Text &text : mText)
+	{
+		text.data.clear();
+		text.lines.clear();
+		text.base = 0;
+		text.pending = 0;
+	}
+	mFirst = -1;
+	mEdits.clear();
+	mComplete = true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: loadCapture
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool loadCapture (Side side, const QString &path, QString* error)
+--
+-- RETURNS: bool - false if the capture file could not be read.
+--
+-- NOTES:
+-- Appends the data received in the capture file at path to side. Transmitted data and events are
+-- left out, so a log compares the same whatever was typed to produce it.
+--------------------------------------------------------------------------------------------------*/
+bool CaptureDiff::loadCapture(Side side, const QString &path, QString* error)
+{
+	CaptureReader reader;
+	if (!reader.open(path, error))
+	{
+		return false;
+	}
+
+	CaptureRecord record;
+	while (reader.next(record))
+	{
+		if (record.direction == CaptureFile::Received)
+		{
+			append(side, record.data.constData(), record.data.size());
+		}
+	}
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: loadHistory
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void loadHistory (Side side, const ByteStore &history)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Replaces side with everything still held in history. lineOffset() then gives history offsets,
+-- so a line can be found in the console and hex pane.
+--------------------------------------------------------------------------------------------------*/
+void CaptureDiff::loadHistory(Side side, const ByteStore &history)
+{
+	Text &text = mText[side];
+	text.data.clear();
+	text.lines.clear();
+	text.base = history.begin();
+	text.pending = 0;
+
+	QByteArray chunk(64 * 1024, '\0');
+	for (qint64 offset = history.begin(); offset < history.end(); )
+	{
+		int read = history.read(offset, chunk.data(), chunk.size());
+		if (read <= 0)
+		{
+			break;
+		}
+		append(side, chunk.constData(), read);
+		offset += read;
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: append
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void append (Side side, const char* data, int size)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Adds received text to side, hashing every line it completes. A line may be split across any
+-- number of calls.
+--------------------------------------------------------------------------------------------------*/
+void CaptureDiff::append(Side side, const char* data, int size)
+{
+	Text &text = mText[side];
+	int from = text.data.size();
+	text.data.append(data, size);
+
+	const char* base = text.data.constData();
+	for (const char* p = base + from; ; p++)
+	{
+		p = static_cast<const char*>(memchr(p, '\n', base + text.data.size() - p));
+		if (p == nullptr)
+		{
+			break;
+		}
+		finishLine(text, static_cast<int>(p - base));
+		text.pending = static_cast<int>(p - base) + 1;
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: compare
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool compare (void)
+--
+-- RETURNS: bool - false if the sides differ by more than MAX_DISTANCE lines.
+--
+-- NOTES:
+-- Finds the lines removed from Old and added in New. An unfinished last line on either side is
+-- counted as a line. firstDifference() is set even when the sides differ too much to list.
+--------------------------------------------------------------------------------------------------*/
+bool CaptureDiff::compare()
+{
+	for (Text &text : mText)
+	{
+		if (text.pending < text.data.size())
+		{
+			finishLine(text, text.data.size());
+			text.pending = text.data.size();
+		}
+	}
+
+	const QVector<Line> &a = mText[Old].lines;
+	const QVector<Line> &b = mText[New].lines;
+	int n = a.size();
+	int m = b.size();
+
+	int prefix = 0;
+	while (prefix < n && prefix < m && a[prefix].hash == b[prefix].hash)
+	{
+		prefix++;
+	}
+
+	int suffix = 0;
+	while (suffix < n - prefix && suffix < m - prefix && a[n - 1 - suffix].hash == b[m - 1 - suffix].hash)
+	{
+		suffix++;
+	}
+
+	mEdits.clear();
+	mFirst = prefix == n && prefix == m ? -1 : prefix;
+	mComplete = myers(prefix, n - prefix - suffix, m - prefix - suffix);
+	return mComplete;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: lineCount
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int lineCount (Side side) const
+--
+-- RETURNS: int - the number of complete lines on side.
+--------------------------------------------------------------------------------------------------*/
+int CaptureDiff::lineCount(Side side) const
+{
+	return mText[side].lines.size();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: lineOffset
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 lineOffset (Side side, int line) const
+--
+-- RETURNS: qint64 - where line starts: a history offset for a side loaded from the history, or
+--                   the count of received bytes before it for a capture.
+--------------------------------------------------------------------------------------------------*/
+qint64 CaptureDiff::lineOffset(Side side, int line) const
+{
+	const Text &text = mText[side];
+	return text.base + (line < text.lines.size() ? text.lines[line].start : text.data.size());
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: lineText
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QByteArray lineText (Side side, int line) const
+--
+-- RETURNS: QByteArray - the line as received, without its line ending.
+--------------------------------------------------------------------------------------------------*/
+QByteArray CaptureDiff::lineText(Side side, int line) const
+{
+	const Line &entry = mText[side].lines[line];
+	return mText[side].data.mid(entry.start, entry.length);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: firstDifference
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int firstDifference (void) const
+--
+-- RETURNS: int - the first line that differs, the same on both sides, or -1 if the sides match.
+--------------------------------------------------------------------------------------------------*/
+int CaptureDiff::firstDifference() const
+{
+	return mFirst;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: edits
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: const QVector<DiffEdit> &edits (void) const
+--
+-- RETURNS: const QVector<DiffEdit> & - the removed and added lines in order. A removed line's
+--                                       newLine and an added line's oldLine are where it would be
+--                                       on the other side.
+--------------------------------------------------------------------------------------------------*/
+const QVector<DiffEdit> &CaptureDiff::edits() const
+{
+	return mEdits;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: isComplete
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool isComplete (void) const
+--
+-- RETURNS: bool - false if the last comparison gave up at MAX_DISTANCE and edits() is empty.
+--------------------------------------------------------------------------------------------------*/
+bool CaptureDiff::isComplete() const
+{
+	return mComplete;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: report
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QString report (void) const
+--
+-- RETURNS: QString - the last comparison as text.
+--
+-- NOTES:
+-- Lists the changes in the style of a unified diff: removed lines start with '-', added lines
+-- with '+', and each group of changes is shown with CONTEXT_LINES unchanged lines around it under
+-- a "@@ -old +new @@" heading of 1-based line numbers. At most MAX_REPORT_EDITS changes are listed.
+-- If the comparison gave up, the lines around the first difference are shown instead.
+--------------------------------------------------------------------------------------------------*/
+QString CaptureDiff::report() const
+{
+	int oldCount = lineCount(Old);
+	int newCount = lineCount(New);
+
+	if (mFirst < 0)
+	{
+		return QString("The sides match: %1 lines.\n").arg(oldCount);
+	}
+
+	QString out;
+	if (!mComplete)
+	{
+		out += QString("The sides differ by more than %1 lines. They first differ at line %2:\n")
+			.arg(MAX_DISTANCE).arg(mFirst + 1);
+		for (int line = mFirst; line < qMin(oldCount, mFirst + CONTEXT_LINES); line++)
+		{
+			out += "-" + QString::fromLatin1(lineText(Old, line)) + "\n";
+		}
+		for (int line = mFirst; line < qMin(newCount, mFirst + CONTEXT_LINES); line++)
+		{
+			out += "+" + QString::fromLatin1(lineText(New, line)) + "\n";
+		}
+		return out;
+	}
+
+	out += QString("%1 lines removed or added, the first difference at line %2.\n").arg(mEdits.size()).arg(mFirst + 1);
+
+	int oldLine = 0;
+	int newLine = 0;
+	int edit = 0;
+	int listed = 0;
+	while (edit < mEdits.size() && listed < MAX_REPORT_EDITS)
+	{
+		const DiffEdit &start = mEdits[edit];
+		int skip = qMax(0, (start.type == DiffEdit::Removed ? start.oldLine - oldLine : start.newLine - newLine)
+			- static_cast<int>(CONTEXT_LINES));
+		oldLine += skip;
+		newLine += skip;
+		out += QString("@@ -%1 +%2 @@\n").arg(oldLine + 1).arg(newLine + 1);
+
+		int quiet = 0;
+		while (oldLine < oldCount || newLine < newCount)
+		{
+			if (edit < mEdits.size() && mEdits[edit].type == DiffEdit::Removed && mEdits[edit].oldLine == oldLine)
+			{
+				out += "-" + QString::fromLatin1(lineText(Old, oldLine++)) + "\n";
+				edit++;
+				listed++;
+				quiet = 0;
+			}
+			else if (edit < mEdits.size() && mEdits[edit].type == DiffEdit::Added && mEdits[edit].newLine == newLine)
+			{
+				out += "+" + QString::fromLatin1(lineText(New, newLine++)) + "\n";
+				edit++;
+				listed++;
+				quiet = 0;
+			}
+			else
+			{
+				int gap = oldCount + newCount;
+				if (edit < mEdits.size())
+				{
+					const DiffEdit &next = mEdits[edit];
+					gap = next.type == DiffEdit::Removed ? next.oldLine - oldLine : next.newLine - newLine;
+				}
+				if (oldLine >= oldCount || newLine >= newCount
+					|| (quiet >= CONTEXT_LINES && quiet + gap > 2 * CONTEXT_LINES))
+				{
+					break;
+				}
+				out += " " + QString::fromLatin1(lineText(New, newLine)) + "\n";
+				oldLine++;
+				newLine++;
+				quiet++;
+			}
+
+			if (listed >= MAX_REPORT_EDITS && edit < mEdits.size())
+			{
+				out += QString("... %1 more changes not shown.\n").arg(mEdits.size() - edit);
+				break;
+			}
+		}
+	}
+	return out;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: finishLine
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void finishLine (Text &text, int end)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Adds the line from text.pending up to end, less any carriage return before the line feed.
+--------------------------------------------------------------------------------------------------*/
+void CaptureDiff::finishLine(Text &text, int end)
+{
+	int length = end - text.pending;
+	if (length > 0 && text.data.at(end - 1) == '\r')
+	{
+		length--;
+	}
+
+	Line line = { text.pending, length, hashLine(text.data.constData() + text.pending, length) };
+	text.lines.append(line);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: hashLine
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: quint64 hashLine (const char* data, int size) const
+--
+-- RETURNS: quint64 - two differently seeded 32 bit hashes of the line with the ignored parts
+--                    removed, so lines are told apart by hash alone.
+--------------------------------------------------------------------------------------------------*/
+quint64 CaptureDiff::hashLine(const char* data, int size) const
+{
+	if (mIgnore.pattern().isEmpty())
+	{
+		QByteArray line = QByteArray::fromRawData(data, size);
+		return static_cast<quint64>(qHash(line, 0)) << 32 | qHash(line, 0x9e3779b9u);
+	}
+
+	QString line = QString::fromLatin1(data, size);
+	line.remove(mIgnore);
+	return static_cast<quint64>(qHash(line, 0)) << 32 | qHash(line, 0x9e3779b9u);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: myers
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool myers (int prefix, int oldCount, int newCount)
+--
+-- RETURNS: bool - false if more than MAX_DISTANCE edits are needed.
+--
+-- NOTES:
+-- Fills mEdits with the shortest list of edits turning oldCount lines of Old into newCount lines
+-- of New, both starting at line prefix.
+--
+-- v[k] is the furthest line of Old reached on diagonal k (line of Old less line of New) with d
+-- edits. Before each round the diagonals a round can read, -d - 1 to d + 1, are saved so the path
+-- can be walked back from the end once it is reached.
+--------------------------------------------------------------------------------------------------*/
+bool CaptureDiff::myers(int prefix, int oldCount, int newCount)
+{
+	const Line* a = mText[Old].lines.constData() + prefix;
+	const Line* b = mText[New].lines.constData() + prefix;
+
+	int max = qMin(oldCount + newCount, static_cast<int>(MAX_DISTANCE));
+	int offset = max + 1;
+	QVector<int> v(2 * max + 3, 0);
+	QVector<QVector<int> > trace;
+
+	int distance = -1;
+	for (int d = 0; d <= max && distance < 0; d++)
+	{
+		trace.append(v.mid(offset - d - 1, 2 * d + 3));
+
+		for (int k = -d; k <= d; k += 2)
+		{
+			int x = k == -d || (k != d && v[offset + k - 1] < v[offset + k + 1])
+				? v[offset + k + 1] : v[offset + k - 1] + 1;
+			int y = x - k;
+			while (x < oldCount && y < newCount && a[x].hash == b[y].hash)
+			{
+				x++;
+				y++;
+			}
+			v[offset + k] = x;
+
+			if (x >= oldCount && y >= newCount)
+			{
+				distance = d;
+				break;
+			}
+		}
+	}
+
+	if (distance < 0)
+	{
+		return false;
+	}
+
+	int x = oldCount;
+	int y = newCount;
+	for (int d = distance; d > 0; d--)
+	{
+		const QVector<int> &previous = trace[d];
+		int k = x - y;
+		int down = k == -d || (k != d && previous[k - 1 + d + 1] < previous[k + 1 + d + 1]);
+		int previousK = down ? k + 1 : k - 1;
+		int previousX = previous[previousK + d + 1];
+		int previousY = previousX - previousK;
+
+		while (x > previousX && y > previousY)
+		{
+			x--;
+			y--;
+		}
+
+		DiffEdit edit;
+		if (down)
+		{
+			edit.type = DiffEdit::Added;
+			edit.oldLine = prefix + x;
+			edit.newLine = prefix + y - 1;
+		}
+		else
+		{
+			edit.type = DiffEdit::Removed;
+			edit.oldLine = prefix + x - 1;
+			edit.newLine = prefix + y;
+		}
+		mEdits.append(edit);
+
+		x = previousX;
+		y = previousY;
+	}
+
+	std::reverse(mEdits.begin(), mEdits.end());
+	return true;
+}
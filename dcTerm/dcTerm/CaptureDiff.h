@@ -0,0 +1,84 @@
+#pragma once
+
+#include <QByteArray>
+#include <QRegularExpression>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "ByteStore.h"
+
+struct DiffEdit
+{
+	enum Type
+	{
+		Removed = 0,
+		Added = 1
+	};
+
+	Type type;
+	int oldLine;
+	int newLine;
+};
+
+class CaptureDiff
+{
+public:
+	enum Side
+	{
+		Old = 0,
+		New = 1
+	};
+
+	static const int MAX_DISTANCE = 2000;
+	static const int CONTEXT_LINES = 3;
+	static const int MAX_REPORT_EDITS = 5000;
+
+	CaptureDiff();
+
+	bool setIgnorePatterns(const QStringList &patterns, QString* error);
+
+	void clear();
+	bool loadCapture(Side side, const QString &path, QString* error);
+	void loadHistory(Side side, const ByteStore &history);
+	void append(Side side, const char* data, int size);
+
+	bool compare();
+
+	int lineCount(Side side) const;
+	qint64 lineOffset(Side side, int line) const;
+	QByteArray lineText(Side side, int line) const;
+
+	int firstDifference() const;
+	const QVector<DiffEdit> &edits() const;
+	bool isComplete() const;
+
+	QString report() const;
+
+private:
+	struct Line
+	{
+		int start;
+		int length;
+		quint64 hash;
+	};
+
+	struct Text
+	{
+		QByteArray data;
+		QVector<Line> lines;
+		qint64 base;
+		int pending;
+	};
+
+	Text mText[2];
+	QRegularExpression mIgnore;
+
+	int mFirst;
+	QVector<DiffEdit> mEdits;
+	bool mComplete;
+
+	void finishLine(Text &text, int end);
+	quint64 hashLine(const char* data, int size) const;
+	bool myers(int prefix, int oldCount, int newCount);
+};
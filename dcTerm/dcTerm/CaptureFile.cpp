@@ -0,0 +1,799 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: CaptureFile.cpp - Records serial traffic to disk.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- CaptureWriter:
+-- bool open(const QString &path);
+-- QString errorString() const;
+-- void writeBlock(const QByteArray &block, qint64 firstTimestamp, qint64 lastTimestamp);
+-- void finish();
+--
+-- CaptureFile:
+-- bool open(const QString &path);
+-- void close();
+--
+-- bool isOpen() const;
+-- QString fileName() const;
+-- QString errorString() const;
+--
+-- void write(Direction direction, qint64 timestamp, const char* data, int size);
+-- void write(Direction direction, qint64 timestamp, const QByteArray &data);
+-- bool append(Direction direction, qint64 timestamp, const char* data, int size);
+-- bool hasRoom(int length);
+-- void noteDropped(qint64 timestamp);
+-- void flushBlock();
+-- void recycleBlocks();
+--
+-- qint64 droppedBytes() const;
+--
+-- qint64 now();
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Records are gathered in a pooled block and written a block at a time.
+-- October 18, 2026 - Blocks are compressed and written on a background thread, with an index of
+--     the blocks at the end of the file.
+-- October 18, 2026 - Records are dropped, and the gap noted in the capture, while the blocks
+--     waiting for the writer would take the capture past its memory limit.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- A capture is a series of records of the form
+--
+--     qint64  timestamp   microseconds since the Unix epoch, little endian
+--     quint8  direction   0 = received, 1 = transmitted, 2 = event
+--     quint32 length      little endian
+--     char    data[length]
+--
+-- Each record holds the bytes of one read from or write to the port, so the original chunking and
+-- timing of the traffic is kept.
+--
+-- Records are gathered in a BLOCK_SIZE block taken from a pool and charged to the capture budget.
+-- A full block is handed to a CaptureWriter on a thread of its own, which compresses it with zlib
+-- at COMPRESSION_LEVEL and appends it to the file, so capturing costs the port's thread a memcpy
+-- per record. Each block is compressed on its own and can be read without the blocks before it.
+-- Serial traffic is mostly text and repeated framing and typically shrinks to a fifth or less.
+--
+-- Blocks waiting for the writer stay charged to the capture budget until it is done with them. If
+-- the disk cannot keep up and another block would take the capture past its limit or the session
+-- past its total limit, records are dropped rather than queued without bound: the port's thread
+-- must not wait on the disk, since the port would overrun while it did. The dropped records are
+-- counted, and once the writer catches up an event record saying how many bytes and records were
+-- lost is written before the next record, so a reader knows where the capture has a gap.
+--
+-- The file starts with the 8 byte magic "DCTCAP02", then the blocks:
+--
+--     quint32 compressed  length of the zlib data, little endian
+--     quint32 raw         length of the records once uncompressed
+--     qint64  first       timestamp of the first record in the block
+--     qint64  last        timestamp of the last record in the block
+--     char    data[compressed]
+--
+-- When the capture is closed the writer adds an index with one entry per block
+--
+--     qint64  offset      where the block starts in the file
+--     qint64  first
+--     qint64  last
+--
+-- and a trailer of the number of blocks (quint32), the offset of the index (qint64) and the magic
+-- "DCTIDX01". A reader can find any time in the capture from the index and uncompress only the
+-- block that holds it. A capture cut short has no index, and a reader rebuilds one by walking the
+-- block headers. Blocks not yet handed to the writer are lost if the program is killed while
+-- capturing.
+--
+-- Captures written before compression start with "DCTCAP01" followed directly by the records.
+-- CaptureReader still reads them.
+--------------------------------------------------------------------------------------------------*/
+#include <cstring>
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QtEndian>
+
+#include "CaptureFile.h"
+
+const char CaptureFile::MAGIC[HEADER_SIZE + 1] = "DCTCAP02";
+const char CaptureFile::RAW_MAGIC[HEADER_SIZE + 1] = "DCTCAP01";
+const char CaptureFile::INDEX_MAGIC[HEADER_SIZE + 1] = "DCTIDX01";
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: CaptureWriter (QObject*)
+--
+-- NOTES:
+-- Constructor for a writer with no file. Its file is a child so it moves thread with the writer.
+--------------------------------------------------------------------------------------------------*/
+CaptureWriter::CaptureWriter(QObject* parent)
+	: QObject(parent)
+	, mFile(this)
+{
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: open
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool open (const QString &path)
+--
+-- RETURNS: bool - true if the file was created.
+--
+-- NOTES:
+-- Creates (or truncates) the file at path and writes the magic. Called before the writer is moved
+-- to its thread, so a file that cannot be created is reported straight away.
+--------------------------------------------------------------------------------------------------*/
+bool CaptureWriter::open(const QString &path)
+{
+	mFile.setFileName(path);
+	if (!mFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered))
+	{
+		return false;
+	}
+
+	mIndex.clear();
+	mFile.write(CaptureFile::MAGIC, CaptureFile::HEADER_SIZE);
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: errorString
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QString errorString (void) const
+--
+-- RETURNS: QString - the reason the file could not be created.
+--------------------------------------------------------------------------------------------------*/
+QString CaptureWriter::errorString() const
+{
+	return mFile.errorString();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: writeBlock
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void writeBlock (const QByteArray &block, qint64 firstTimestamp, qint64 lastTimestamp)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is called on the writer's thread with each full block.
+--
+-- Compresses block and appends it to the file with its header. qCompress() puts the uncompressed
+-- length in front of the zlib data; the block header already holds it, so it is not written. The
+-- writer's copy of block is dropped on return, which is what lets CaptureFile recycle it.
+--------------------------------------------------------------------------------------------------*/
+void CaptureWriter::writeBlock(const QByteArray &block, qint64 firstTimestamp, qint64 lastTimestamp)
+{
+	QByteArray compressed = qCompress(block, COMPRESSION_LEVEL);
+	const int prefix = 4;
+
+	uchar header[CaptureFile::BLOCK_HEADER_SIZE];
+	qToLittleEndian<quint32>(static_cast<quint32>(compressed.size() - prefix), header);
+	qToLittleEndian<quint32>(static_cast<quint32>(block.size()), header + 4);
+	qToLittleEndian<qint64>(firstTimestamp, header + 8);
+	qToLittleEndian<qint64>(lastTimestamp, header + 16);
+
+	CaptureBlock entry = { mFile.pos(), firstTimestamp, lastTimestamp };
+	mIndex.append(entry);
+
+	mFile.write(reinterpret_cast<const char*>(header), CaptureFile::BLOCK_HEADER_SIZE);
+	mFile.write(compressed.constData() + prefix, compressed.size() - prefix);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: finish
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void finish (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is called on the writer's thread after the last block.
+--
+-- Writes the block index and trailer and closes the file.
+--------------------------------------------------------------------------------------------------*/
+void CaptureWriter::finish()
+{
+	if (!mFile.isOpen())
+	{
+		return;
+	}
+
+	qint64 indexOffset = mFile.pos();
+	QByteArray index(mIndex.size() * CaptureFile::INDEX_ENTRY_SIZE + CaptureFile::TRAILER_SIZE, 0);
+	uchar* out = reinterpret_cast<uchar*>(index.data());
+	for (const CaptureBlock &entry : mIndex)
+	{
+		qToLittleEndian<qint64>(entry.offset, out);
+		qToLittleEndian<qint64>(entry.firstTimestamp, out + 8);
+		qToLittleEndian<qint64>(entry.lastTimestamp, out + 16);
+		out += CaptureFile::INDEX_ENTRY_SIZE;
+	}
+	qToLittleEndian<quint32>(static_cast<quint32>(mIndex.size()), out);
+	qToLittleEndian<qint64>(indexOffset, out + 4);
+	memcpy(out + 12, CaptureFile::INDEX_MAGIC, CaptureFile::HEADER_SIZE);
+
+	mFile.write(index);
+	mFile.close();
+	mIndex.clear();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Takes the memory budget for its block pool.
+-- October 18, 2026 - Keeps a few blocks free for while others are being compressed.
+-- October 18, 2026 - Keeps the budget to check before queueing more blocks.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: CaptureFile (MemoryBudget*)
+--
+-- NOTES:
+-- Constructor for a closed capture file. Its blocks are charged to budget if one is given.
+--------------------------------------------------------------------------------------------------*/
+CaptureFile::CaptureFile(MemoryBudget* budget)
+	: mThread(nullptr)
+	, mWriter(nullptr)
+	, mBudget(budget)
+	, mPool(BLOCK_SIZE, MAX_FREE_BLOCKS, budget, MemoryBudget::Capture)
+	, mFirstTimestamp(0)
+	, mLastTimestamp(0)
+	, mDroppedBytes(0)
+	, mDroppedRecords(0)
+	, mDroppedTotal(0)
+{
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Deconstructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: ~CaptureFile ()
+--
+-- NOTES:
+-- Flushes and closes the file if it is still open.
+--------------------------------------------------------------------------------------------------*/
+CaptureFile::~CaptureFile()
+{
+	close();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: open
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Opens the file unbuffered and takes a block from the pool.
+-- October 18, 2026 - Starts a writer thread for the file.
+-- October 18, 2026 - Starts the count of dropped bytes over.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool open (const QString &path)
+--
+-- RETURNS: bool - true if the file was created.
+--
+-- NOTES:
+-- Creates (or truncates) the file at path and starts its writer thread. Any capture already open
+-- is closed first.
+--------------------------------------------------------------------------------------------------*/
+bool CaptureFile::open(const QString &path)
+{
+	close();
+
+	CaptureWriter* writer = new CaptureWriter();
+	if (!writer->open(path))
+	{
+		mError = writer->errorString();
+		delete writer;
+		return false;
+	}
+
+	mFileName = path;
+	mWriter = writer;
+	mDroppedBytes = 0;
+	mDroppedRecords = 0;
+	mDroppedTotal = 0;
+	mThread = new QThread();
+	mWriter->moveToThread(mThread);
+	mThread->start();
+
+	mBlock = mPool.acquire();
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: close
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Writes out the last block.
+-- October 18, 2026 - Waits for the writer to finish the file and stops its thread.
+-- October 18, 2026 - Notes records still waiting to be reported as dropped.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void close (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Hands over the last block and waits for the writer to write every block, the index and the
+-- trailer, so the file is complete when close() returns. The blocks go back to the pool. A gap
+-- not yet noted is noted in a block of its own, since the writer is about to catch up anyway.
+--------------------------------------------------------------------------------------------------*/
+void CaptureFile::close()
+{
+	if (!mWriter)
+	{
+		return;
+	}
+
+	if (mDroppedRecords > 0)
+	{
+		flushBlock();
+		noteDropped(now());
+	}
+	flushBlock();
+	mPool.release(mBlock);
+	QMetaObject::invokeMethod(mWriter, "finish", Qt::BlockingQueuedConnection);
+
+	mThread->quit();
+	mThread->wait();
+	delete mWriter;
+	delete mThread;
+	mWriter = nullptr;
+	mThread = nullptr;
+	recycleBlocks();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: isOpen
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool isOpen (void) const
+--
+-- RETURNS: bool - true if records are being written.
+--------------------------------------------------------------------------------------------------*/
+bool CaptureFile::isOpen() const
+{
+	return mWriter != nullptr;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: fileName
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QString fileName (void) const
+--
+-- RETURNS: QString - the path of the capture file.
+--------------------------------------------------------------------------------------------------*/
+QString CaptureFile::fileName() const
+{
+	return mFileName;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: errorString
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QString errorString (void) const
+--
+-- RETURNS: QString - the reason the last capture could not be created.
+--------------------------------------------------------------------------------------------------*/
+QString CaptureFile::errorString() const
+{
+	return mError;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: write
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Gathers records in the block.
+-- October 18, 2026 - Notes the block's first and last timestamps for the index.
+-- October 18, 2026 - Drops the record if there is no room for it in the budget. Once dropping,
+--     keeps dropping until there is room for a new block, which starts with a note of the gap.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void write (Direction direction, qint64 timestamp, const char* data, int size)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Appends one record. Does nothing if the capture is not open. A record costs a memcpy into the
+-- block in the common case; one too big for a block is handed to the writer as a block of its own.
+--------------------------------------------------------------------------------------------------*/
+void CaptureFile::write(Direction direction, qint64 timestamp, const char* data, int size)
+{
+	if (!mWriter)
+	{
+		return;
+	}
+
+	if (mDroppedRecords > 0)
+	{
+		if (!hasRoom(BLOCK_SIZE))
+		{
+			mDroppedBytes += size;
+			mDroppedRecords++;
+			mDroppedTotal += size;
+			return;
+		}
+		flushBlock();
+		noteDropped(timestamp);
+	}
+
+	if (!append(direction, timestamp, data, size))
+	{
+		mDroppedBytes += size;
+		mDroppedRecords++;
+		mDroppedTotal += size;
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: write
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void write (Direction direction, qint64 timestamp, const QByteArray &data)
+--
+-- RETURNS: void.
+--------------------------------------------------------------------------------------------------*/
+void CaptureFile::write(Direction direction, qint64 timestamp, const QByteArray &data)
+{
+	write(direction, timestamp, data.constData(), data.size());
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: append
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool append (Direction direction, qint64 timestamp, const char* data, int size)
+--
+-- RETURNS: bool - true if the record was added, false if there was no room for it.
+--
+-- NOTES:
+-- Adds the record to the block, first handing a full block to the writer if there is room for
+-- another. A record too big for a block is charged to the budget by its size until the writer is
+-- done with it.
+--------------------------------------------------------------------------------------------------*/
+bool CaptureFile::append(Direction direction, qint64 timestamp, const char* data, int size)
+{
+	const int length = RECORD_HEADER_SIZE + size;
+	if (mBlock.size() + length > BLOCK_SIZE)
+	{
+		if (!hasRoom(length))
+		{
+			return false;
+		}
+		flushBlock();
+	}
+
+	uchar header[RECORD_HEADER_SIZE];
+	qToLittleEndian<qint64>(timestamp, header);
+	header[8] = static_cast<uchar>(direction);
+	qToLittleEndian<quint32>(static_cast<quint32>(size), header + 9);
+
+	if (length > BLOCK_SIZE)
+	{
+		QByteArray record;
+		record.reserve(length);
+		record.append(reinterpret_cast<const char*>(header), RECORD_HEADER_SIZE);
+		record.append(data, size);
+		if (mBudget)
+		{
+			mBudget->charge(MemoryBudget::Capture, length);
+		}
+		QMetaObject::invokeMethod(mWriter, "writeBlock", Qt::QueuedConnection, Q_ARG(QByteArray, record),
+			Q_ARG(qint64, timestamp), Q_ARG(qint64, timestamp));
+		mWriting.append(record);
+		return true;
+	}
+
+	if (mBlock.isEmpty())
+	{
+		mFirstTimestamp = timestamp;
+	}
+	mLastTimestamp = timestamp;
+	mBlock.append(reinterpret_cast<const char*>(header), RECORD_HEADER_SIZE);
+	mBlock.append(data, size);
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: hasRoom
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool hasRoom (int length)
+--
+-- RETURNS: bool - true if a record of length bytes can be queued without going over the budget.
+--
+-- NOTES:
+-- Called when the block is full. Takes back whatever the writer has finished with first. A block
+-- waiting in the pool is already charged, so reusing one costs nothing; otherwise the new block,
+-- and the record itself if it is bigger than a block, must fit within the limits.
+--------------------------------------------------------------------------------------------------*/
+bool CaptureFile::hasRoom(int length)
+{
+	recycleBlocks();
+	if (!mBudget)
+	{
+		return true;
+	}
+
+	qint64 needed = mPool.freeBlocks() > 0 ? 0 : BLOCK_SIZE;
+	if (length > BLOCK_SIZE)
+	{
+		needed += length;
+	}
+	return needed == 0 || !mBudget->wouldExceed(MemoryBudget::Capture, needed);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: noteDropped
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void noteDropped (qint64 timestamp)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Writes an event record saying how much was dropped since the last one, at timestamp. Called
+-- with a fresh block, which always has room for it.
+--------------------------------------------------------------------------------------------------*/
+void CaptureFile::noteDropped(qint64 timestamp)
+{
+	QByteArray note = DROPPED_TEXT.arg(mDroppedBytes).arg(mDroppedRecords).toLatin1();
+	append(Event, timestamp, note.constData(), note.size());
+	mDroppedBytes = 0;
+	mDroppedRecords = 0;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: flushBlock
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Hands the block to the writer and carries on with a fresh one.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void flushBlock (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Queues the gathered records to the writer thread and takes another block from the pool. The
+-- block is shared with the queued call rather than copied and is kept until the writer is done
+-- with it.
+--------------------------------------------------------------------------------------------------*/
+void CaptureFile::flushBlock()
+{
+	if (mBlock.isEmpty())
+	{
+		return;
+	}
+
+	QMetaObject::invokeMethod(mWriter, "writeBlock", Qt::QueuedConnection, Q_ARG(QByteArray, mBlock),
+		Q_ARG(qint64, mFirstTimestamp), Q_ARG(qint64, mLastTimestamp));
+	mWriting.append(mBlock);
+	recycleBlocks();
+	mBlock = mPool.acquire();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: recycleBlocks
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Frees records that were too big for a block.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void recycleBlocks (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Returns the blocks the writer has finished with to the pool. A block the writer has dropped is
+-- no longer shared, which QByteArray's atomic reference count tells without a lock. A record that
+-- was too big for a block is freed and its charge released instead.
+--------------------------------------------------------------------------------------------------*/
+void CaptureFile::recycleBlocks()
+{
+	for (int i = mWriting.size() - 1; i >= 0; i--)
+	{
+		if (mWriting[i].isDetached())
+		{
+			if (mWriting[i].size() > BLOCK_SIZE)
+			{
+				if (mBudget)
+				{
+					mBudget->release(MemoryBudget::Capture, mWriting[i].size());
+				}
+			}
+			else
+			{
+				mPool.release(mWriting[i]);
+			}
+			mWriting.remove(i);
+		}
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: droppedBytes
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 droppedBytes (void) const
+--
+-- RETURNS: qint64 - the bytes left out of the capture since it was opened because the writer could
+--          not keep up.
+--------------------------------------------------------------------------------------------------*/
+qint64 CaptureFile::droppedBytes() const
+{
+	return mDroppedTotal;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: now
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 now (void)
+--
+-- RETURNS: qint64 - the current time in microseconds since the Unix epoch.
+--
+-- NOTES:
+-- The wall clock is read once and a monotonic timer is added to it afterwards. This gives
+-- microsecond resolution, which QDateTime cannot, and keeps timestamps in order even if the
+-- system clock is adjusted during a capture.
+--------------------------------------------------------------------------------------------------*/
+qint64 CaptureFile::now()
+{
+	static const qint64 epoch = QDateTime::currentMSecsSinceEpoch() * 1000;
+	static const QElapsedTimer timer = []()
+	{
+		QElapsedTimer t;
+		t.start();
+		return t;
+	}();
+	return epoch + timer.nsecsElapsed() / 1000;
+}
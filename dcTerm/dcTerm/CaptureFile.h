@@ -0,0 +1,105 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QObject>
+#include <QString>
+#include <QThread>
+#include <QVector>
+
+#include "BlockPool.h"
+#include "MemoryBudget.h"
+
+struct CaptureBlock
+{
+	qint64 offset;
+	qint64 firstTimestamp;
+	qint64 lastTimestamp;
+};
+
+class CaptureWriter
+	: public QObject
+{
+	Q_OBJECT
+
+public:
+	static const int COMPRESSION_LEVEL = 1;
+
+	explicit CaptureWriter(QObject *parent = nullptr);
+
+	bool open(const QString &path);
+	QString errorString() const;
+
+public slots:
+	void writeBlock(const QByteArray &block, qint64 firstTimestamp, qint64 lastTimestamp);
+	void finish();
+
+private:
+	QFile mFile;
+	QVector<CaptureBlock> mIndex;
+};
+
+class CaptureFile
+{
+public:
+	enum Direction
+	{
+		Received = 0,
+		Transmitted = 1,
+		Event = 2
+	};
+
+	static const int HEADER_SIZE = 8;
+	static const int RECORD_HEADER_SIZE = 13;
+	static const int BLOCK_HEADER_SIZE = 24;
+	static const int INDEX_ENTRY_SIZE = 24;
+	static const int TRAILER_SIZE = 20;
+	static const int BLOCK_SIZE = 64 * 1024;
+	static const int MAX_FREE_BLOCKS = 4;
+
+	static const char MAGIC[HEADER_SIZE + 1];
+	static const char RAW_MAGIC[HEADER_SIZE + 1];
+	static const char INDEX_MAGIC[HEADER_SIZE + 1];
+
+	explicit CaptureFile(MemoryBudget* budget = nullptr);
+	~CaptureFile();
+
+	bool open(const QString &path);
+	void close();
+
+	bool isOpen() const;
+	QString fileName() const;
+	QString errorString() const;
+
+	void write(Direction direction, qint64 timestamp, const char* data, int size);
+	void write(Direction direction, qint64 timestamp, const QByteArray &data);
+
+	qint64 droppedBytes() const;
+
+	static qint64 now();
+
+private:
+	const QString DROPPED_TEXT = "Capture fell behind: %1 bytes in %2 records were not recorded.";
+
+	QThread* mThread;
+	CaptureWriter* mWriter;
+	QString mFileName;
+	QString mError;
+
+	MemoryBudget* mBudget;
+	BlockPool mPool;
+	QByteArray mBlock;
+	qint64 mFirstTimestamp;
+	qint64 mLastTimestamp;
+	QVector<QByteArray> mWriting;
+
+	qint64 mDroppedBytes;
+	qint64 mDroppedRecords;
+	qint64 mDroppedTotal;
+
+	bool append(Direction direction, qint64 timestamp, const char* data, int size);
+	bool hasRoom(int length);
+	void noteDropped(qint64 timestamp);
+	void flushBlock();
+	void recycleBlocks();
+};
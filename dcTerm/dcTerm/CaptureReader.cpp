@@ -0,0 +1,614 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: CaptureReader.cpp - Reads the records of a capture file one at a time.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- bool open(const QString &path, QString* error);
+-- void close();
+--
+-- bool next(CaptureRecord &record);
+-- bool seek(qint64 timestamp);
+--
+-- qint64 size() const;
+-- qint64 position() const;
+-- qint64 startTime() const;
+-- bool isCompressed() const;
+-- bool isTruncated() const;
+--
+-- bool readIndex();
+-- void rebuildIndex();
+-- bool loadBlock(int block);
+-- bool nextRaw(CaptureRecord &record);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Reads compressed captures a block at a time and seeks by time.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- The reading side of CaptureFile. Records are read from the file as they are asked for, each into
+-- the caller's record, so a caller that reuses one record reads a capture of any size in the
+-- memory of its largest record.
+--
+-- A compressed capture is read one block at a time: the block is uncompressed into a buffer that
+-- is reused for the next block, and records are copied out of it. Its block index, read from the
+-- end of the file or rebuilt if the capture was never closed, lets seek() go to a time by
+-- uncompressing only the block that holds it. Captures written before compression are read
+-- straight from the file and seek() walks their records from the start.
+--
+-- A capture cut short, e.g. by the program being killed while capturing, ends at its last whole
+-- record and isTruncated() tells the caller the rest was lost.
+--------------------------------------------------------------------------------------------------*/
+#include <cstring>
+
+#include <QtEndian>
+
+#include "CaptureReader.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: CaptureReader ()
+--
+-- NOTES:
+-- Constructor for a closed reader.
+--------------------------------------------------------------------------------------------------*/
+CaptureReader::CaptureReader()
+	: mTruncated(false)
+	, mCompressed(false)
+	, mStartTime(0)
+	, mNextBlock(0)
+	, mBlockPosition(0)
+{
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: open
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool open (const QString &path, QString* error)
+--
+-- RETURNS: bool - true if path is a capture file and is ready to be read.
+--
+-- NOTES:
+-- Opens the capture at path, checks its magic and, for a compressed capture, loads its block
+-- index. On failure error is set to the reason.
+--------------------------------------------------------------------------------------------------*/
+bool CaptureReader::open(const QString &path, QString* error)
+{
+	close();
+
+	mFile.setFileName(path);
+	if (!mFile.open(QIODevice::ReadOnly))
+	{
+		*error = mFile.errorString();
+		return false;
+	}
+
+	QByteArray magic = mFile.read(CaptureFile::HEADER_SIZE);
+	mCompressed = magic == QByteArray(CaptureFile::MAGIC);
+	if (!mCompressed && magic != QByteArray(CaptureFile::RAW_MAGIC))
+	{
+		mFile.close();
+		*error = QString("%1 is not a dcTerm capture.").arg(path);
+		return false;
+	}
+
+	mTruncated = false;
+	mStartTime = 0;
+	mIndex.clear();
+	mNextBlock = 0;
+	mBlock.clear();
+	mBlockPosition = 0;
+
+	if (mCompressed)
+	{
+		if (!readIndex())
+		{
+			rebuildIndex();
+		}
+		if (!mIndex.isEmpty())
+		{
+			mStartTime = mIndex.first().firstTimestamp;
+		}
+		mFile.seek(CaptureFile::HEADER_SIZE);
+	}
+	else if (mFile.size() >= CaptureFile::HEADER_SIZE + 8)
+	{
+		uchar timestamp[8];
+		mFile.peek(reinterpret_cast<char*>(timestamp), 8);
+		mStartTime = qFromLittleEndian<qint64>(timestamp);
+	}
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: close
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void close (void)
+--
+-- RETURNS: void.
+--------------------------------------------------------------------------------------------------*/
+void CaptureReader::close()
+{
+	mFile.close();
+	mIndex.clear();
+	mBlock.clear();
+	mCompressedData.clear();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: next
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Takes records from the current block of a compressed capture.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool next (CaptureRecord &record)
+--
+-- RETURNS: bool - true if a record was read, false at the end of the capture.
+--
+-- NOTES:
+-- Reads the next record into record. The record's data is resized rather than replaced, so
+-- reading into the same record again reuses its buffer.
+--------------------------------------------------------------------------------------------------*/
+bool CaptureReader::next(CaptureRecord &record)
+{
+	if (!mFile.isOpen())
+	{
+		return false;
+	}
+	if (!mCompressed)
+	{
+		return nextRaw(record);
+	}
+
+	while (mBlockPosition >= mBlock.size())
+	{
+		if (!loadBlock(mNextBlock))
+		{
+			return false;
+		}
+	}
+
+	const uchar* header = reinterpret_cast<const uchar*>(mBlock.constData()) + mBlockPosition;
+	int left = mBlock.size() - mBlockPosition - CaptureFile::RECORD_HEADER_SIZE;
+	quint32 length = left < 0 ? 0 : qFromLittleEndian<quint32>(header + 9);
+	if (left < 0 || length > static_cast<quint32>(left))
+	{
+		mTruncated = true;
+		mBlockPosition = mBlock.size();
+		mNextBlock = mIndex.size();
+		return false;
+	}
+
+	record.timestamp = qFromLittleEndian<qint64>(header);
+	record.direction = static_cast<CaptureFile::Direction>(header[8]);
+	record.data.resize(static_cast<int>(length));
+	memcpy(record.data.data(), header + CaptureFile::RECORD_HEADER_SIZE, length);
+	mBlockPosition += CaptureFile::RECORD_HEADER_SIZE + static_cast<int>(length);
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: seek
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool seek (qint64 timestamp)
+--
+-- RETURNS: bool - true if there is a record at or after timestamp.
+--
+-- NOTES:
+-- Moves to the first record at or after timestamp, so the next call to next() returns it. In a
+-- compressed capture the index is searched for the first block that ends at or after timestamp
+-- and only that block is uncompressed.
+--------------------------------------------------------------------------------------------------*/
+bool CaptureReader::seek(qint64 timestamp)
+{
+	if (!mFile.isOpen())
+	{
+		return false;
+	}
+
+	if (!mCompressed)
+	{
+		mFile.seek(CaptureFile::HEADER_SIZE);
+		uchar header[CaptureFile::RECORD_HEADER_SIZE];
+		while (mFile.peek(reinterpret_cast<char*>(header), CaptureFile::RECORD_HEADER_SIZE)
+			== CaptureFile::RECORD_HEADER_SIZE)
+		{
+			if (qFromLittleEndian<qint64>(header) >= timestamp)
+			{
+				return true;
+			}
+			mFile.seek(mFile.pos() + CaptureFile::RECORD_HEADER_SIZE + qFromLittleEndian<quint32>(header + 9));
+		}
+		return false;
+	}
+
+	int low = 0;
+	int high = mIndex.size();
+	while (low < high)
+	{
+		int middle = (low + high) / 2;
+		if (mIndex[middle].lastTimestamp < timestamp)
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+
+	mBlock.clear();
+	mBlockPosition = 0;
+	mNextBlock = low;
+	if (!loadBlock(low))
+	{
+		return false;
+	}
+
+	while (mBlockPosition + CaptureFile::RECORD_HEADER_SIZE <= mBlock.size())
+	{
+		const uchar* header = reinterpret_cast<const uchar*>(mBlock.constData()) + mBlockPosition;
+		if (qFromLittleEndian<qint64>(header) >= timestamp)
+		{
+			return true;
+		}
+		mBlockPosition += CaptureFile::RECORD_HEADER_SIZE + static_cast<int>(qFromLittleEndian<quint32>(header + 9));
+	}
+	return false;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: nextRaw
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool nextRaw (CaptureRecord &record)
+--
+-- RETURNS: bool - true if a record was read, false at the end of the capture.
+--
+-- NOTES:
+-- Reads the next record of an uncompressed capture straight from the file.
+--------------------------------------------------------------------------------------------------*/
+bool CaptureReader::nextRaw(CaptureRecord &record)
+{
+	uchar header[CaptureFile::RECORD_HEADER_SIZE];
+	qint64 got = mFile.read(reinterpret_cast<char*>(header), CaptureFile::RECORD_HEADER_SIZE);
+	if (got < CaptureFile::RECORD_HEADER_SIZE)
+	{
+		mTruncated = got > 0;
+		return false;
+	}
+
+	quint32 length = qFromLittleEndian<quint32>(header + 9);
+	if (length > static_cast<quint64>(mFile.size() - mFile.pos()))
+	{
+		mTruncated = true;
+		return false;
+	}
+
+	record.timestamp = qFromLittleEndian<qint64>(header);
+	record.direction = static_cast<CaptureFile::Direction>(header[8]);
+	record.data.resize(static_cast<int>(length));
+	if (mFile.read(record.data.data(), length) != length)
+	{
+		mTruncated = true;
+		return false;
+	}
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: size
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 size (void) const
+--
+-- RETURNS: qint64 - the size of the capture file in bytes.
+--------------------------------------------------------------------------------------------------*/
+qint64 CaptureReader::size() const
+{
+	return mFile.size();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: position
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 position (void) const
+--
+-- RETURNS: qint64 - how far into the file has been read, for showing progress.
+--------------------------------------------------------------------------------------------------*/
+qint64 CaptureReader::position() const
+{
+	return mFile.pos();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: isTruncated
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool isTruncated (void) const
+--
+-- RETURNS: bool - true if the capture ended part way through a record.
+--------------------------------------------------------------------------------------------------*/
+bool CaptureReader::isTruncated() const
+{
+	return mTruncated;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: startTime
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 startTime (void) const
+--
+-- RETURNS: qint64 - the timestamp of the first record, or 0 if the capture is empty.
+--------------------------------------------------------------------------------------------------*/
+qint64 CaptureReader::startTime() const
+{
+	return mStartTime;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: isCompressed
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool isCompressed (void) const
+--
+-- RETURNS: bool - true if the capture is written in compressed blocks.
+--------------------------------------------------------------------------------------------------*/
+bool CaptureReader::isCompressed() const
+{
+	return mCompressed;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: readIndex
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool readIndex (void)
+--
+-- RETURNS: bool - true if the capture ends with a block index and it was read.
+--
+-- NOTES:
+-- Reads the trailer at the end of the file and the index it points to. The index must end right
+-- where the trailer starts, which rules out a capture cut short that happens to end in bytes that
+-- look like a trailer.
+--------------------------------------------------------------------------------------------------*/
+bool CaptureReader::readIndex()
+{
+	qint64 size = mFile.size();
+	if (size < CaptureFile::HEADER_SIZE + CaptureFile::TRAILER_SIZE)
+	{
+		return false;
+	}
+
+	uchar trailer[CaptureFile::TRAILER_SIZE];
+	mFile.seek(size - CaptureFile::TRAILER_SIZE);
+	if (mFile.read(reinterpret_cast<char*>(trailer), CaptureFile::TRAILER_SIZE) != CaptureFile::TRAILER_SIZE
+		|| memcmp(trailer + 12, CaptureFile::INDEX_MAGIC, CaptureFile::HEADER_SIZE) != 0)
+	{
+		return false;
+	}
+
+	quint32 count = qFromLittleEndian<quint32>(trailer);
+	qint64 offset = qFromLittleEndian<qint64>(trailer + 4);
+	if (offset < CaptureFile::HEADER_SIZE
+		|| offset + static_cast<qint64>(count) * CaptureFile::INDEX_ENTRY_SIZE != size - CaptureFile::TRAILER_SIZE)
+	{
+		return false;
+	}
+
+	mFile.seek(offset);
+	QByteArray index = mFile.read(static_cast<qint64>(count) * CaptureFile::INDEX_ENTRY_SIZE);
+	const uchar* entry = reinterpret_cast<const uchar*>(index.constData());
+	mIndex.resize(static_cast<int>(count));
+	for (CaptureBlock &block : mIndex)
+	{
+		block.offset = qFromLittleEndian<qint64>(entry);
+		block.firstTimestamp = qFromLittleEndian<qint64>(entry + 8);
+		block.lastTimestamp = qFromLittleEndian<qint64>(entry + 16);
+		entry += CaptureFile::INDEX_ENTRY_SIZE;
+	}
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: rebuildIndex
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void rebuildIndex (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Builds the index of a capture that was never closed by walking its block headers, reading only
+-- the headers and skipping over the data. A last block that was not fully written is left out and
+-- the capture is marked truncated.
+--------------------------------------------------------------------------------------------------*/
+void CaptureReader::rebuildIndex()
+{
+	qint64 size = mFile.size();
+	qint64 offset = CaptureFile::HEADER_SIZE;
+	uchar header[CaptureFile::BLOCK_HEADER_SIZE];
+
+	mIndex.clear();
+	while (offset < size)
+	{
+		mFile.seek(offset);
+		if (mFile.read(reinterpret_cast<char*>(header), CaptureFile::BLOCK_HEADER_SIZE) != CaptureFile::BLOCK_HEADER_SIZE)
+		{
+			mTruncated = true;
+			return;
+		}
+
+		qint64 end = offset + CaptureFile::BLOCK_HEADER_SIZE + qFromLittleEndian<quint32>(header);
+		if (end > size)
+		{
+			mTruncated = true;
+			return;
+		}
+
+		CaptureBlock block = { offset, qFromLittleEndian<qint64>(header + 8), qFromLittleEndian<qint64>(header + 16) };
+		mIndex.append(block);
+		offset = end;
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: loadBlock
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool loadBlock (int block)
+--
+-- RETURNS: bool - true if the block was read and uncompressed.
+--
+-- NOTES:
+-- Reads block from the file and uncompresses it, ready for next() to take its records from the
+-- start. The length qUncompress() expects in front of the zlib data is put back from the block
+-- header, into a buffer kept for the next block. A block that does not uncompress to the length
+-- in its header ends the capture as truncated.
+--------------------------------------------------------------------------------------------------*/
+bool CaptureReader::loadBlock(int block)
+{
+	if (block >= mIndex.size())
+	{
+		return false;
+	}
+
+	uchar header[CaptureFile::BLOCK_HEADER_SIZE];
+	mFile.seek(mIndex[block].offset);
+	if (mFile.read(reinterpret_cast<char*>(header), CaptureFile::BLOCK_HEADER_SIZE) != CaptureFile::BLOCK_HEADER_SIZE)
+	{
+		mTruncated = true;
+		return false;
+	}
+
+	quint32 compressed = qFromLittleEndian<quint32>(header);
+	quint32 raw = qFromLittleEndian<quint32>(header + 4);
+	mCompressedData.resize(4 + static_cast<int>(compressed));
+	qToBigEndian<quint32>(raw, reinterpret_cast<uchar*>(mCompressedData.data()));
+	if (mFile.read(mCompressedData.data() + 4, compressed) != compressed)
+	{
+		mTruncated = true;
+		return false;
+	}
+
+	mBlock = qUncompress(mCompressedData);
+	if (mBlock.size() != static_cast<int>(raw))
+	{
+		mTruncated = true;
+		mBlock.clear();
+		return false;
+	}
+
+	mBlockPosition = 0;
+	mNextBlock = block + 1;
+	return true;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QVector>
+
+#include "CaptureFile.h"
+
+struct CaptureRecord
+{
+	qint64 timestamp;
+	CaptureFile::Direction direction;
+	QByteArray data;
+};
+
+class CaptureReader
+{
+public:
+	CaptureReader();
+
+	bool open(const QString &path, QString* error);
+	void close();
+
+	bool next(CaptureRecord &record);
+	bool seek(qint64 timestamp);
+
+	qint64 size() const;
+	qint64 position() const;
+	qint64 startTime() const;
+	bool isCompressed() const;
+	bool isTruncated() const;
+
+private:
+	QFile mFile;
+	bool mTruncated;
+	bool mCompressed;
+	qint64 mStartTime;
+
+	QVector<CaptureBlock> mIndex;
+	int mNextBlock;
+	QByteArray mBlock;
+	int mBlockPosition;
+	QByteArray mCompressedData;
+
+	bool readIndex();
+	void rebuildIndex();
+	bool loadBlock(int block);
+	bool nextRaw(CaptureRecord &record);
+};
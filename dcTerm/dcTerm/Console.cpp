@@ -5,14 +5,38 @@
 --
 -- FUNCTIONS:
 -- void displayData(const QByteArray &data);
+-- void DisplayFrame(const char* data, int length, FrameDecoder::FrameStatus status, const QTime &time);
+-- void DisplayTransmitted(const QByteArray &data);
+-- void DisplayTransmittedFrame(const char* data, int length, const QTime &time);
+-- void HighlightLastLine(const QColor &color);
+-- void SetHighlightRules(const HighlightRules &rules);
+-- void SetMemoryBudget(MemoryBudget* budget);
+-- int TopLineFromEnd() const;
+-- void ScrollToLineFromEnd(int lines);
+-- void SetShowControlCharacters(bool show);
+-- void InsertData(const QByteArray &data, ControlGlyphs &glyphs);
+-- void SetDirection(bool transmitting);
+-- void TrimScrollback();
 --
 -- void keyPressEvent(QKeyEvent* e);
+-- void insertFromMimeData(const QMimeData* source);
 -- 
--- void emitKeyPressed(QByteArray &data);
+-- void emitKeyPressed(const QByteArray &data);
 --
 -- DATE: September 29, 2017
 --
--- REVISIONS: N/A
+-- REVISIONS:
+-- October 18, 2026 - Added DisplayFrame for showing decoded protocol frames one per row.
+-- October 18, 2026 - Added HighlightLastLine for trigger rules.
+-- October 18, 2026 - Moved the frame row text into FrameFormat and made emitKeyPressed take a const
+--     reference so it builds with compilers other than MSVC.
+-- October 18, 2026 - Added SetHighlightRules for styling received lines.
+-- October 18, 2026 - The scrollback is charged to a memory budget and trimmed to its limit.
+-- October 18, 2026 - Added TopLineFromEnd and ScrollToLineFromEnd for keeping the hex pane in step.
+-- October 18, 2026 - Added DisplayTransmitted and DisplayTransmittedFrame for local echo.
+-- October 18, 2026 - Added SetShowControlCharacters for showing control characters and invalid
+--     bytes as glyphs.
+-- October 18, 2026 - Pasted text is sent like typed text instead of being inserted locally.
 --
 -- DESIGNER: Benny Wang
 --
@@ -21,17 +45,29 @@
 -- NOTES:
 -- Is the main text area for the terminal program that displays the text typed by the other terminal
 -- on the other side of the serial port. This class inherits from the QPlainTextEdit.
+--
+-- With local echo on, what is sent is shown among what is received in the order it happened,
+-- received text in green and sent text in cyan.
 --------------------------------------------------------------------------------------------------*/
+#include <QKeyEvent>
+#include <QKeySequence>
+#include <QMimeData>
 #include <QPlainTextEdit>
+#include <QScrollBar>
+#include <QTextBlock>
 
 #include "Console.h"
+#include "FrameFormat.h"
 
 /*--------------------------------------------------------------------------------------------------
 -- FUNCTION: Constructor
 --
 -- DATE: September 29, 2017
 --
--- REVISIONS: N/A
+-- REVISIONS:
+-- October 18, 2026 - Attaches the highlighter.
+-- October 18, 2026 - Sets up the formats for received and sent text.
+-- October 18, 2026 - Sets up the formats for control character and invalid byte glyphs.
 --
 -- DESIGNER: Benny Wang
 --
@@ -42,16 +78,27 @@
 -- NOTES:
 -- Constructor for a console text area.
 --
--- This constructor will set the background color to black and the text color to green. 
+-- This constructor will set the background color to black and the text color to green. It also
+-- attaches a highlighter with no rules, which leaves the text as it is.
 --------------------------------------------------------------------------------------------------*/
 Console::Console(QWidget* parent)
 	: QPlainTextEdit(parent)
+	, mTransmitting(false)
+	, mShowControls(false)
+	, mBudget(nullptr)
 {
-	document()->setMaximumBlockCount(100);
+	document()->setMaximumBlockCount(MAX_LINES);
+	mHighlighter = new ConsoleHighlighter(document());
 	QPalette p = palette();
 	p.setColor(QPalette::Base, Qt::black);
 	p.setColor(QPalette::Text, Qt::green);
 	setPalette(p);
+
+	mReceiveFormat.setForeground(Qt::green);
+	mTransmitFormat.setForeground(Qt::cyan);
+	mControlFormat.setForeground(Qt::yellow);
+	mInvalidFormat.setForeground(Qt::white);
+	mInvalidFormat.setBackground(Qt::darkRed);
 }
 
 /*--------------------------------------------------------------------------------------------------
@@ -59,7 +106,10 @@ Console::Console(QWidget* parent)
 --
 -- DATE: September 29, 2017
 --
--- REVISIONS: N/A
+-- REVISIONS:
+-- October 18, 2026 - Trims the scrollback to its memory budget.
+-- October 18, 2026 - Switches back to the received text format after echoed text.
+-- October 18, 2026 - Inserts the text with InsertData so control characters can be shown.
 --
 -- DESIGNER: Benny Wang
 --
@@ -74,7 +124,387 @@ Console::Console(QWidget* parent)
 --------------------------------------------------------------------------------------------------*/
 void Console::DisplayData(const QByteArray &data)
 {
-	insertPlainText(QString(data));
+	SetDirection(false);
+	InsertData(data, mReceiveGlyphs);
+	TrimScrollback();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: DisplayFrame
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Builds the row with formatFrameRow.
+-- October 18, 2026 - Trims the scrollback to its memory budget.
+-- October 18, 2026 - Switches back to the received text format after echoed text.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: DisplayFrame (const char* data, int length, FrameDecoder::FrameStatus status,
+--                          const QTime &time)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Displays one decoded frame as a single row, e.g.
+--
+--     [14:02:11.350] len=5 crc ok | 48 65 6c 6c 6f | Hello
+--
+-- The row holds the time the frame's last chunk arrived, the payload length, the CRC or decode
+-- status, a hex dump and the printable characters. Very long frames are cut off after
+-- MAX_FRAME_ROW_BYTES bytes so one bad frame cannot stall the display. The row itself is built by
+-- formatFrameRow.
+--------------------------------------------------------------------------------------------------*/
+void Console::DisplayFrame(const char* data, int length, FrameDecoder::FrameStatus status, const QTime &time)
+{
+	SetDirection(false);
+	appendPlainText(formatFrameRow(data, length, status, time, MAX_FRAME_ROW_BYTES));
+	TrimScrollback();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: DisplayTransmitted
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Inserts the text with InsertData so control characters can be shown.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: DisplayTransmitted (const QByteArray &data)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Displays sent data in the sent text color, inline with the received text as DisplayData does.
+--------------------------------------------------------------------------------------------------*/
+void Console::DisplayTransmitted(const QByteArray &data)
+{
+	SetDirection(true);
+	InsertData(data, mTransmitGlyphs);
+	TrimScrollback();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: DisplayTransmittedFrame
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: DisplayTransmittedFrame (const char* data, int length, const QTime &time)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Displays sent data as one row in the sent text color, for when received data is shown as frame
+-- rows. The time in the row is when the data was sent, so the gap to the reply's row can be read
+-- straight off the screen.
+--------------------------------------------------------------------------------------------------*/
+void Console::DisplayTransmittedFrame(const char* data, int length, const QTime &time)
+{
+	SetDirection(true);
+	appendPlainText(formatFrameRow(data, length, FrameDecoder::FrameOk, time, MAX_FRAME_ROW_BYTES));
+	TrimScrollback();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: HighlightLastLine
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: HighlightLastLine (const QColor &color)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Paints the background of the line currently being received.
+--
+-- The highlight is an extra selection rather than a change to the text format, so text that
+-- arrives later does not inherit it. Selections follow their line as old lines are dropped from
+-- the top of the console, and no more are kept than there are lines.
+--------------------------------------------------------------------------------------------------*/
+void Console::HighlightLastLine(const QColor &color)
+{
+	QTextEdit::ExtraSelection selection;
+	selection.cursor = QTextCursor(document()->lastBlock());
+	selection.format.setBackground(color);
+	selection.format.setProperty(QTextFormat::FullWidthSelection, true);
+
+	mHighlights.append(selection);
+	while (mHighlights.size() > MAX_LINES)
+	{
+		mHighlights.removeFirst();
+	}
+	setExtraSelections(mHighlights);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: SetHighlightRules
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: SetHighlightRules (const HighlightRules &rules)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Styles the console text with rules from now on. Empty rules turn highlighting off.
+--------------------------------------------------------------------------------------------------*/
+void Console::SetHighlightRules(const HighlightRules &rules)
+{
+	mHighlighter->setRules(rules);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: SetMemoryBudget
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: SetMemoryBudget (MemoryBudget* budget)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Charges the scrollback and the highlight cache to budget, which must outlive the console.
+--------------------------------------------------------------------------------------------------*/
+void Console::SetMemoryBudget(MemoryBudget* budget)
+{
+	mBudget = budget;
+	mHighlighter->setBudget(budget);
+	TrimScrollback();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: TopLineFromEnd
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int TopLineFromEnd (void) const
+--
+-- RETURNS: int - the number of lines after the first visible line, 0 if it is the last line.
+--
+-- NOTES:
+-- Lines are counted from the end because the start of the console is trimmed as data arrives,
+-- while the end is always the newest byte received.
+--------------------------------------------------------------------------------------------------*/
+int Console::TopLineFromEnd() const
+{
+	return document()->blockCount() - 1 - firstVisibleBlock().blockNumber();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: ScrollToLineFromEnd
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void ScrollToLineFromEnd (int lines)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Scrolls so the line lines before the last is at the top. Lines older than the console keeps
+-- scroll it to the top.
+--------------------------------------------------------------------------------------------------*/
+void Console::ScrollToLineFromEnd(int lines)
+{
+	int number = qMax(0, document()->blockCount() - 1 - lines);
+	QTextBlock block = document()->findBlockByNumber(number);
+	verticalScrollBar()->setValue(block.firstLineNumber());
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: SetShowControlCharacters
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: SetShowControlCharacters (bool show)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Turns glyphs for control characters and invalid bytes on or off for text displayed from now on.
+-- Text already in the console stays as it was shown.
+--------------------------------------------------------------------------------------------------*/
+void Console::SetShowControlCharacters(bool show)
+{
+	mShowControls = show;
+	mReceiveGlyphs.reset();
+	mTransmitGlyphs.reset();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: InsertData
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: InsertData (const QByteArray &data, ControlGlyphs &glyphs)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Inserts data as text in the current format. With control characters shown, the text comes from
+-- glyphs, which keeps a UTF-8 sequence split across two reads for the next one, and each glyph is
+-- inserted in its own format: yellow for control characters and white on red for invalid bytes.
+-- Plain text between glyphs goes in one insert, so a stream without glyphs costs one insert per
+-- read as before.
+--------------------------------------------------------------------------------------------------*/
+void Console::InsertData(const QByteArray &data, ControlGlyphs &glyphs)
+{
+	if (!mShowControls)
+	{
+		insertPlainText(QString(data));
+		return;
+	}
+
+	QString text;
+	QVector<GlyphSpan> spans;
+	glyphs.render(data.constData(), data.size(), text, spans);
+
+	int start = 0;
+	for (const GlyphSpan &span : spans)
+	{
+		if (span.start > start)
+		{
+			insertPlainText(text.mid(start, span.start - start));
+		}
+		setCurrentCharFormat(span.invalid ? mInvalidFormat : mControlFormat);
+		insertPlainText(text.mid(span.start, span.length));
+		setCurrentCharFormat(mTransmitting ? mTransmitFormat : mReceiveFormat);
+		start = span.start + span.length;
+	}
+	if (start < text.size())
+	{
+		insertPlainText(text.mid(start));
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: SetDirection
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: SetDirection (bool transmitting)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Sets the format of the text inserted next to the sent or received format. Text takes the format
+-- of the text before it, so the format only has to be set when the direction changes and a
+-- console without echo never sets it at all.
+--------------------------------------------------------------------------------------------------*/
+void Console::SetDirection(bool transmitting)
+{
+	if (transmitting != mTransmitting)
+	{
+		mTransmitting = transmitting;
+		setCurrentCharFormat(transmitting ? mTransmitFormat : mReceiveFormat);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: TrimScrollback
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: TrimScrollback (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Charges the text in the console to the scrollback budget. MAX_LINES already bounds the number of
+-- lines, but binary data or a device that never sends a newline can make one line grow without
+-- end, so once the text passes the limit the oldest text is cut until it is back to three
+-- quarters of the limit. Cutting to below the limit means a busy console is trimmed now and then
+-- rather than on every read.
+--------------------------------------------------------------------------------------------------*/
+void Console::TrimScrollback()
+{
+	if (!mBudget)
+	{
+		return;
+	}
+
+	qint64 bytes = static_cast<qint64>(document()->characterCount()) * sizeof(QChar);
+	mBudget->set(MemoryBudget::Scrollback, bytes);
+	if (!mBudget->exceeded(MemoryBudget::Scrollback))
+	{
+		return;
+	}
+
+	qint64 keep = mBudget->limit(MemoryBudget::Scrollback) / sizeof(QChar) * 3 / 4;
+	QTextCursor cursor(document());
+	cursor.movePosition(QTextCursor::Start);
+	cursor.movePosition(QTextCursor::Right, QTextCursor::KeepAnchor,
+		static_cast<int>(document()->characterCount() - keep));
+	cursor.removeSelectedText();
+	moveCursor(QTextCursor::End);
+
+	mBudget->set(MemoryBudget::Scrollback, static_cast<qint64>(document()->characterCount()) * sizeof(QChar));
 }
 
 /*--------------------------------------------------------------------------------------------------
@@ -82,7 +512,9 @@ void Console::DisplayData(const QByteArray &data)
 --
 -- DATE: September 29, 2017
 --
--- REVISIONS: N/A
+-- REVISIONS:
+-- October 18, 2026 - emitKeyPressed takes a const reference.
+-- October 18, 2026 - The paste shortcut pastes instead of sending its control character.
 --
 -- DESIGNER: Benny Wang
 --
@@ -98,10 +530,19 @@ void Console::DisplayData(const QByteArray &data)
 -- of the direcitonal arrow keys or the backspace, a QByteArray representing the keypress 
 -- is emitted as a signal. 
 --
+-- The platform's paste shortcut, e.g. Ctrl+V or Shift+Insert, pastes the clipboard through
+-- insertFromMimeData rather than sending a control character.
+--
 -- The emitKeyPressed signal is connected to dcTerm::writeToPort.
 --------------------------------------------------------------------------------------------------*/
 void Console::keyPressEvent(QKeyEvent* e)
 {
+	if (e->matches(QKeySequence::Paste))
+	{
+		paste();
+		return;
+	}
+
 	switch (e->key())
 	{
 	case Qt::Key_Left:
@@ -114,3 +555,41 @@ void Console::keyPressEvent(QKeyEvent* e)
 		emit emitKeyPressed(e->text().toLocal8Bit());
 	}
 }
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: insertFromMimeData
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: insertFromMimeData (const QMimeData* source)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Called by QPlainTextEdit for a paste from the shortcut or the context menu and for a drop.
+-- The text is sent through emitKeyPressed as if it had been typed, so it reaches the port and the
+-- broadcast group, instead of being inserted into the console where nothing sends it. Line
+-- endings are sent as the carriage return that Enter sends. What the port echoes back is shown
+-- as usual.
+--------------------------------------------------------------------------------------------------*/
+void Console::insertFromMimeData(const QMimeData* source)
+{
+	if (!source->hasText())
+	{
+		return;
+	}
+
+	QString text = source->text();
+	text.replace("\r\n", "\r");
+	text.replace('\n', '\r');
+	if (!text.isEmpty())
+	{
+		emit emitKeyPressed(text.toLocal8Bit());
+	}
+}
@@ -1,5 +1,16 @@
 #pragma once
+#include <QList>
+#include <QMimeData>
 #include <QPlainTextEdit>
+#include <QTextCharFormat>
+#include <QTextEdit>
+#include <QTime>
+
+#include "ConsoleHighlighter.h"
+#include "ControlGlyphs.h"
+#include "FrameDecoder.h"
+#include "HighlightRules.h"
+#include "MemoryBudget.h"
 
 class Console
 	: public QPlainTextEdit
@@ -10,10 +21,40 @@ public:
 	explicit Console(QWidget *parent = nullptr);
 
 	void DisplayData(const QByteArray &data);
+	void DisplayFrame(const char* data, int length, FrameDecoder::FrameStatus status, const QTime &time);
+	void DisplayTransmitted(const QByteArray &data);
+	void DisplayTransmittedFrame(const char* data, int length, const QTime &time);
+	void HighlightLastLine(const QColor &color);
+	void SetHighlightRules(const HighlightRules &rules);
+	void SetMemoryBudget(MemoryBudget* budget);
+	int TopLineFromEnd() const;
+	void ScrollToLineFromEnd(int lines);
+	void SetShowControlCharacters(bool show);
+
+private:
+	static const int MAX_FRAME_ROW_BYTES = 1024;
+	static const int MAX_LINES = 100;
+
+	QList<QTextEdit::ExtraSelection> mHighlights;
+	QTextCharFormat mReceiveFormat;
+	QTextCharFormat mTransmitFormat;
+	QTextCharFormat mControlFormat;
+	QTextCharFormat mInvalidFormat;
+	bool mTransmitting;
+	bool mShowControls;
+	ControlGlyphs mReceiveGlyphs;
+	ControlGlyphs mTransmitGlyphs;
+	ConsoleHighlighter* mHighlighter;
+	MemoryBudget* mBudget;
+
+	void InsertData(const QByteArray &data, ControlGlyphs &glyphs);
+	void SetDirection(bool transmitting);
+	void TrimScrollback();
 
 protected:
 	void keyPressEvent(QKeyEvent* e) Q_DECL_OVERRIDE;
+	void insertFromMimeData(const QMimeData* source) Q_DECL_OVERRIDE;
 
 signals:
-	void emitKeyPressed(QByteArray &data);
+	void emitKeyPressed(const QByteArray &data);
 };
\ No newline at end of file
@@ -0,0 +1,307 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: ConsoleHighlighter.cpp - Styles console lines with the highlight rules.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- void setRules(const HighlightRules &rules);
+-- const HighlightRules &rules() const;
+--
+-- void setBudget(MemoryBudget* budget);
+--
+-- void highlightBlock(const QString &text);
+--
+-- LineCache::LineCache(MemoryBudget* budget);
+-- LineCache::~LineCache();
+-- void LineCache::update(const HighlightRules &rules, const QString &text, uint textHash, uint ruleGeneration);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Line caches are charged to the memory budget.
+-- October 18, 2026 - New line caches also stop at the session's total memory limit.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- A QSyntaxHighlighter on the console's document. Qt only asks it to style the lines that changed,
+-- which while receiving are the line being added to and any new lines after it, so the cost of
+-- highlighting follows the amount of new data and not the size of the scrollback.
+--
+-- Each line keeps the spans found for it along with a hash of its text. Qt also asks for lines
+-- that did not change, e.g. the new first line when the oldest line is dropped, and those reuse
+-- their spans instead of running the rules again. Loading new rules restyles every line once.
+--
+-- The caches are charged to the highlight budget. Once it or the session's total is used up, new
+-- lines are still styled but their spans are not kept.
+--------------------------------------------------------------------------------------------------*/
+#include <QColor>
+#include <QFont>
+#include <QHash>
+
+#include "ConsoleHighlighter.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: ConsoleHighlighter (QTextDocument*)
+--
+-- NOTES:
+-- Constructor for a highlighter with no rules on document.
+--------------------------------------------------------------------------------------------------*/
+ConsoleHighlighter::ConsoleHighlighter(QTextDocument* document)
+	: QSyntaxHighlighter(document)
+	, mGeneration(0)
+	, mBudget(nullptr)
+{
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setRules
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setRules (const HighlightRules &rules)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Replaces the rules, builds the text format of each one and restyles the console. Cached spans
+-- from the old rules are invalidated by moving to a new generation.
+--------------------------------------------------------------------------------------------------*/
+void ConsoleHighlighter::setRules(const HighlightRules &rules)
+{
+	mRules = rules;
+	mFormats.clear();
+
+	for (const HighlightRule &rule : mRules.rules())
+	{
+		QTextCharFormat format;
+		if (!rule.foreground.isEmpty())
+		{
+			format.setForeground(QColor(rule.foreground));
+		}
+		if (!rule.background.isEmpty())
+		{
+			format.setBackground(QColor(rule.background));
+		}
+		if (rule.bold)
+		{
+			format.setFontWeight(QFont::Bold);
+		}
+		format.setFontItalic(rule.italic);
+		format.setFontUnderline(rule.underline);
+		mFormats.append(format);
+	}
+
+	mGeneration++;
+	rehighlight();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: rules
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: const HighlightRules &rules (void) const
+--
+-- RETURNS: const HighlightRules& - the rules in use.
+--------------------------------------------------------------------------------------------------*/
+const HighlightRules &ConsoleHighlighter::rules() const
+{
+	return mRules;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setBudget
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setBudget (MemoryBudget* budget)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Sets the budget line caches are charged to. It must be set before any rules are loaded and
+-- outlive the highlighter.
+--------------------------------------------------------------------------------------------------*/
+void ConsoleHighlighter::setBudget(MemoryBudget* budget)
+{
+	mBudget = budget;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: highlightBlock
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Stops caching at the total limit as well.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void highlightBlock (const QString &text)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Called by Qt for each line that needs styling. The rules are only run if the line's cache is
+-- missing, from older rules, or for different text. No new caches are made once the highlight
+-- limit or the session's total limit is reached.
+--------------------------------------------------------------------------------------------------*/
+void ConsoleHighlighter::highlightBlock(const QString &text)
+{
+	if (mRules.isEmpty())
+	{
+		return;
+	}
+
+	LineCache* cache = static_cast<LineCache*>(currentBlockUserData());
+	uint hash = qHash(text);
+
+	if (cache == nullptr)
+	{
+		if (mBudget && (mBudget->exceeded(MemoryBudget::Highlight) || mBudget->totalExceeded()))
+		{
+			mRules.match(text, mUncached);
+			for (const HighlightSpan &span : mUncached)
+			{
+				setFormat(span.start, span.length, mFormats[span.rule]);
+			}
+			return;
+		}
+
+		cache = new LineCache(mBudget);
+		cache->generation = mGeneration - 1;
+		setCurrentBlockUserData(cache);
+	}
+
+	if (cache->generation != mGeneration || cache->length != text.length() || cache->hash != hash)
+	{
+		cache->update(mRules, text, hash, mGeneration);
+	}
+
+	for (const HighlightSpan &span : cache->spans)
+	{
+		setFormat(span.start, span.length, mFormats[span.rule]);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: LineCache
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: LineCache (MemoryBudget*)
+--
+-- NOTES:
+-- Constructor for an empty cache charged to budget, if given. Qt owns the cache and deletes it
+-- with its line.
+--------------------------------------------------------------------------------------------------*/
+ConsoleHighlighter::LineCache::LineCache(MemoryBudget* budget)
+	: generation(0)
+	, hash(0)
+	, length(0)
+	, mBudget(budget)
+	, mCharged(sizeof(LineCache))
+{
+	if (mBudget)
+	{
+		mBudget->charge(MemoryBudget::Highlight, mCharged);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: ~LineCache
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: ~LineCache ()
+--
+-- NOTES:
+-- Gives back what the cache was charged.
+--------------------------------------------------------------------------------------------------*/
+ConsoleHighlighter::LineCache::~LineCache()
+{
+	if (mBudget)
+	{
+		mBudget->release(MemoryBudget::Highlight, mCharged);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: update
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void update (const HighlightRules &rules, const QString &text, uint textHash,
+--                         uint ruleGeneration)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Runs rules over text, keeps the spans and recharges the budget for their storage.
+--------------------------------------------------------------------------------------------------*/
+void ConsoleHighlighter::LineCache::update(const HighlightRules &rules, const QString &text, uint textHash,
+	uint ruleGeneration)
+{
+	rules.match(text, spans);
+	generation = ruleGeneration;
+	hash = textHash;
+	length = text.length();
+
+	qint64 charged = sizeof(LineCache) + static_cast<qint64>(spans.capacity()) * sizeof(HighlightSpan);
+	if (mBudget)
+	{
+		mBudget->charge(MemoryBudget::Highlight, charged - mCharged);
+	}
+	mCharged = charged;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <QSyntaxHighlighter>
+#include <QTextCharFormat>
+#include <QTextDocument>
+#include <QVector>
+
+#include "HighlightRules.h"
+#include "MemoryBudget.h"
+
+class ConsoleHighlighter
+	: public QSyntaxHighlighter
+{
+	Q_OBJECT
+
+public:
+	explicit ConsoleHighlighter(QTextDocument* document);
+
+	void setRules(const HighlightRules &rules);
+	const HighlightRules &rules() const;
+
+	void setBudget(MemoryBudget* budget);
+
+protected:
+	void highlightBlock(const QString &text) Q_DECL_OVERRIDE;
+
+private:
+	class LineCache
+		: public QTextBlockUserData
+	{
+	public:
+		explicit LineCache(MemoryBudget* budget);
+		~LineCache();
+
+		void update(const HighlightRules &rules, const QString &text, uint textHash, uint ruleGeneration);
+
+		uint generation;
+		uint hash;
+		int length;
+		QVector<HighlightSpan> spans;
+
+	private:
+		MemoryBudget* mBudget;
+		qint64 mCharged;
+	};
+
+	HighlightRules mRules;
+	QVector<QTextCharFormat> mFormats;
+	uint mGeneration;
+	MemoryBudget* mBudget;
+	QVector<HighlightSpan> mUncached;
+};
@@ -0,0 +1,371 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: ControlGlyphs.cpp - Turns received bytes into text with control characters and
+--                                  invalid bytes shown as glyphs.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- void reset();
+-- void render(const char* data, int size, QString &text, QVector<GlyphSpan> &glyphs);
+--
+-- static int plainRun(const char* data, int size);
+--
+-- static int sequenceLength(const uchar* data, int size);
+-- static void appendGlyph(uchar byte, bool invalid, QString &text, QVector<GlyphSpan> &glyphs);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- Without it, NULs and other control codes vanish when inserted into the console and bytes that
+-- are not UTF-8 turn into replacement characters, so a stream that is mostly text but not quite
+-- cannot be told apart from one that is. With it:
+-- - Control characters are shown in caret notation, e.g. ^@ for NUL, ^[ for ESC and ^? for DEL.
+--   Tab, line feed and carriage return are left alone so text still lays out as text.
+-- - Valid UTF-8 sequences are decoded as usual, even when split across two reads.
+-- - Any other byte is shown as its hex value in angle brackets, e.g. <FF>.
+-- Each glyph is reported as a span of the returned text so the console can style it apart from a
+-- literal "^A" in the data.
+--
+-- Most streams are mostly printable, so plainRun finds the end of a printable run sixteen bytes at
+-- a time with SSE2 and the run is appended in one go. Builds without SSE2 check a byte at a time.
+--------------------------------------------------------------------------------------------------*/
+#include <cstring>
+
+#include <QtAlgorithms>
+
+#include "ControlGlyphs.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CONTROL_GLYPHS_SSE2
+#endif
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: ControlGlyphs
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: ControlGlyphs ()
+--
+-- RETURNS: N/A
+--------------------------------------------------------------------------------------------------*/
+ControlGlyphs::ControlGlyphs()
+	: mPendingSize(0)
+{
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: reset
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void reset (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Forgets the start of a UTF-8 sequence held back from the last read.
+--------------------------------------------------------------------------------------------------*/
+void ControlGlyphs::reset()
+{
+	mPendingSize = 0;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: render
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void render (const char* data, int size, QString &text, QVector<GlyphSpan> &glyphs)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Appends the text for size bytes of data to text and a span to glyphs for each run of glyphs in
+-- it. A UTF-8 sequence cut off at the end of data is held back and finished by the next call; if
+-- the next bytes do not finish it, the held back bytes are shown as invalid.
+--------------------------------------------------------------------------------------------------*/
+void ControlGlyphs::render(const char* data, int size, QString &text, QVector<GlyphSpan> &glyphs)
+{
+	int i = 0;
+
+	if (mPendingSize > 0)
+	{
+		char joined[sizeof(mPending)];
+		int taken = qMin(size, static_cast<int>(sizeof(mPending)) - mPendingSize);
+		memcpy(joined, mPending, mPendingSize);
+		memcpy(joined + mPendingSize, data, taken);
+
+		int length = sequenceLength(reinterpret_cast<const uchar*>(joined), mPendingSize + taken);
+		if (length == 0)
+		{
+			memcpy(mPending + mPendingSize, data, taken);
+			mPendingSize += taken;
+			return;
+		}
+
+		if (length > 0)
+		{
+			text.append(QString::fromUtf8(joined, length));
+			i = length - mPendingSize;
+		}
+		else
+		{
+			for (int j = 0; j < mPendingSize; ++j)
+			{
+				appendGlyph(static_cast<uchar>(mPending[j]), true, text, glyphs);
+			}
+		}
+		mPendingSize = 0;
+	}
+
+	while (i < size)
+	{
+		int run = plainRun(data + i, size - i);
+		if (run > 0)
+		{
+			text.append(QLatin1String(data + i, run));
+			i += run;
+			if (i == size)
+			{
+				break;
+			}
+		}
+
+		uchar byte = static_cast<uchar>(data[i]);
+		if (byte < 0x80)
+		{
+			appendGlyph(byte, false, text, glyphs);
+			++i;
+			continue;
+		}
+
+		int length = sequenceLength(reinterpret_cast<const uchar*>(data + i), size - i);
+		if (length > 0)
+		{
+			text.append(QString::fromUtf8(data + i, length));
+			i += length;
+		}
+		else if (length == 0)
+		{
+			mPendingSize = size - i;
+			memcpy(mPending, data + i, mPendingSize);
+			break;
+		}
+		else
+		{
+			appendGlyph(byte, true, text, glyphs);
+			++i;
+		}
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: plainRun
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: static int plainRun (const char* data, int size)
+--
+-- RETURNS: int - how many bytes at the start of data are printable ASCII, tab, line feed or
+--                carriage return.
+--
+-- NOTES:
+-- Compared as signed bytes, printable ASCII is exactly the bytes above 0x1F and below 0x7F, since
+-- every byte from 0x80 up is negative. One mask of sixteen bytes covers both bounds and the three
+-- whitespace characters, and the first clear bit in it is where the run ends.
+--------------------------------------------------------------------------------------------------*/
+int ControlGlyphs::plainRun(const char* data, int size)
+{
+	int i = 0;
+
+#ifdef CONTROL_GLYPHS_SSE2
+	const __m128i below = _mm_set1_epi8(0x1F);
+	const __m128i above = _mm_set1_epi8(0x7F);
+	const __m128i tab = _mm_set1_epi8('\t');
+	const __m128i lineFeed = _mm_set1_epi8('\n');
+	const __m128i carriageReturn = _mm_set1_epi8('\r');
+
+	for (; i + 16 <= size; i += 16)
+	{
+		__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+		__m128i plain = _mm_and_si128(_mm_cmpgt_epi8(bytes, below), _mm_cmplt_epi8(bytes, above));
+		plain = _mm_or_si128(plain, _mm_cmpeq_epi8(bytes, tab));
+		plain = _mm_or_si128(plain, _mm_cmpeq_epi8(bytes, lineFeed));
+		plain = _mm_or_si128(plain, _mm_cmpeq_epi8(bytes, carriageReturn));
+
+		int mask = _mm_movemask_epi8(plain);
+		if (mask != 0xFFFF)
+		{
+			return i + qCountTrailingZeroBits(static_cast<quint32>(~mask));
+		}
+	}
+#endif
+
+	for (; i < size; ++i)
+	{
+		uchar byte = static_cast<uchar>(data[i]);
+		if ((byte < 0x20 || byte >= 0x7F) && byte != '\t' && byte != '\n' && byte != '\r')
+		{
+			break;
+		}
+	}
+	return i;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: sequenceLength
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: static int sequenceLength (const uchar* data, int size)
+--
+-- RETURNS: int - the length of the UTF-8 sequence starting at data, 0 if size ends before the
+--                sequence does or -1 if data does not start a valid sequence.
+--
+-- NOTES:
+-- Overlong forms, surrogates and code points above U+10FFFF are invalid, which comes down to a
+-- narrower range for the second byte after the lead bytes E0, ED, F0 and F4.
+--------------------------------------------------------------------------------------------------*/
+int ControlGlyphs::sequenceLength(const uchar* data, int size)
+{
+	uchar lead = data[0];
+	uchar low = 0x80;
+	uchar high = 0xBF;
+	int length;
+
+	if (lead >= 0xC2 && lead <= 0xDF)
+	{
+		length = 2;
+	}
+	else if (lead >= 0xE0 && lead <= 0xEF)
+	{
+		length = 3;
+		if (lead == 0xE0)
+		{
+			low = 0xA0;
+		}
+		else if (lead == 0xED)
+		{
+			high = 0x9F;
+		}
+	}
+	else if (lead >= 0xF0 && lead <= 0xF4)
+	{
+		length = 4;
+		if (lead == 0xF0)
+		{
+			low = 0x90;
+		}
+		else if (lead == 0xF4)
+		{
+			high = 0x8F;
+		}
+	}
+	else
+	{
+		return -1;
+	}
+
+	for (int i = 1; i < length; ++i)
+	{
+		if (i >= size)
+		{
+			return 0;
+		}
+		if (data[i] < low || data[i] > high)
+		{
+			return -1;
+		}
+		low = 0x80;
+		high = 0xBF;
+	}
+	return length;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: appendGlyph
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: static void appendGlyph (uchar byte, bool invalid, QString &text,
+--                                     QVector<GlyphSpan> &glyphs)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Appends the glyph for byte, caret notation for a control character or <XX> for an invalid byte,
+-- and grows the last span if the glyph directly follows one of the same kind.
+--------------------------------------------------------------------------------------------------*/
+void ControlGlyphs::appendGlyph(uchar byte, bool invalid, QString &text, QVector<GlyphSpan> &glyphs)
+{
+	static const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+	int start = text.size();
+	if (invalid)
+	{
+		text.append(QLatin1Char('<'));
+		text.append(QLatin1Char(HEX_DIGITS[byte >> 4]));
+		text.append(QLatin1Char(HEX_DIGITS[byte & 0x0F]));
+		text.append(QLatin1Char('>'));
+	}
+	else
+	{
+		text.append(QLatin1Char('^'));
+		text.append(QLatin1Char(byte == 0x7F ? '?' : static_cast<char>(byte + 0x40)));
+	}
+
+	int length = text.size() - start;
+	if (!glyphs.isEmpty() && glyphs.last().invalid == invalid
+		&& glyphs.last().start + glyphs.last().length == start)
+	{
+		glyphs.last().length += length;
+	}
+	else
+	{
+		GlyphSpan span = { start, length, invalid };
+		glyphs.append(span);
+	}
+}
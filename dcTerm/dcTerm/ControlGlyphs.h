@@ -0,0 +1,29 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+struct GlyphSpan
+{
+	int start;
+	int length;
+	bool invalid;
+};
+
+class ControlGlyphs
+{
+public:
+	ControlGlyphs();
+
+	void reset();
+	void render(const char* data, int size, QString &text, QVector<GlyphSpan> &glyphs);
+
+	static int plainRun(const char* data, int size);
+
+private:
+	char mPending[4];
+	int mPendingSize;
+
+	static int sequenceLength(const uchar* data, int size);
+	static void appendGlyph(uchar byte, bool invalid, QString &text, QVector<GlyphSpan> &glyphs);
+};
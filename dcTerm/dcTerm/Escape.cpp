@@ -0,0 +1,83 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: Escape.cpp - Conversion between typed escape sequences and raw bytes.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- QByteArray unescape(const QString &text);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- Delimiters, trigger patterns and trigger responses are all typed as text but may need control
+-- characters, so they share one escape syntax.
+--------------------------------------------------------------------------------------------------*/
+#include "Escape.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: unescape
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QByteArray unescape (const QString &text)
+--
+-- RETURNS: QByteArray - the bytes described by text.
+--
+-- NOTES:
+-- Turns text typed by the user into bytes, understanding the C escapes \r, \n, \t, \0, \\ and
+-- \xNN so control characters can be entered from a dialog box.
+--------------------------------------------------------------------------------------------------*/
+QByteArray unescape(const QString &text)
+{
+	QByteArray in = text.toLocal8Bit();
+	QByteArray out;
+
+	for (int i = 0; i < in.size(); i++)
+	{
+		if (in[i] != '\\' || i + 1 >= in.size())
+		{
+			out.append(in[i]);
+			continue;
+		}
+
+		char c = in[++i];
+		switch (c)
+		{
+		case 'r':
+			out.append('\r');
+			break;
+		case 'n':
+			out.append('\n');
+			break;
+		case 't':
+			out.append('\t');
+			break;
+		case '0':
+			out.append('\0');
+			break;
+		case 'x':
+			if (i + 2 < in.size())
+			{
+				out.append(static_cast<char>(in.mid(i + 1, 2).toInt(nullptr, 16)));
+				i += 2;
+			}
+			break;
+		default:
+			out.append(c);
+		}
+	}
+
+	return out;
+}
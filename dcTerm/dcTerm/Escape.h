@@ -0,0 +1,6 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+QByteArray unescape(const QString &text);
@@ -0,0 +1,470 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: ExportWriter.cpp - Writes traffic out as text, a hex dump, CSV or pcap.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- bool begin(QIODevice* device);
+-- bool write(qint64 timestamp, CaptureFile::Direction direction, const char* data, int size);
+-- bool finish();
+--
+-- qint64 bytesWritten() const;
+--
+-- void writeHexDump(qint64 timestamp, CaptureFile::Direction direction, const char* data, int size);
+-- void writeCsv(qint64 timestamp, CaptureFile::Direction direction, const char* data, int size);
+-- void writePcap(qint64 timestamp, CaptureFile::Direction direction, const char* data, int size);
+--
+-- void appendTime(qint64 timestamp);
+-- void appendHex(const char* data, int size, char separator);
+-- bool flush();
+--
+-- const char* directionName(CaptureFile::Direction direction);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- Takes traffic one record at a time, in the form of a capture record, and writes it to a device
+-- in one of four formats:
+--
+-- Text     the sent and received bytes as they are, like a terminal with local echo. Events are
+--          left out.
+--
+-- HexDump  each record as a line with its time, direction and size followed by rows of
+--          HEX_BYTES_PER_ROW bytes in hex and as characters:
+--
+--              2026-10-18T14:02:11.350123Z rx 5
+--              00000000  48 65 6c 6c 6f                                    Hello
+--
+-- Csv      one row per record of timestamp,direction,bytes, the bytes in hex:
+--
+--              2026-10-18T14:02:11.350123Z,rx,48656c6c6f
+--
+-- Pcap     a libpcap file with microsecond timestamps and one packet per record, for opening in
+--          Wireshark. The link type is one of the user types 147 to 162 so a protocol's dissector
+--          can be assigned to it in Wireshark's DLT_USER preferences. Each packet starts with one
+--          byte giving the direction (0 received, 1 sent, 2 event), then the record's bytes, so
+--          the dissector should be set up with a header size of 1.
+--
+-- Times are written in UTC. The text for the current second is built once and reused, since a
+-- capture may have thousands of records a second.
+--
+-- Output is gathered in a buffer and written to the device FLUSH_SIZE bytes at a time, so the
+-- memory used is the same whatever the size of the export.
+--------------------------------------------------------------------------------------------------*/
+#include <QDateTime>
+#include <QtEndian>
+
+#include "ExportWriter.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: ExportWriter (Format format, int linkType)
+--
+-- NOTES:
+-- Constructor for a writer of format. linkType is only used for pcap and is kept within the user
+-- link types.
+--------------------------------------------------------------------------------------------------*/
+ExportWriter::ExportWriter(Format format, int linkType)
+	: mFormat(format)
+	, mLinkType(qBound(static_cast<int>(LINKTYPE_USER0), linkType, static_cast<int>(LINKTYPE_USER15)))
+	, mDevice(nullptr)
+	, mWritten(0)
+	, mSecond(-1)
+{
+	mBuffer.reserve(FLUSH_SIZE * 2);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: begin
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool begin (QIODevice* device)
+--
+-- RETURNS: bool - true if the start of the export was written.
+--
+-- NOTES:
+-- Starts an export to device, which must be open for writing, with the CSV header row or the
+-- pcap file header.
+--------------------------------------------------------------------------------------------------*/
+bool ExportWriter::begin(QIODevice* device)
+{
+	mDevice = device;
+	mBuffer.resize(0);
+	mWritten = 0;
+
+	if (mFormat == Csv)
+	{
+		mBuffer.append("timestamp,direction,bytes\n");
+	}
+	else if (mFormat == Pcap)
+	{
+		uchar header[24];
+		qToLittleEndian<quint32>(0xa1b2c3d4, header);
+		qToLittleEndian<quint16>(2, header + 4);
+		qToLittleEndian<quint16>(4, header + 6);
+		qToLittleEndian<qint32>(0, header + 8);
+		qToLittleEndian<quint32>(0, header + 12);
+		qToLittleEndian<quint32>(PCAP_SNAPSHOT_LENGTH, header + 16);
+		qToLittleEndian<quint32>(static_cast<quint32>(mLinkType), header + 20);
+		mBuffer.append(reinterpret_cast<const char*>(header), sizeof(header));
+	}
+	return flush();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: write
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool write (qint64 timestamp, CaptureFile::Direction direction, const char* data,
+--                        int size)
+--
+-- RETURNS: bool - false if writing to the device failed.
+--
+-- NOTES:
+-- Adds one record to the export. It reaches the device once FLUSH_SIZE bytes have gathered.
+--------------------------------------------------------------------------------------------------*/
+bool ExportWriter::write(qint64 timestamp, CaptureFile::Direction direction, const char* data, int size)
+{
+	switch (mFormat)
+	{
+	case Text:
+		if (direction != CaptureFile::Event)
+		{
+			mBuffer.append(data, size);
+		}
+		break;
+	case HexDump:
+		writeHexDump(timestamp, direction, data, size);
+		break;
+	case Csv:
+		writeCsv(timestamp, direction, data, size);
+		break;
+	case Pcap:
+		writePcap(timestamp, direction, data, size);
+		break;
+	}
+
+	return mBuffer.size() < FLUSH_SIZE || flush();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: finish
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool finish (void)
+--
+-- RETURNS: bool - false if writing to the device failed.
+--
+-- NOTES:
+-- Writes out whatever is left in the buffer. The device is left open.
+--------------------------------------------------------------------------------------------------*/
+bool ExportWriter::finish()
+{
+	return flush();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: bytesWritten
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 bytesWritten (void) const
+--
+-- RETURNS: qint64 - the number of bytes written to the device so far.
+--------------------------------------------------------------------------------------------------*/
+qint64 ExportWriter::bytesWritten() const
+{
+	return mWritten;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: writeHexDump
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void writeHexDump (qint64 timestamp, CaptureFile::Direction direction,
+--                               const char* data, int size)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Adds a record as a heading line and its rows. Each row is padded to full width so the character
+-- columns line up on the last row of a record.
+--------------------------------------------------------------------------------------------------*/
+void ExportWriter::writeHexDump(qint64 timestamp, CaptureFile::Direction direction, const char* data, int size)
+{
+	appendTime(timestamp);
+	mBuffer.append(' ');
+	mBuffer.append(directionName(direction));
+	mBuffer.append(' ');
+	mBuffer.append(QByteArray::number(size));
+	mBuffer.append('\n');
+
+	for (int row = 0; row < size; row += HEX_BYTES_PER_ROW)
+	{
+		int count = qMin(static_cast<int>(HEX_BYTES_PER_ROW), size - row);
+
+		mBuffer.append(QByteArray::number(row, 16).rightJustified(8, '0'));
+		mBuffer.append("  ");
+		appendHex(data + row, count, ' ');
+		mBuffer.append(QByteArray((HEX_BYTES_PER_ROW - count) * 3 + 1, ' '));
+
+		for (int i = 0; i < count; i++)
+		{
+			uchar c = static_cast<uchar>(data[row + i]);
+			mBuffer.append((c >= 0x20 && c < 0x7f) ? static_cast<char>(c) : '.');
+		}
+		mBuffer.append('\n');
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: writeCsv
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void writeCsv (qint64 timestamp, CaptureFile::Direction direction, const char* data,
+--                           int size)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Adds a record as one CSV row. None of the fields can hold a comma or quote, so none are quoted.
+--------------------------------------------------------------------------------------------------*/
+void ExportWriter::writeCsv(qint64 timestamp, CaptureFile::Direction direction, const char* data, int size)
+{
+	appendTime(timestamp);
+	mBuffer.append(',');
+	mBuffer.append(directionName(direction));
+	mBuffer.append(',');
+	appendHex(data, size, 0);
+	mBuffer.append('\n');
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: writePcap
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void writePcap (qint64 timestamp, CaptureFile::Direction direction, const char* data,
+--                            int size)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Adds a record as one packet: the packet header, the direction byte and the bytes. A record
+-- longer than the snapshot length is cut short with its full length kept in the header, as a
+-- capture tool would.
+--------------------------------------------------------------------------------------------------*/
+void ExportWriter::writePcap(qint64 timestamp, CaptureFile::Direction direction, const char* data, int size)
+{
+	int length = size + 1;
+	int saved = qMin(length, static_cast<int>(PCAP_SNAPSHOT_LENGTH));
+
+	uchar header[16];
+	qToLittleEndian<quint32>(static_cast<quint32>(timestamp / 1000000), header);
+	qToLittleEndian<quint32>(static_cast<quint32>(timestamp % 1000000), header + 4);
+	qToLittleEndian<quint32>(static_cast<quint32>(saved), header + 8);
+	qToLittleEndian<quint32>(static_cast<quint32>(length), header + 12);
+
+	mBuffer.append(reinterpret_cast<const char*>(header), sizeof(header));
+	mBuffer.append(static_cast<char>(direction));
+	mBuffer.append(data, saved - 1);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: appendTime
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void appendTime (qint64 timestamp)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Adds timestamp, in microseconds since the Unix epoch, as an ISO 8601 UTC time with microseconds.
+--------------------------------------------------------------------------------------------------*/
+void ExportWriter::appendTime(qint64 timestamp)
+{
+	qint64 second = timestamp / 1000000;
+	if (second != mSecond)
+	{
+		mSecond = second;
+		mSecondText = QDateTime::fromMSecsSinceEpoch(second * 1000, Qt::UTC)
+			.toString("yyyy-MM-ddTHH:mm:ss").toLatin1();
+	}
+
+	mBuffer.append(mSecondText);
+	mBuffer.append('.');
+	mBuffer.append(QByteArray::number(timestamp % 1000000).rightJustified(6, '0'));
+	mBuffer.append('Z');
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: appendHex
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void appendHex (const char* data, int size, char separator)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Adds data as lower case hex, with separator after each byte unless it is 0.
+--------------------------------------------------------------------------------------------------*/
+void ExportWriter::appendHex(const char* data, int size, char separator)
+{
+	static const char digits[] = "0123456789abcdef";
+
+	int start = mBuffer.size();
+	int width = separator ? 3 : 2;
+	mBuffer.resize(start + size * width);
+
+	char* out = mBuffer.data() + start;
+	for (int i = 0; i < size; i++)
+	{
+		uchar c = static_cast<uchar>(data[i]);
+		*out++ = digits[c >> 4];
+		*out++ = digits[c & 0x0f];
+		if (separator)
+		{
+			*out++ = separator;
+		}
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: flush
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool flush (void)
+--
+-- RETURNS: bool - false if writing to the device failed.
+--
+-- NOTES:
+-- Writes the buffer to the device and empties it, keeping its capacity for the next records.
+--------------------------------------------------------------------------------------------------*/
+bool ExportWriter::flush()
+{
+	if (mBuffer.isEmpty())
+	{
+		return true;
+	}
+
+	qint64 written = mDevice->write(mBuffer);
+	if (written != mBuffer.size())
+	{
+		return false;
+	}
+
+	mWritten += written;
+	mBuffer.resize(0);
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: directionName
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: static const char* directionName (CaptureFile::Direction direction)
+--
+-- RETURNS: const char* - the short name of direction used in the hex dump and CSV.
+--------------------------------------------------------------------------------------------------*/
+const char* ExportWriter::directionName(CaptureFile::Direction direction)
+{
+	switch (direction)
+	{
+	case CaptureFile::Received:
+		return "rx";
+	case CaptureFile::Transmitted:
+		return "tx";
+	default:
+		return "event";
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <QByteArray>
+#include <QIODevice>
+
+#include "CaptureFile.h"
+
+class ExportWriter
+{
+public:
+	enum Format
+	{
+		Text,
+		HexDump,
+		Csv,
+		Pcap
+	};
+
+	static const int FLUSH_SIZE = 64 * 1024;
+	static const int HEX_BYTES_PER_ROW = 16;
+	static const int PCAP_SNAPSHOT_LENGTH = 262144;
+	static const int LINKTYPE_USER0 = 147;
+	static const int LINKTYPE_USER15 = 162;
+
+	explicit ExportWriter(Format format, int linkType = LINKTYPE_USER0);
+
+	bool begin(QIODevice* device);
+	bool write(qint64 timestamp, CaptureFile::Direction direction, const char* data, int size);
+	bool finish();
+
+	qint64 bytesWritten() const;
+
+private:
+	Format mFormat;
+	int mLinkType;
+	QIODevice* mDevice;
+	QByteArray mBuffer;
+	qint64 mWritten;
+
+	qint64 mSecond;
+	QByteArray mSecondText;
+
+	void writeHexDump(qint64 timestamp, CaptureFile::Direction direction, const char* data, int size);
+	void writeCsv(qint64 timestamp, CaptureFile::Direction direction, const char* data, int size);
+	void writePcap(qint64 timestamp, CaptureFile::Direction direction, const char* data, int size);
+
+	void appendTime(qint64 timestamp);
+	void appendHex(const char* data, int size, char separator);
+	bool flush();
+
+	static const char* directionName(CaptureFile::Direction direction);
+};
@@ -0,0 +1,795 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: FrameDecoder.cpp - Splits the received byte stream into protocol frames.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- void reset();
+-- void setCrcCheck(bool enabled);
+-- bool crcCheck() const;
+-- quint16 crc16(const char* data, int length);
+-- void finishFrame(const FrameCallback &onFrame);
+-- void abortFrame(FrameStatus status, const FrameCallback &onFrame);
+--
+-- void SlipDecoder::feed(const char* data, int size, const FrameCallback &onFrame);
+-- void CobsDecoder::feed(const char* data, int size, const FrameCallback &onFrame);
+-- void LengthPrefixDecoder::feed(const char* data, int size, const FrameCallback &onFrame);
+-- void DelimiterDecoder::feed(const char* data, int size, const FrameCallback &onFrame);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- A frame decoder sits between the serial port and the console. Bytes are fed in exactly as they
+-- arrive from the port, in chunks of any size, and every complete frame is handed to a callback.
+-- A frame may span any number of chunks.
+--
+-- Decoders are incremental state machines that copy payload bytes into a buffer allocated once
+-- when the decoder is created, so decoding never allocates. The callback receives a pointer into
+-- that buffer which is only valid until the callback returns.
+--
+-- When CRC checking is enabled the last two bytes of every frame are taken as a big-endian
+-- CRC-16/CCITT-FALSE of the rest of the frame and are stripped before the frame is delivered.
+--------------------------------------------------------------------------------------------------*/
+#include "FrameDecoder.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: FrameDecoder (int maxFrameSize)
+--
+-- NOTES:
+-- Allocates the frame buffer. Frames longer than maxFrameSize are reported as FrameOverflow.
+--------------------------------------------------------------------------------------------------*/
+FrameDecoder::FrameDecoder(int maxFrameSize)
+	: mBuffer(maxFrameSize, '\0')
+	, mFrame(mBuffer.data())
+	, mCapacity(maxFrameSize)
+	, mLength(0)
+	, mOverflow(false)
+	, mCrcCheck(false)
+{
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Deconstructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: ~FrameDecoder ()
+--------------------------------------------------------------------------------------------------*/
+FrameDecoder::~FrameDecoder()
+{
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: reset
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void reset (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Discards any partially received frame. Subclasses extend this to clear their own state.
+--------------------------------------------------------------------------------------------------*/
+void FrameDecoder::reset()
+{
+	mLength = 0;
+	mOverflow = false;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setCrcCheck
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setCrcCheck (bool enabled)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Turns checking of the trailing CRC-16 on or off.
+--------------------------------------------------------------------------------------------------*/
+void FrameDecoder::setCrcCheck(bool enabled)
+{
+	mCrcCheck = enabled;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: crcCheck
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool crcCheck (void) const
+--
+-- RETURNS: bool - true if the trailing CRC-16 of each frame is checked.
+--------------------------------------------------------------------------------------------------*/
+bool FrameDecoder::crcCheck() const
+{
+	return mCrcCheck;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: crc16
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: quint16 crc16 (const char* data, int length)
+--
+-- RETURNS: quint16 - the CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) of the data.
+--------------------------------------------------------------------------------------------------*/
+quint16 FrameDecoder::crc16(const char* data, int length)
+{
+	quint16 crc = 0xFFFF;
+	for (int i = 0; i < length; i++)
+	{
+		crc ^= static_cast<quint16>(static_cast<unsigned char>(data[i]) << 8);
+		for (int bit = 0; bit < 8; bit++)
+		{
+			crc = (crc & 0x8000) ? static_cast<quint16>((crc << 1) ^ 0x1021) : static_cast<quint16>(crc << 1);
+		}
+	}
+	return crc;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: finishFrame
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void finishFrame (const FrameCallback &onFrame)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Called by a subclass when it has seen the end of a frame. Checks the CRC if enabled, hands the
+-- frame to the callback and starts a new frame.
+--------------------------------------------------------------------------------------------------*/
+void FrameDecoder::finishFrame(const FrameCallback &onFrame)
+{
+	if (mOverflow)
+	{
+		abortFrame(FrameOverflow, onFrame);
+		return;
+	}
+
+	int length = mLength;
+	FrameStatus status = FrameOk;
+
+	if (mCrcCheck)
+	{
+		if (length < 2)
+		{
+			status = FrameCrcError;
+		}
+		else
+		{
+			length -= 2;
+			quint16 expected = static_cast<quint16>((static_cast<unsigned char>(mFrame[length]) << 8)
+				| static_cast<unsigned char>(mFrame[length + 1]));
+			if (crc16(mFrame, length) != expected)
+			{
+				status = FrameCrcError;
+			}
+		}
+	}
+
+	onFrame(mFrame, length, status);
+	FrameDecoder::reset();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: abortFrame
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void abortFrame (FrameStatus status, const FrameCallback &onFrame)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Called by a subclass when the current frame cannot be decoded. Whatever was collected is handed
+-- to the callback with the given status so it is still visible, then a new frame is started.
+--------------------------------------------------------------------------------------------------*/
+void FrameDecoder::abortFrame(FrameStatus status, const FrameCallback &onFrame)
+{
+	onFrame(mFrame, mLength, status);
+	FrameDecoder::reset();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: SlipDecoder
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: SlipDecoder ()
+--
+-- NOTES:
+-- Decoder for RFC 1055 Serial Line IP framing. Frames end with 0xC0 and 0xC0/0xDB inside a frame
+-- are escaped as 0xDB 0xDC and 0xDB 0xDD.
+--------------------------------------------------------------------------------------------------*/
+SlipDecoder::SlipDecoder()
+	: mEscaped(false)
+	, mMalformed(false)
+{
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: SlipDecoder::name
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QString name (void) const
+--
+-- RETURNS: QString - the name shown in the Framing menu and frame rows.
+--------------------------------------------------------------------------------------------------*/
+QString SlipDecoder::name() const
+{
+	return "SLIP";
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: SlipDecoder::reset
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void reset (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Discards any partially received frame and returns to the start-of-frame state.
+--------------------------------------------------------------------------------------------------*/
+void SlipDecoder::reset()
+{
+	FrameDecoder::reset();
+	mEscaped = false;
+	mMalformed = false;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: SlipDecoder::feed
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void feed (const char* data, int size, const FrameCallback &onFrame)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Empty frames (back to back END bytes, which senders use to flush line noise) are skipped. An
+-- escape byte followed by anything other than ESC_END or ESC_ESC marks the frame as malformed.
+--------------------------------------------------------------------------------------------------*/
+void SlipDecoder::feed(const char* data, int size, const FrameCallback &onFrame)
+{
+	for (int i = 0; i < size; i++)
+	{
+		unsigned char c = static_cast<unsigned char>(data[i]);
+
+		if (c == END)
+		{
+			if (mMalformed || mEscaped)
+			{
+				abortFrame(FrameMalformed, onFrame);
+			}
+			else if (!frameEmpty())
+			{
+				finishFrame(onFrame);
+			}
+			mEscaped = false;
+			mMalformed = false;
+		}
+		else if (mEscaped)
+		{
+			mEscaped = false;
+			if (c == ESC_END)
+			{
+				push(static_cast<char>(END));
+			}
+			else if (c == ESC_ESC)
+			{
+				push(static_cast<char>(ESC));
+			}
+			else
+			{
+				mMalformed = true;
+				push(static_cast<char>(c));
+			}
+		}
+		else if (c == ESC)
+		{
+			mEscaped = true;
+		}
+		else
+		{
+			push(static_cast<char>(c));
+		}
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: CobsDecoder
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: CobsDecoder ()
+--
+-- NOTES:
+-- Decoder for Consistent Overhead Byte Stuffing. Frames are delimited by 0x00 and each block of
+-- the frame starts with a code byte giving the distance to the next zero.
+--------------------------------------------------------------------------------------------------*/
+CobsDecoder::CobsDecoder()
+	: mBlockRemaining(0)
+	, mPendingZero(false)
+	, mStarted(false)
+{
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: CobsDecoder::name
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QString name (void) const
+--
+-- RETURNS: QString - the name shown in the Framing menu and frame rows.
+--------------------------------------------------------------------------------------------------*/
+QString CobsDecoder::name() const
+{
+	return "COBS";
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: CobsDecoder::reset
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void reset (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Discards any partially received frame and returns to the start-of-frame state.
+--------------------------------------------------------------------------------------------------*/
+void CobsDecoder::reset()
+{
+	FrameDecoder::reset();
+	mBlockRemaining = 0;
+	mPendingZero = false;
+	mStarted = false;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: CobsDecoder::feed
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void feed (const char* data, int size, const FrameCallback &onFrame)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- A code byte n means n - 1 data bytes follow and, unless n is 0xFF, a zero comes after them. The
+-- zero implied by the last block of a frame is not part of the data, so zeros are only written
+-- once the next code byte shows that another block follows.
+--
+-- A delimiter that arrives in the middle of a block means bytes were lost, and the frame is
+-- reported as malformed.
+--------------------------------------------------------------------------------------------------*/
+void CobsDecoder::feed(const char* data, int size, const FrameCallback &onFrame)
+{
+	for (int i = 0; i < size; i++)
+	{
+		unsigned char c = static_cast<unsigned char>(data[i]);
+
+		if (c == 0)
+		{
+			if (mBlockRemaining != 0)
+			{
+				abortFrame(FrameMalformed, onFrame);
+			}
+			else if (mStarted)
+			{
+				finishFrame(onFrame);
+			}
+			mBlockRemaining = 0;
+			mPendingZero = false;
+			mStarted = false;
+		}
+		else if (mBlockRemaining == 0)
+		{
+			if (mPendingZero)
+			{
+				push('\0');
+			}
+			mBlockRemaining = c - 1;
+			mPendingZero = (c != 0xFF);
+			mStarted = true;
+		}
+		else
+		{
+			push(static_cast<char>(c));
+			mBlockRemaining--;
+		}
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: LengthPrefixDecoder
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: LengthPrefixDecoder (int headerSize, bool bigEndian)
+--
+-- NOTES:
+-- Decoder for frames that start with a 1, 2 or 4 byte unsigned length of the payload that follows.
+--------------------------------------------------------------------------------------------------*/
+LengthPrefixDecoder::LengthPrefixDecoder(int headerSize, bool bigEndian)
+	: mHeaderSize(headerSize)
+	, mBigEndian(bigEndian)
+	, mHeaderRead(0)
+	, mBodyLength(0)
+	, mBodyRead(0)
+{
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: LengthPrefixDecoder::name
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QString name (void) const
+--
+-- RETURNS: QString - the name shown in the Framing menu and frame rows.
+--------------------------------------------------------------------------------------------------*/
+QString LengthPrefixDecoder::name() const
+{
+	return QString("Length (%1 byte%2%3)")
+		.arg(mHeaderSize)
+		.arg(mHeaderSize > 1 ? "s" : "")
+		.arg(mHeaderSize > 1 ? (mBigEndian ? ", big endian" : ", little endian") : "");
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: LengthPrefixDecoder::reset
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void reset (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Discards any partially received frame and returns to the start-of-frame state.
+--------------------------------------------------------------------------------------------------*/
+void LengthPrefixDecoder::reset()
+{
+	FrameDecoder::reset();
+	mHeaderRead = 0;
+	mBodyLength = 0;
+	mBodyRead = 0;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: LengthPrefixDecoder::feed
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void feed (const char* data, int size, const FrameCallback &onFrame)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- The header is accumulated one byte at a time so it may be split across chunks. Payloads longer
+-- than the frame buffer are still consumed in full so the decoder stays in step with the sender,
+-- then reported as FrameOverflow.
+--------------------------------------------------------------------------------------------------*/
+void LengthPrefixDecoder::feed(const char* data, int size, const FrameCallback &onFrame)
+{
+	int i = 0;
+	while (i < size)
+	{
+		if (mHeaderRead < mHeaderSize)
+		{
+			quint32 b = static_cast<unsigned char>(data[i++]);
+			if (mBigEndian)
+			{
+				mBodyLength = (mBodyLength << 8) | b;
+			}
+			else
+			{
+				mBodyLength |= b << (8 * mHeaderRead);
+			}
+			mHeaderRead++;
+		}
+		else
+		{
+			quint32 take = qMin(mBodyLength - mBodyRead, static_cast<quint32>(size - i));
+			for (quint32 n = 0; n < take; n++)
+			{
+				push(data[i++]);
+			}
+			mBodyRead += take;
+		}
+
+		if (mHeaderRead == mHeaderSize && mBodyRead == mBodyLength)
+		{
+			finishFrame(onFrame);
+			mHeaderRead = 0;
+			mBodyLength = 0;
+			mBodyRead = 0;
+		}
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: DelimiterDecoder
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Build the KMP failure table of the delimiter.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: DelimiterDecoder (const QByteArray &delimiter)
+--
+-- NOTES:
+-- Decoder for frames terminated by a fixed byte sequence such as "\r\n". The delimiter is not
+-- part of the delivered frame.
+--
+-- mFailure[i] is the length of the longest proper prefix of the delimiter that is also a suffix of
+-- its first i + 1 bytes, as in LatencyTracker::setTerminator.
+--------------------------------------------------------------------------------------------------*/
+DelimiterDecoder::DelimiterDecoder(const QByteArray &delimiter)
+	: mDelimiter(delimiter.isEmpty() ? QByteArray("\n") : delimiter)
+	, mFailure(mDelimiter.size(), 0)
+	, mMatched(0)
+{
+	int k = 0;
+	for (int i = 1; i < mDelimiter.size(); i++)
+	{
+		while (k > 0 && mDelimiter[i] != mDelimiter[k])
+		{
+			k = mFailure[k - 1];
+		}
+		if (mDelimiter[i] == mDelimiter[k])
+		{
+			k++;
+		}
+		mFailure[i] = k;
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: DelimiterDecoder::name
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QString name (void) const
+--
+-- RETURNS: QString - the name shown in the Framing menu and frame rows.
+--------------------------------------------------------------------------------------------------*/
+QString DelimiterDecoder::name() const
+{
+	return QString("Delimiter (%1)").arg(QString(mDelimiter.toHex()));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: DelimiterDecoder::reset
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void reset (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Discards any partially received frame and returns to the start-of-frame state.
+--------------------------------------------------------------------------------------------------*/
+void DelimiterDecoder::reset()
+{
+	FrameDecoder::reset();
+	mMatched = 0;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: DelimiterDecoder::feed
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Fall back through the failure table on a mismatch so delimiters that overlap
+--     themselves, e.g. "aab" in "aaab", are still found.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void feed (const char* data, int size, const FrameCallback &onFrame)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Tracks how much of the delimiter has been matched so a delimiter split across two chunks is
+-- still found. When a partial match fails, it falls back to the longest prefix of the delimiter
+-- that still ends at this byte. The matched bytes in front of that prefix were payload after all
+-- and are written to the frame before the current byte is tested again.
+--------------------------------------------------------------------------------------------------*/
+void DelimiterDecoder::feed(const char* data, int size, const FrameCallback &onFrame)
+{
+	const char* delimiter = mDelimiter.constData();
+	const int delimiterSize = mDelimiter.size();
+	const int* failure = mFailure.constData();
+
+	for (int i = 0; i < size; i++)
+	{
+		char c = data[i];
+
+		while (mMatched > 0 && c != delimiter[mMatched])
+		{
+			int fallback = failure[mMatched - 1];
+			for (int n = 0; n < mMatched - fallback; n++)
+			{
+				push(delimiter[n]);
+			}
+			mMatched = fallback;
+		}
+
+		if (c == delimiter[mMatched])
+		{
+			if (++mMatched == delimiterSize)
+			{
+				finishFrame(onFrame);
+				mMatched = 0;
+			}
+		}
+		else
+		{
+			push(c);
+		}
+	}
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <functional>
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+class FrameDecoder
+{
+public:
+	enum FrameStatus
+	{
+		FrameOk,
+		FrameCrcError,
+		FrameOverflow,
+		FrameMalformed
+	};
+
+	typedef std::function<void(const char* data, int length, FrameStatus status)> FrameCallback;
+
+	static const int MAX_FRAME_SIZE = 65536;
+
+	virtual ~FrameDecoder();
+
+	virtual QString name() const = 0;
+	virtual void feed(const char* data, int size, const FrameCallback &onFrame) = 0;
+	virtual void reset();
+
+	void setCrcCheck(bool enabled);
+	bool crcCheck() const;
+
+	static quint16 crc16(const char* data, int length);
+
+protected:
+	explicit FrameDecoder(int maxFrameSize = MAX_FRAME_SIZE);
+
+	inline void push(char c)
+	{
+		if (mLength < mCapacity)
+		{
+			mFrame[mLength++] = c;
+		}
+		else
+		{
+			mOverflow = true;
+		}
+	}
+
+	inline bool frameEmpty() const
+	{
+		return mLength == 0 && !mOverflow;
+	}
+
+	void finishFrame(const FrameCallback &onFrame);
+	void abortFrame(FrameStatus status, const FrameCallback &onFrame);
+
+private:
+	QByteArray mBuffer;
+	char* mFrame;
+	int mCapacity;
+	int mLength;
+	bool mOverflow;
+	bool mCrcCheck;
+};
+
+class SlipDecoder
+	: public FrameDecoder
+{
+public:
+	SlipDecoder();
+
+	QString name() const Q_DECL_OVERRIDE;
+	void feed(const char* data, int size, const FrameCallback &onFrame) Q_DECL_OVERRIDE;
+	void reset() Q_DECL_OVERRIDE;
+
+private:
+	static const unsigned char END = 0xC0;
+	static const unsigned char ESC = 0xDB;
+	static const unsigned char ESC_END = 0xDC;
+	static const unsigned char ESC_ESC = 0xDD;
+
+	bool mEscaped;
+	bool mMalformed;
+};
+
+class CobsDecoder
+	: public FrameDecoder
+{
+public:
+	CobsDecoder();
+
+	QString name() const Q_DECL_OVERRIDE;
+	void feed(const char* data, int size, const FrameCallback &onFrame) Q_DECL_OVERRIDE;
+	void reset() Q_DECL_OVERRIDE;
+
+private:
+	int mBlockRemaining;
+	bool mPendingZero;
+	bool mStarted;
+};
+
+class LengthPrefixDecoder
+	: public FrameDecoder
+{
+public:
+	LengthPrefixDecoder(int headerSize, bool bigEndian);
+
+	QString name() const Q_DECL_OVERRIDE;
+	void feed(const char* data, int size, const FrameCallback &onFrame) Q_DECL_OVERRIDE;
+	void reset() Q_DECL_OVERRIDE;
+
+private:
+	int mHeaderSize;
+	bool mBigEndian;
+
+	int mHeaderRead;
+	quint32 mBodyLength;
+	quint32 mBodyRead;
+};
+
+class DelimiterDecoder
+	: public FrameDecoder
+{
+public:
+	explicit DelimiterDecoder(const QByteArray &delimiter);
+
+	QString name() const Q_DECL_OVERRIDE;
+	void feed(const char* data, int size, const FrameCallback &onFrame) Q_DECL_OVERRIDE;
+	void reset() Q_DECL_OVERRIDE;
+
+private:
+	QByteArray mDelimiter;
+	QVector<int> mFailure;
+	int mMatched;
+};
@@ -0,0 +1,103 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: FrameFormat.cpp - Turns decoded frames into rows of text.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- QString frameStatusName(FrameDecoder::FrameStatus status);
+-- QString formatFrameRow(const char* data, int length, FrameDecoder::FrameStatus status,
+--                        const QTime &time, int maxBytes);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- Kept apart from Console so the text of a frame row can be produced, measured and benchmarked
+-- without a widget.
+--------------------------------------------------------------------------------------------------*/
+#include <QByteArray>
+
+#include "FrameFormat.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: frameStatusName
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QString frameStatusName (FrameDecoder::FrameStatus status)
+--
+-- RETURNS: QString - the text shown for status in a frame row.
+--------------------------------------------------------------------------------------------------*/
+QString frameStatusName(FrameDecoder::FrameStatus status)
+{
+	switch (status)
+	{
+	case FrameDecoder::FrameOk:
+		return "ok";
+	case FrameDecoder::FrameCrcError:
+		return "CRC ERROR";
+	case FrameDecoder::FrameOverflow:
+		return "OVERFLOW";
+	case FrameDecoder::FrameMalformed:
+		return "MALFORMED";
+	}
+	return QString();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: formatFrameRow
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QString formatFrameRow (const char* data, int length, FrameDecoder::FrameStatus status,
+--                                    const QTime &time, int maxBytes)
+--
+-- RETURNS: QString - the row for the frame.
+--
+-- NOTES:
+-- Builds one row of the form
+--
+--     [14:02:11.350] len=5 ok | 48 65 6c 6c 6f | Hello
+--
+-- holding the time, the payload length, the status, a hex dump and the printable characters.
+-- Only the first maxBytes bytes are dumped; a longer frame is marked with "...".
+--------------------------------------------------------------------------------------------------*/
+QString formatFrameRow(const char* data, int length, FrameDecoder::FrameStatus status, const QTime &time,
+	int maxBytes)
+{
+	int shown = qMin(length, maxBytes);
+	QByteArray bytes = QByteArray::fromRawData(data, shown);
+
+	QString text;
+	text.reserve(shown);
+	for (int i = 0; i < shown; i++)
+	{
+		char c = data[i];
+		text.append((c >= 0x20 && c < 0x7F) ? QChar(c) : QChar('.'));
+	}
+
+	return QString("[%1] len=%2 %3 | %4%5 | %6")
+		.arg(time.toString("HH:mm:ss.zzz"))
+		.arg(length)
+		.arg(frameStatusName(status))
+		.arg(QString(bytes.toHex(' ')))
+		.arg(shown < length ? " ..." : "")
+		.arg(text);
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <QString>
+#include <QTime>
+
+#include "FrameDecoder.h"
+
+QString frameStatusName(FrameDecoder::FrameStatus status);
+QString formatFrameRow(const char* data, int length, FrameDecoder::FrameStatus status, const QTime &time,
+	int maxBytes);
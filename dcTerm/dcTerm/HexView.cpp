@@ -0,0 +1,375 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: HexView.cpp - A hex dump of the received bytes.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- qint64 topOffset() const;
+-- bool isAtEnd() const;
+--
+-- void scrollToOffset(qint64 offset);
+-- void scrollToEnd();
+--
+-- void refresh();
+--
+-- int visibleRows() const;
+-- void updateScrollBar();
+--
+-- void paintEvent(QPaintEvent* e);
+-- void resizeEvent(QResizeEvent* e);
+-- void showEvent(QShowEvent* e);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- The hex pane shown beside the console. Each row is the stream offset, BYTES_PER_ROW bytes in
+-- hex and the same bytes as characters:
+--
+--     0000a3f0  48 65 6c 6c 6f 0d 0a 00  ff 10 20 30 41 42 43 44  Hello.......ABCD
+--
+-- The view keeps no copy of the traffic. It draws straight from the session's ByteStore and only
+-- reads the rows on screen each time it paints, so it costs the same whether the store holds a
+-- kilobyte or a megabyte.
+--
+-- Rows are aligned to stream offsets, so a row keeps its place as the oldest bytes are dropped.
+-- The scroll bar counts rows from the oldest row kept; refresh() shifts its value as that row
+-- moves so the rows on screen stay put. While scrolled to the bottom the view follows new data.
+--------------------------------------------------------------------------------------------------*/
+#include <QFontDatabase>
+#include <QPainter>
+#include <QScrollBar>
+
+#include "HexView.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: HexView (const ByteStore*, QWidget*)
+--
+-- NOTES:
+-- Constructor for a view of store, coloured like the console and drawn in a fixed width font.
+--------------------------------------------------------------------------------------------------*/
+HexView::HexView(const ByteStore* store, QWidget* parent)
+	: QAbstractScrollArea(parent)
+	, mStore(store)
+	, mBeginRow(0)
+{
+	setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+	QPalette p = viewport()->palette();
+	p.setColor(QPalette::Window, Qt::black);
+	p.setColor(QPalette::WindowText, Qt::green);
+	viewport()->setPalette(p);
+	viewport()->setAutoFillBackground(true);
+
+	setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+	connect(verticalScrollBar(), &QScrollBar::valueChanged, this, [this]()
+	{
+		viewport()->update();
+		emit scrolled(topOffset());
+	});
+
+	mVisible.reserve(BYTES_PER_ROW * 128);
+	updateScrollBar();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: topOffset
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 topOffset (void) const
+--
+-- RETURNS: qint64 - the stream offset of the first byte of the top row.
+--------------------------------------------------------------------------------------------------*/
+qint64 HexView::topOffset() const
+{
+	return (mBeginRow + verticalScrollBar()->value()) * BYTES_PER_ROW;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: isAtEnd
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool isAtEnd (void) const
+--
+-- RETURNS: bool - true if the view is scrolled to the bottom and following new data.
+--------------------------------------------------------------------------------------------------*/
+bool HexView::isAtEnd() const
+{
+	return verticalScrollBar()->value() == verticalScrollBar()->maximum();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: scrollToOffset
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void scrollToOffset (qint64 offset)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Scrolls so the row holding offset is at the top, or as near as the scroll range allows.
+--------------------------------------------------------------------------------------------------*/
+void HexView::scrollToOffset(qint64 offset)
+{
+	verticalScrollBar()->setValue(static_cast<int>(offset / BYTES_PER_ROW - mBeginRow));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: scrollToEnd
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void scrollToEnd (void)
+--
+-- RETURNS: void.
+--------------------------------------------------------------------------------------------------*/
+void HexView::scrollToEnd()
+{
+	verticalScrollBar()->setValue(verticalScrollBar()->maximum());
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: refresh
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void refresh (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is called when data has been added to the store.
+--
+-- Updates the scroll range and schedules a repaint. Nothing is read from the store until the
+-- paint, which Qt runs at most once per frame however often data arrives, and nothing at all
+-- while the pane is hidden.
+--------------------------------------------------------------------------------------------------*/
+void HexView::refresh()
+{
+	if (isVisible())
+	{
+		updateScrollBar();
+		viewport()->update();
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: visibleRows
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int visibleRows (void) const
+--
+-- RETURNS: int - the number of whole rows that fit in the viewport.
+--------------------------------------------------------------------------------------------------*/
+int HexView::visibleRows() const
+{
+	return qMax(1, viewport()->height() / fontMetrics().height());
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: updateScrollBar
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void updateScrollBar (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Sets the scroll range to the rows in the store. If the oldest row has moved since the last
+-- update the value is shifted by the same amount, keeping the same rows on screen, unless the
+-- view was at the bottom, in which case it stays at the bottom.
+--------------------------------------------------------------------------------------------------*/
+void HexView::updateScrollBar()
+{
+	QScrollBar* bar = verticalScrollBar();
+	bool atEnd = isAtEnd();
+
+	qint64 beginRow = mStore->begin() / BYTES_PER_ROW;
+	qint64 endRow = (mStore->end() + BYTES_PER_ROW - 1) / BYTES_PER_ROW;
+	int value = static_cast<int>(bar->value() - (beginRow - mBeginRow));
+	mBeginRow = beginRow;
+
+	bool blocked = bar->blockSignals(true);
+	bar->setRange(0, static_cast<int>(qMax<qint64>(0, endRow - beginRow - visibleRows())));
+	bar->setPageStep(visibleRows());
+	bar->setValue(atEnd ? bar->maximum() : value);
+	bar->blockSignals(blocked);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: paintEvent
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void paintEvent (QPaintEvent* e)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Reads the visible rows from the store in one copy and draws them a row at a time. The buffers
+-- are members so painting does not allocate once they have grown to the viewport's size.
+--------------------------------------------------------------------------------------------------*/
+void HexView::paintEvent(QPaintEvent* e)
+{
+	Q_UNUSED(e);
+	static const char digits[] = "0123456789abcdef";
+
+	QPainter painter(viewport());
+	painter.setPen(viewport()->palette().color(QPalette::WindowText));
+
+	int line = fontMetrics().height();
+	int rows = visibleRows() + 1;
+	qint64 top = qMax(topOffset(), mStore->begin());
+
+	mVisible.resize(rows * BYTES_PER_ROW);
+	int size = mStore->read(top, mVisible.data(), mVisible.size());
+
+	for (int row = 0; row * BYTES_PER_ROW < size; row++)
+	{
+		const uchar* bytes = reinterpret_cast<const uchar*>(mVisible.constData()) + row * BYTES_PER_ROW;
+		int count = qMin(BYTES_PER_ROW, size - row * BYTES_PER_ROW);
+
+		mRow = QString("%1  ").arg(top + row * BYTES_PER_ROW, 8, 16, QChar('0'));
+		for (int i = 0; i < BYTES_PER_ROW; i++)
+		{
+			if (i < count)
+			{
+				mRow += QChar(digits[bytes[i] >> 4]);
+				mRow += QChar(digits[bytes[i] & 0x0f]);
+				mRow += QChar(' ');
+			}
+			else
+			{
+				mRow += QLatin1String("   ");
+			}
+			if (i == BYTES_PER_ROW / 2 - 1)
+			{
+				mRow += QChar(' ');
+			}
+		}
+		mRow += QChar(' ');
+		for (int i = 0; i < count; i++)
+		{
+			mRow += (bytes[i] >= 0x20 && bytes[i] < 0x7f) ? QChar(bytes[i]) : QChar('.');
+		}
+
+		painter.drawText(4, line * (row + 1) - fontMetrics().descent(), mRow);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: resizeEvent
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void resizeEvent (QResizeEvent* e)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- The number of visible rows changes with the height, and with it the scroll range.
+--------------------------------------------------------------------------------------------------*/
+void HexView::resizeEvent(QResizeEvent* e)
+{
+	QAbstractScrollArea::resizeEvent(e);
+	updateScrollBar();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: showEvent
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void showEvent (QShowEvent* e)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- refresh() does nothing while the pane is hidden, so the scroll range is brought up to date when
+-- it is shown again.
+--------------------------------------------------------------------------------------------------*/
+void HexView::showEvent(QShowEvent* e)
+{
+	QAbstractScrollArea::showEvent(e);
+	updateScrollBar();
+}
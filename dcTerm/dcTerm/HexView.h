@@ -0,0 +1,43 @@
+#pragma once
+
+#include <QAbstractScrollArea>
+#include <QByteArray>
+
+#include "ByteStore.h"
+
+class HexView
+	: public QAbstractScrollArea
+{
+	Q_OBJECT
+
+public:
+	static const int BYTES_PER_ROW = 16;
+
+	explicit HexView(const ByteStore* store, QWidget *parent = nullptr);
+
+	qint64 topOffset() const;
+	bool isAtEnd() const;
+
+	void scrollToOffset(qint64 offset);
+	void scrollToEnd();
+
+public slots:
+	void refresh();
+
+private:
+	const ByteStore* mStore;
+	qint64 mBeginRow;
+	QByteArray mVisible;
+	QString mRow;
+
+	int visibleRows() const;
+	void updateScrollBar();
+
+protected:
+	void paintEvent(QPaintEvent* e) Q_DECL_OVERRIDE;
+	void resizeEvent(QResizeEvent* e) Q_DECL_OVERRIDE;
+	void showEvent(QShowEvent* e) Q_DECL_OVERRIDE;
+
+signals:
+	void scrolled(qint64 offset);
+};
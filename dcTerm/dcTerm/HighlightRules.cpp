@@ -0,0 +1,281 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: HighlightRules.cpp - Finds the parts of a line that should stand out.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- bool loadRules(const QString &path, QString* error);
+-- void setRules(const QVector<HighlightRule> &rules);
+-- const QVector<HighlightRule> &rules() const;
+-- bool isEmpty() const;
+--
+-- void match(const QString &line, QVector<HighlightSpan> &spans) const;
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Match each rule with its own expression instead of joining them.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- A highlight rule pairs a regular expression with a text style, e.g. errors in bold red and
+-- warnings in yellow, so problems stand out in a device's log as it scrolls by.
+--
+-- As with trigger rules, every pattern is compiled on its own and run over the line, so each keeps
+-- its own group numbering for backreferences and a rule that compiles alone always works. Lines
+-- are styled one at a time as they arrive and the result is cached, so the extra pass per rule
+-- costs little. Rules may match overlapping text; where they do, the style of the rule listed
+-- first is the one shown.
+--
+-- Rules are read from a text file with one rule per line and tab separated fields:
+--
+--     <regex> <TAB> <style>
+--
+-- where style is a space separated list of words: bold, italic, underline, bg=<color> for the
+-- background and any other word for the text color. Colors are names or #rrggbb. Blank lines and
+-- lines starting with # are ignored, e.g.
+--
+--     \b(ERROR|FATAL)\b.*     red bold
+--     \bWARN(ING)?\b          yellow
+--     panic                   white bg=#800000
+--------------------------------------------------------------------------------------------------*/
+#include <QFile>
+#include <QStringList>
+#include <QTextStream>
+
+#include "HighlightRules.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: HighlightRules ()
+--
+-- NOTES:
+-- Constructor for an empty set of rules.
+--------------------------------------------------------------------------------------------------*/
+HighlightRules::HighlightRules()
+{
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: loadRules
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Use Qt::SkipEmptyParts on Qt 5.14 and later, where the QString one is
+--     deprecated.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool loadRules (const QString &path, QString* error)
+--
+-- RETURNS: bool - true if every rule in the file was valid and the rules were replaced.
+--
+-- NOTES:
+-- Reads a rule file. If any line is invalid the current rules are kept and error describes the
+-- first bad line.
+--------------------------------------------------------------------------------------------------*/
+bool HighlightRules::loadRules(const QString &path, QString* error)
+{
+	QFile file(path);
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		*error = file.errorString();
+		return false;
+	}
+
+	QVector<HighlightRule> rules;
+	QTextStream in(&file);
+	int lineNumber = 0;
+
+	while (!in.atEnd())
+	{
+		QString line = in.readLine();
+		lineNumber++;
+
+		if (line.trimmed().isEmpty() || line.trimmed().startsWith('#'))
+		{
+			continue;
+		}
+
+		int tab = line.indexOf('\t');
+		if (tab < 0)
+		{
+			*error = QString("Line %1: expected a pattern and a style separated by a tab.").arg(lineNumber);
+			return false;
+		}
+
+		HighlightRule rule = { line.left(tab), QString(), QString(), false, false, false };
+		QRegularExpression check(rule.pattern);
+		if (!check.isValid())
+		{
+			*error = QString("Line %1: %2").arg(lineNumber).arg(check.errorString());
+			return false;
+		}
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+		const QStringList words = line.mid(tab + 1).split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
+#else
+		const QStringList words = line.mid(tab + 1).split(QRegularExpression("\\s+"), QString::SkipEmptyParts);
+#endif
+		for (const QString &word : words)
+		{
+			if (word == "bold")
+			{
+				rule.bold = true;
+			}
+			else if (word == "italic")
+			{
+				rule.italic = true;
+			}
+			else if (word == "underline")
+			{
+				rule.underline = true;
+			}
+			else if (word.startsWith("bg="))
+			{
+				rule.background = word.mid(3);
+			}
+			else
+			{
+				rule.foreground = word;
+			}
+		}
+
+		rules.append(rule);
+	}
+
+	setRules(rules);
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setRules
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Compile each rule separately instead of joining them.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setRules (const QVector<HighlightRule> &rules)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Replaces the rules and compiles and optimizes each one on its own.
+--------------------------------------------------------------------------------------------------*/
+void HighlightRules::setRules(const QVector<HighlightRule> &rules)
+{
+	mRules = rules;
+	mRegexes.clear();
+
+	for (int i = 0; i < mRules.size(); i++)
+	{
+		QRegularExpression regex(mRules[i].pattern);
+		regex.optimize();
+		mRegexes.append(regex);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: rules
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: const QVector<HighlightRule> &rules (void) const
+--
+-- RETURNS: const QVector<HighlightRule>& - the rules, indexed by HighlightSpan::rule.
+--------------------------------------------------------------------------------------------------*/
+const QVector<HighlightRule> &HighlightRules::rules() const
+{
+	return mRules;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: isEmpty
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool isEmpty (void) const
+--
+-- RETURNS: bool - true if there are no rules, in which case match() need not be called.
+--------------------------------------------------------------------------------------------------*/
+bool HighlightRules::isEmpty() const
+{
+	return mRules.isEmpty();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: match
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Run every rule over the line, so matches of different rules may overlap.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void match (const QString &line, QVector<HighlightSpan> &spans) const
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Replaces spans with the parts of line to style. Spans are grouped by rule, the last rule first,
+-- so when they are applied in order the first rule's style ends up on top where matches overlap.
+-- Empty matches are skipped. An invalid pattern, which only setRules() could let in, matches
+-- nothing.
+--------------------------------------------------------------------------------------------------*/
+void HighlightRules::match(const QString &line, QVector<HighlightSpan> &spans) const
+{
+	spans.resize(0);
+	if (mRules.isEmpty() || line.isEmpty())
+	{
+		return;
+	}
+
+	for (int n = mRegexes.size() - 1; n >= 0; n--)
+	{
+		QRegularExpressionMatchIterator it = mRegexes[n].globalMatch(line);
+		while (it.hasNext())
+		{
+			QRegularExpressionMatch hit = it.next();
+			if (hit.capturedLength() > 0)
+			{
+				HighlightSpan span = { n, hit.capturedStart(), hit.capturedLength() };
+				spans.append(span);
+			}
+		}
+	}
+}
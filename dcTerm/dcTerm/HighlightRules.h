@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QRegularExpression>
+#include <QString>
+#include <QVector>
+
+struct HighlightRule
+{
+	QString pattern;
+	QString foreground;
+	QString background;
+	bool bold;
+	bool italic;
+	bool underline;
+};
+
+struct HighlightSpan
+{
+	int rule;
+	int start;
+	int length;
+};
+
+class HighlightRules
+{
+public:
+	HighlightRules();
+
+	bool loadRules(const QString &path, QString* error);
+	void setRules(const QVector<HighlightRule> &rules);
+	const QVector<HighlightRule> &rules() const;
+	bool isEmpty() const;
+
+	void match(const QString &line, QVector<HighlightSpan> &spans) const;
+
+private:
+	QVector<HighlightRule> mRules;
+
+	QVector<QRegularExpression> mRegexes;
+};
@@ -0,0 +1,795 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: LatencyTracker.cpp - Measures how long a device takes to answer a request.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- void setTerminator(const QByteArray &terminator);
+-- const QByteArray &terminator() const;
+-- void setTimeout(qint64 timeout);
+-- qint64 timeout() const;
+--
+-- void clear();
+-- void sent(qint64 timestamp, const char* data, int size);
+-- void received(qint64 timestamp, const char* data, int size);
+--
+-- quint64 count() const;
+-- quint64 timeouts() const;
+-- int pending() const;
+-- qint64 minimum() const;
+-- qint64 maximum() const;
+-- double mean() const;
+-- qint64 percentile(double percent) const;
+--
+-- quint64 recentCount(qint64 now) const;
+-- qint64 recentPercentile(double percent, qint64 now) const;
+--
+-- bool writeCsv(QIODevice* device) const;
+--
+-- void expire(qint64 timestamp);
+-- void complete(qint64 timestamp);
+-- bool isRecent(int window, qint64 now) const;
+-- quint64 rank(double percent, quint64 count);
+-- int bucket(qint64 value);
+-- qint64 bucketHighest(int bucket);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Keeps a histogram of recent answers alongside the one for the whole run.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- A request is any write that holds a line ending, so a typed line counts when Enter is pressed
+-- and a script or trigger counts with each line it sends. Its answer is the first received byte
+-- after it or, if a terminator is set, the end of the first terminator after it, e.g. "OK\r\n".
+-- Requests sent before the previous one was answered wait in order, each answer going to the
+-- oldest. A request left unanswered for longer than the timeout is counted as a timeout instead.
+--
+-- Times are in microseconds, as given by CaptureFile::now(). Bytes are only timestamped when the
+-- port hands over a read, so an answer is timed at the read it arrived in.
+--
+-- Latencies are counted in a log-linear histogram in the manner of HdrHistogram. Values under
+-- 2 * SUB_BUCKETS us each have a bucket of their own; above that every power of two is split into
+-- SUB_BUCKETS buckets, so any value is known to within 1 / SUB_BUCKETS (about 3%) at any scale.
+-- The histogram is a fixed 8 KB however many requests are made, and any percentile can be read
+-- from it at any time.
+--
+-- That histogram covers the whole run, so after hours of traffic a device that has just slowed
+-- down barely moves its percentiles. Two more histograms of the same kind take turns holding
+-- WINDOW_INTERVAL of answers each: when an answer comes in after the current one's interval is
+-- over, the older one is emptied and becomes the current one. Together they always hold between
+-- one and two intervals of the most recent answers, 10 to 20 s by default, and recentPercentile()
+-- reads them as one. An interval that ended more than an interval ago is left out, so a device
+-- that stops answering has no recent figures rather than stale ones.
+--------------------------------------------------------------------------------------------------*/
+#include <QtAlgorithms>
+#include <cmath>
+#include <cstring>
+
+#include "LatencyTracker.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: LatencyTracker ()
+--
+-- NOTES:
+-- Constructor for an empty tracker that times the first byte of each answer.
+--------------------------------------------------------------------------------------------------*/
+LatencyTracker::LatencyTracker()
+	: mMatched(0)
+	, mTimeout(DEFAULT_TIMEOUT)
+	, mCounts(BUCKET_COUNT, 0)
+{
+	mWindowCounts[0].fill(0, BUCKET_COUNT);
+	mWindowCounts[1].fill(0, BUCKET_COUNT);
+	clear();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setTerminator
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setTerminator (const QByteArray &terminator)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Sets the bytes that end an answer; empty times the first byte of the answer. The terminator is
+-- searched for with the Knuth-Morris-Pratt failure table so a match split across reads, or one
+-- that starts inside a false start, is still found.
+--------------------------------------------------------------------------------------------------*/
+void LatencyTracker::setTerminator(const QByteArray &terminator)
+{
+	mTerminator = terminator;
+	mFailure.fill(0, terminator.size());
+	mMatched = 0;
+
+	int k = 0;
+	for (int i = 1; i < terminator.size(); i++)
+	{
+		while (k > 0 && terminator[i] != terminator[k])
+		{
+			k = mFailure[k - 1];
+		}
+		if (terminator[i] == terminator[k])
+		{
+			k++;
+		}
+		mFailure[i] = k;
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: terminator
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: const QByteArray &terminator (void) const
+--
+-- RETURNS: const QByteArray & - the bytes that end an answer, empty if the first byte is timed.
+--------------------------------------------------------------------------------------------------*/
+const QByteArray &LatencyTracker::terminator() const
+{
+	return mTerminator;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setTimeout
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setTimeout (qint64 timeout)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Sets how many microseconds a request may wait for its answer before it counts as a timeout.
+--------------------------------------------------------------------------------------------------*/
+void LatencyTracker::setTimeout(qint64 timeout)
+{
+	mTimeout = timeout;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: timeout
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 timeout (void) const
+--
+-- RETURNS: qint64 - the time in microseconds a request may wait for its answer.
+--------------------------------------------------------------------------------------------------*/
+qint64 LatencyTracker::timeout() const
+{
+	return mTimeout;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: clear
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Empties the recent histograms.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void clear (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Forgets every measurement and waiting request. The terminator and timeout are kept.
+--------------------------------------------------------------------------------------------------*/
+void LatencyTracker::clear()
+{
+	for (int i = 0; i < 2; i++)
+	{
+		mWindowCounts[i].fill(0);
+		mWindowCount[i] = 0;
+		mWindowMaximum[i] = 0;
+		mWindowStart[i] = 0;
+	}
+	mWindow = 0;
+
+	mPending.clear();
+	mMatched = 0;
+	mCounts.fill(0);
+	mCount = 0;
+	mTimeouts = 0;
+	mMinimum = 0;
+	mMaximum = 0;
+	mSum = 0;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: sent
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void sent (qint64 timestamp, const char* data, int size)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Called with everything written to the port. Starts a request at timestamp if data holds a line
+-- ending. At most MAX_PENDING requests wait at once; past that the oldest is counted as a timeout.
+--------------------------------------------------------------------------------------------------*/
+void LatencyTracker::sent(qint64 timestamp, const char* data, int size)
+{
+	if (!std::memchr(data, '\r', size) && !std::memchr(data, '\n', size))
+	{
+		return;
+	}
+
+	expire(timestamp);
+	if (mPending.isEmpty())
+	{
+		mMatched = 0;
+	}
+	else if (mPending.size() >= MAX_PENDING)
+	{
+		mPending.dequeue();
+		mTimeouts++;
+	}
+	mPending.enqueue(timestamp);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: received
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void received (qint64 timestamp, const char* data, int size)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Called with everything read from the port. Answers the waiting requests that data completes,
+-- timing each at timestamp. With no request waiting the data is not looked at.
+--------------------------------------------------------------------------------------------------*/
+void LatencyTracker::received(qint64 timestamp, const char* data, int size)
+{
+	expire(timestamp);
+	if (mPending.isEmpty() || size <= 0)
+	{
+		return;
+	}
+
+	if (mTerminator.isEmpty())
+	{
+		complete(timestamp);
+		return;
+	}
+
+	const char* terminator = mTerminator.constData();
+	int length = mTerminator.size();
+	for (int i = 0; i < size && !mPending.isEmpty(); i++)
+	{
+		while (mMatched > 0 && data[i] != terminator[mMatched])
+		{
+			mMatched = mFailure[mMatched - 1];
+		}
+		if (data[i] == terminator[mMatched])
+		{
+			mMatched++;
+		}
+		if (mMatched == length)
+		{
+			complete(timestamp);
+			mMatched = 0;
+		}
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: count
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: quint64 count (void) const
+--
+-- RETURNS: quint64 - the number of requests answered.
+--------------------------------------------------------------------------------------------------*/
+quint64 LatencyTracker::count() const
+{
+	return mCount;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: timeouts
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: quint64 timeouts (void) const
+--
+-- RETURNS: quint64 - the number of requests that were not answered in time.
+--------------------------------------------------------------------------------------------------*/
+quint64 LatencyTracker::timeouts() const
+{
+	return mTimeouts;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: pending
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int pending (void) const
+--
+-- RETURNS: int - the number of requests waiting for an answer.
+--------------------------------------------------------------------------------------------------*/
+int LatencyTracker::pending() const
+{
+	return mPending.size();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: minimum
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 minimum (void) const
+--
+-- RETURNS: qint64 - the shortest latency in microseconds, 0 if nothing has been answered.
+--------------------------------------------------------------------------------------------------*/
+qint64 LatencyTracker::minimum() const
+{
+	return mMinimum;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: maximum
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 maximum (void) const
+--
+-- RETURNS: qint64 - the longest latency in microseconds, 0 if nothing has been answered.
+--------------------------------------------------------------------------------------------------*/
+qint64 LatencyTracker::maximum() const
+{
+	return mMaximum;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: mean
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: double mean (void) const
+--
+-- RETURNS: double - the mean latency in microseconds, 0 if nothing has been answered.
+--------------------------------------------------------------------------------------------------*/
+double LatencyTracker::mean() const
+{
+	return mCount > 0 ? mSum / mCount : 0;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: percentile
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Shares the rank calculation with recentPercentile().
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 percentile (double percent) const
+--
+-- RETURNS: qint64 - the latency in microseconds that percent of answers were at or under, 0 if
+--                   nothing has been answered.
+--
+-- NOTES:
+-- Gives the highest value of the bucket holding the percentile, capped at the maximum seen, so the
+-- result is never below the true value and at most 1 / SUB_BUCKETS above it.
+--------------------------------------------------------------------------------------------------*/
+qint64 LatencyTracker::percentile(double percent) const
+{
+	if (mCount == 0)
+	{
+		return 0;
+	}
+
+	quint64 wanted = rank(percent, mCount);
+	quint64 seen = 0;
+	for (int i = 0; i < BUCKET_COUNT; i++)
+	{
+		seen += mCounts[i];
+		if (seen >= wanted)
+		{
+			return qMin(bucketHighest(i), mMaximum);
+		}
+	}
+	return mMaximum;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: recentCount
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: quint64 recentCount (qint64 now) const
+--
+-- RETURNS: quint64 - the answers in the recent histograms as of now.
+--------------------------------------------------------------------------------------------------*/
+quint64 LatencyTracker::recentCount(qint64 now) const
+{
+	quint64 count = 0;
+	for (int i = 0; i < 2; i++)
+	{
+		if (isRecent(i, now))
+		{
+			count += mWindowCount[i];
+		}
+	}
+	return count;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: recentPercentile
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 recentPercentile (double percent, qint64 now) const
+--
+-- RETURNS: qint64 - the latency in microseconds that percent of the recent answers were at or
+--                   under, 0 if nothing has been answered recently.
+--
+-- NOTES:
+-- Reads the recent histograms as one, with the same accuracy as percentile().
+--------------------------------------------------------------------------------------------------*/
+qint64 LatencyTracker::recentPercentile(double percent, qint64 now) const
+{
+	bool recent[2] = { isRecent(0, now), isRecent(1, now) };
+	quint64 count = recentCount(now);
+	if (count == 0)
+	{
+		return 0;
+	}
+
+	qint64 maximum = 0;
+	for (int i = 0; i < 2; i++)
+	{
+		if (recent[i])
+		{
+			maximum = qMax(maximum, mWindowMaximum[i]);
+		}
+	}
+
+	quint64 wanted = rank(percent, count);
+	quint64 seen = 0;
+	for (int i = 0; i < BUCKET_COUNT; i++)
+	{
+		seen += (recent[0] ? mWindowCounts[0][i] : 0) + (recent[1] ? mWindowCounts[1][i] : 0);
+		if (seen >= wanted)
+		{
+			return qMin(bucketHighest(i), maximum);
+		}
+	}
+	return maximum;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: writeCsv
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool writeCsv (QIODevice* device) const
+--
+-- RETURNS: bool - true if everything was written.
+--
+-- NOTES:
+-- Writes the latency distribution as CSV, one row per bucket that holds an answer:
+--
+--     latency_us,count,total_count,percentile
+--     1023,12,40,40.000
+--
+-- latency_us is the highest value of the bucket, count the answers in it, and total_count and
+-- percentile the answers at or under latency_us. Reading down the percentile column to 50, 95 or
+-- 99 gives the same figures as percentile().
+--------------------------------------------------------------------------------------------------*/
+bool LatencyTracker::writeCsv(QIODevice* device) const
+{
+	QByteArray csv("latency_us,count,total_count,percentile\n");
+
+	quint64 seen = 0;
+	for (int i = 0; i < BUCKET_COUNT; i++)
+	{
+		if (mCounts[i] == 0)
+		{
+			continue;
+		}
+		seen += mCounts[i];
+		csv += QByteArray::number(qMin(bucketHighest(i), mMaximum));
+		csv += ',';
+		csv += QByteArray::number(mCounts[i]);
+		csv += ',';
+		csv += QByteArray::number(seen);
+		csv += ',';
+		csv += QByteArray::number(100.0 * seen / mCount, 'f', 3);
+		csv += '\n';
+	}
+
+	return device->write(csv) == csv.size();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: expire
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void expire (qint64 timestamp)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Counts the requests that have waited longer than the timeout at timestamp as timeouts.
+--------------------------------------------------------------------------------------------------*/
+void LatencyTracker::expire(qint64 timestamp)
+{
+	while (!mPending.isEmpty() && timestamp - mPending.head() > mTimeout)
+	{
+		mPending.dequeue();
+		mTimeouts++;
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: complete
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Also counts the latency in the recent histograms.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void complete (qint64 timestamp)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Answers the oldest waiting request at timestamp and adds its latency to the histogram, and to
+-- the current recent histogram after switching to the other one if the current interval is over.
+--------------------------------------------------------------------------------------------------*/
+void LatencyTracker::complete(qint64 timestamp)
+{
+	qint64 latency = qMax<qint64>(0, timestamp - mPending.dequeue());
+
+	mCounts[bucket(latency)]++;
+	mMinimum = mCount == 0 ? latency : qMin(mMinimum, latency);
+	mMaximum = qMax(mMaximum, latency);
+	mSum += latency;
+	mCount++;
+
+	if (timestamp - mWindowStart[mWindow] >= WINDOW_INTERVAL)
+	{
+		mWindow ^= 1;
+		mWindowCounts[mWindow].fill(0);
+		mWindowCount[mWindow] = 0;
+		mWindowMaximum[mWindow] = 0;
+		mWindowStart[mWindow] = timestamp;
+	}
+	mWindowCounts[mWindow][bucket(latency)]++;
+	mWindowCount[mWindow]++;
+	mWindowMaximum[mWindow] = qMax(mWindowMaximum[mWindow], latency);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: isRecent
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool isRecent (int window, qint64 now) const
+--
+-- RETURNS: bool - true if the recent histogram window ended less than an interval before now.
+--------------------------------------------------------------------------------------------------*/
+bool LatencyTracker::isRecent(int window, qint64 now) const
+{
+	return mWindowCount[window] > 0 && now - mWindowStart[window] < 2 * WINDOW_INTERVAL;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: rank
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: static quint64 rank (double percent, quint64 count)
+--
+-- RETURNS: quint64 - the position, from 1, of the answer at percent among count answers.
+--------------------------------------------------------------------------------------------------*/
+quint64 LatencyTracker::rank(double percent, quint64 count)
+{
+	quint64 position = static_cast<quint64>(std::ceil(qBound(0.0, percent, 100.0) / 100.0 * count));
+	return qMax<quint64>(position, 1);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: bucket
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int bucket (qint64 value)
+--
+-- RETURNS: int - the histogram bucket that counts value.
+--
+-- NOTES:
+-- Values under 2 * SUB_BUCKETS are their own bucket. Above that, value is shifted right until
+-- SUB_BUCKET_BITS + 1 bits are left, giving a number from SUB_BUCKETS to 2 * SUB_BUCKETS - 1, and
+-- each shift moves on by SUB_BUCKETS buckets. Values too large for VALUE_BITS share the last
+-- bucket.
+--------------------------------------------------------------------------------------------------*/
+int LatencyTracker::bucket(qint64 value)
+{
+	quint64 v = qMin<quint64>(static_cast<quint64>(value), (Q_UINT64_C(1) << VALUE_BITS) - 1);
+	if (v < 2 * SUB_BUCKETS)
+	{
+		return static_cast<int>(v);
+	}
+
+	int shift = (63 - qCountLeadingZeroBits(v)) - SUB_BUCKET_BITS;
+	return shift * SUB_BUCKETS + static_cast<int>(v >> shift);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: bucketHighest
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 bucketHighest (int bucket)
+--
+-- RETURNS: qint64 - the highest value counted in bucket.
+--------------------------------------------------------------------------------------------------*/
+qint64 LatencyTracker::bucketHighest(int bucket)
+{
+	if (bucket < 2 * SUB_BUCKETS)
+	{
+		return bucket;
+	}
+
+	int shift = bucket / SUB_BUCKETS - 1;
+	qint64 sub = bucket % SUB_BUCKETS + SUB_BUCKETS;
+	return ((sub + 1) << shift) - 1;
+}
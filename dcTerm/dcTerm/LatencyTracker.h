@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QQueue>
+#include <QVector>
+
+class LatencyTracker
+{
+public:
+	static const int SUB_BUCKET_BITS = 5;
+	static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+	static const int VALUE_BITS = 36;
+	static const int BUCKET_COUNT = (VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+	static const int MAX_PENDING = 256;
+	static const qint64 DEFAULT_TIMEOUT = 5000000;
+	static const qint64 WINDOW_INTERVAL = 10000000;
+
+	LatencyTracker();
+
+	void setTerminator(const QByteArray &terminator);
+	const QByteArray &terminator() const;
+	void setTimeout(qint64 timeout);
+	qint64 timeout() const;
+
+	void clear();
+	void sent(qint64 timestamp, const char* data, int size);
+	void received(qint64 timestamp, const char* data, int size);
+
+	quint64 count() const;
+	quint64 timeouts() const;
+	int pending() const;
+	qint64 minimum() const;
+	qint64 maximum() const;
+	double mean() const;
+	qint64 percentile(double percent) const;
+
+	quint64 recentCount(qint64 now) const;
+	qint64 recentPercentile(double percent, qint64 now) const;
+
+	bool writeCsv(QIODevice* device) const;
+
+private:
+	QByteArray mTerminator;
+	QVector<int> mFailure;
+	int mMatched;
+	qint64 mTimeout;
+
+	QQueue<qint64> mPending;
+
+	QVector<quint64> mCounts;
+	quint64 mCount;
+	quint64 mTimeouts;
+	qint64 mMinimum;
+	qint64 mMaximum;
+	double mSum;
+
+	QVector<quint64> mWindowCounts[2];
+	quint64 mWindowCount[2];
+	qint64 mWindowMaximum[2];
+	qint64 mWindowStart[2];
+	int mWindow;
+
+	void expire(qint64 timestamp);
+	void complete(qint64 timestamp);
+	bool isRecent(int window, qint64 now) const;
+
+	static quint64 rank(double percent, quint64 count);
+	static int bucket(qint64 value);
+	static qint64 bucketHighest(int bucket);
+};
@@ -0,0 +1,468 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: MemoryBudget.cpp - Keeps count of the memory each part of a session holds.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- void setLimit(Subsystem subsystem, qint64 bytes);
+-- qint64 limit(Subsystem subsystem) const;
+-- void setTotalLimit(qint64 bytes);
+-- qint64 totalLimit() const;
+--
+-- void charge(Subsystem subsystem, qint64 bytes);
+-- void release(Subsystem subsystem, qint64 bytes);
+-- void set(Subsystem subsystem, qint64 bytes);
+--
+-- qint64 current(Subsystem subsystem) const;
+-- qint64 peak(Subsystem subsystem) const;
+-- bool exceeded(Subsystem subsystem) const;
+-- bool wouldExceed(Subsystem subsystem, qint64 bytes) const;
+--
+-- qint64 total() const;
+-- qint64 peakTotal() const;
+-- bool totalExceeded() const;
+-- void resetPeaks();
+--
+-- static QString name(Subsystem subsystem);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Added the receive history.
+-- October 18, 2026 - Added a limit on the total, and the receive limit covers the port's buffer.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- dcTerm is often left connected for weeks, so everything that grows with traffic has a limit.
+-- Each subsystem reports what it holds here, either as it allocates and frees (charge and
+-- release) or by recounting (set), and checks exceeded() to decide when to drop old data or stop
+-- recording, or wouldExceed() before allocating. The current and peak figures are shown in the
+-- statistics window, and the limits can be changed from the Statistics menu.
+--
+-- The default limits are:
+-- - Scrollback: 8 MB of console text
+-- - Receive: 2 MB of read blocks and data waiting in the serial port's read buffer
+-- - History: 1 MB of recent received bytes shared by the console's hex pane, of which the ring
+--   takes the largest power of two that fits beside its line index
+-- - Capture: 1 MB of capture blocks waiting to be written
+-- - Timing: 64 MB of recorded batches, about 28 million reads
+-- - Highlight: 1 MB of cached highlight spans
+-- - Total: 128 MB across every subsystem, 0 for no total limit
+--
+-- The subsystems that keep what is already shown, the scrollback and the receive history, are held
+-- to their own limits only. The ones that record or cache more as traffic goes on, capture, timing
+-- and highlighting, also stop taking more once the total is reached.
+--
+-- The budget is only used from the thread the session runs on.
+--------------------------------------------------------------------------------------------------*/
+#include "MemoryBudget.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Sets the receive history limit.
+-- October 18, 2026 - Sets the total limit, and raises the receive limit to cover the port's buffer.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: MemoryBudget ()
+--
+-- NOTES:
+-- Constructor for a budget with the default limits and nothing charged.
+--------------------------------------------------------------------------------------------------*/
+MemoryBudget::MemoryBudget()
+	: mTotalLimit(128 * 1024 * 1024)
+	, mPeakTotal(0)
+{
+	for (int i = 0; i < SUBSYSTEM_COUNT; i++)
+	{
+		mCurrent[i] = 0;
+		mPeak[i] = 0;
+	}
+
+	mLimit[Scrollback] = 8 * 1024 * 1024;
+	mLimit[Receive] = 2 * 1024 * 1024;
+	mLimit[History] = 1024 * 1024;
+	mLimit[Capture] = 1024 * 1024;
+	mLimit[Timing] = 64 * 1024 * 1024;
+	mLimit[Highlight] = 1024 * 1024;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setLimit
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setLimit (Subsystem subsystem, qint64 bytes)
+--
+-- RETURNS: void.
+--------------------------------------------------------------------------------------------------*/
+void MemoryBudget::setLimit(Subsystem subsystem, qint64 bytes)
+{
+	mLimit[subsystem] = bytes;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: limit
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 limit (Subsystem subsystem) const
+--
+-- RETURNS: qint64 - the most subsystem should hold, in bytes.
+--------------------------------------------------------------------------------------------------*/
+qint64 MemoryBudget::limit(Subsystem subsystem) const
+{
+	return mLimit[subsystem];
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setTotalLimit
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setTotalLimit (qint64 bytes)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Sets the most every subsystem together should hold. 0 leaves the total unlimited.
+--------------------------------------------------------------------------------------------------*/
+void MemoryBudget::setTotalLimit(qint64 bytes)
+{
+	mTotalLimit = bytes;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: totalLimit
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 totalLimit (void) const
+--
+-- RETURNS: qint64 - the most every subsystem together should hold, 0 if unlimited.
+--------------------------------------------------------------------------------------------------*/
+qint64 MemoryBudget::totalLimit() const
+{
+	return mTotalLimit;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: charge
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void charge (Subsystem subsystem, qint64 bytes)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Records that subsystem allocated bytes more.
+--------------------------------------------------------------------------------------------------*/
+void MemoryBudget::charge(Subsystem subsystem, qint64 bytes)
+{
+	set(subsystem, mCurrent[subsystem] + bytes);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: release
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void release (Subsystem subsystem, qint64 bytes)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Records that subsystem freed bytes.
+--------------------------------------------------------------------------------------------------*/
+void MemoryBudget::release(Subsystem subsystem, qint64 bytes)
+{
+	set(subsystem, mCurrent[subsystem] - bytes);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: set
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void set (Subsystem subsystem, qint64 bytes)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Records that subsystem now holds bytes in total and updates the peaks.
+--------------------------------------------------------------------------------------------------*/
+void MemoryBudget::set(Subsystem subsystem, qint64 bytes)
+{
+	mCurrent[subsystem] = qMax<qint64>(0, bytes);
+	mPeak[subsystem] = qMax(mPeak[subsystem], mCurrent[subsystem]);
+	mPeakTotal = qMax(mPeakTotal, total());
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: current
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 current (Subsystem subsystem) const
+--
+-- RETURNS: qint64 - the bytes subsystem holds now.
+--------------------------------------------------------------------------------------------------*/
+qint64 MemoryBudget::current(Subsystem subsystem) const
+{
+	return mCurrent[subsystem];
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: peak
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 peak (Subsystem subsystem) const
+--
+-- RETURNS: qint64 - the most bytes subsystem has held since the peaks were last reset.
+--------------------------------------------------------------------------------------------------*/
+qint64 MemoryBudget::peak(Subsystem subsystem) const
+{
+	return mPeak[subsystem];
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: exceeded
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool exceeded (Subsystem subsystem) const
+--
+-- RETURNS: bool - true if subsystem holds more than its limit.
+--------------------------------------------------------------------------------------------------*/
+bool MemoryBudget::exceeded(Subsystem subsystem) const
+{
+	return mCurrent[subsystem] > mLimit[subsystem];
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: wouldExceed
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool wouldExceed (Subsystem subsystem, qint64 bytes) const
+--
+-- RETURNS: bool - true if charging bytes more to subsystem would take it past its limit or
+--          take the total past the total limit.
+--
+-- NOTES:
+-- Asked before allocating, by subsystems that would rather go without than go over.
+--------------------------------------------------------------------------------------------------*/
+bool MemoryBudget::wouldExceed(Subsystem subsystem, qint64 bytes) const
+{
+	if (mCurrent[subsystem] + bytes > mLimit[subsystem])
+	{
+		return true;
+	}
+	return mTotalLimit > 0 && total() + bytes > mTotalLimit;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: total
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 total (void) const
+--
+-- RETURNS: qint64 - the bytes held by every subsystem together.
+--------------------------------------------------------------------------------------------------*/
+qint64 MemoryBudget::total() const
+{
+	qint64 sum = 0;
+	for (int i = 0; i < SUBSYSTEM_COUNT; i++)
+	{
+		sum += mCurrent[i];
+	}
+	return sum;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: peakTotal
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 peakTotal (void) const
+--
+-- RETURNS: qint64 - the most bytes held by every subsystem together at one time.
+--------------------------------------------------------------------------------------------------*/
+qint64 MemoryBudget::peakTotal() const
+{
+	return mPeakTotal;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: totalExceeded
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool totalExceeded (void) const
+--
+-- RETURNS: bool - true if every subsystem together holds more than the total limit.
+--------------------------------------------------------------------------------------------------*/
+bool MemoryBudget::totalExceeded() const
+{
+	return mTotalLimit > 0 && total() > mTotalLimit;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: resetPeaks
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void resetPeaks (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Starts the peaks over from the current figures.
+--------------------------------------------------------------------------------------------------*/
+void MemoryBudget::resetPeaks()
+{
+	for (int i = 0; i < SUBSYSTEM_COUNT; i++)
+	{
+		mPeak[i] = mCurrent[i];
+	}
+	mPeakTotal = total();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: name
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Names the receive history.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: static QString name (Subsystem subsystem)
+--
+-- RETURNS: QString - the subsystem's name for display.
+--------------------------------------------------------------------------------------------------*/
+QString MemoryBudget::name(Subsystem subsystem)
+{
+	switch (subsystem)
+	{
+	case Scrollback:
+		return "Scrollback";
+	case Receive:
+		return "Receive buffers";
+	case History:
+		return "Receive history";
+	case Capture:
+		return "Capture buffers";
+	case Timing:
+		return "Timing";
+	case Highlight:
+		return "Highlight cache";
+	default:
+		return QString();
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QString>
+
+class MemoryBudget
+{
+public:
+	enum Subsystem
+	{
+		Scrollback,
+		Receive,
+		History,
+		Capture,
+		Timing,
+		Highlight,
+		SUBSYSTEM_COUNT
+	};
+
+	MemoryBudget();
+
+	void setLimit(Subsystem subsystem, qint64 bytes);
+	qint64 limit(Subsystem subsystem) const;
+	void setTotalLimit(qint64 bytes);
+	qint64 totalLimit() const;
+
+	void charge(Subsystem subsystem, qint64 bytes);
+	void release(Subsystem subsystem, qint64 bytes);
+	void set(Subsystem subsystem, qint64 bytes);
+
+	qint64 current(Subsystem subsystem) const;
+	qint64 peak(Subsystem subsystem) const;
+	bool exceeded(Subsystem subsystem) const;
+	bool wouldExceed(Subsystem subsystem, qint64 bytes) const;
+
+	qint64 total() const;
+	qint64 peakTotal() const;
+	bool totalExceeded() const;
+	void resetPeaks();
+
+	static QString name(Subsystem subsystem);
+
+private:
+	qint64 mLimit[SUBSYSTEM_COUNT];
+	qint64 mCurrent[SUBSYSTEM_COUNT];
+	qint64 mPeak[SUBSYSTEM_COUNT];
+	qint64 mTotalLimit;
+	qint64 mPeakTotal;
+};
@@ -0,0 +1,577 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: ModemLineMonitor.cpp - Watches the modem control lines of a serial port.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- ModemLineWaiter:
+-- void abort();
+-- void interrupt();
+-- void run();
+--
+-- ModemLineMonitor:
+-- void start(QSerialPort* port);
+-- void stop();
+-- bool isRunning() const;
+-- bool isEventDriven() const;
+-- QSerialPort::PinoutSignals lines() const;
+-- void check(qint64 timestamp);
+-- void count(qint64 timestamp, const ModemLineCounts &transitions);
+-- void poll();
+-- void startPolling();
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - The waiter reads the driver's transition counts so pulses between readings
+--     are reported, and the interrupt signal's previous handler is put back when watching stops.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- The monitor reports every change of the port's control lines (CTS, DSR, DCD and RI from the
+-- device, DTR and RTS from us) with the time it was seen.
+--
+-- On Linux a ModemLineWaiter sits on a thread of its own in ioctl(TIOCMIWAIT), which the driver
+-- wakes when CTS, DSR, DCD or RI changes, so an idle line costs nothing and a change is timed to
+-- within the thread's wake-up. The waiter only timestamps the change; the monitor reads the lines
+-- on its own thread, where the port lives. Stopping the waiter needs it out of the ioctl: it is
+-- sent INTERRUPT_SIGNAL, whose handler does nothing but makes the ioctl return EINTR. The signal
+-- is sent again every ABORT_RETRY milliseconds in case it arrived just before the ioctl started.
+--
+-- A line can change and change back before the monitor reads it, e.g. a short RI or DCD pulse, and
+-- the two readings then look the same. So the waiter also reads the driver's count of transitions
+-- on each line with TIOCGICOUNT and passes on how many there were since its last wake. A line
+-- that the counts say moved but that reads the same as before is reported as having pulsed: the
+-- monitor emits the line flipped and then as read, both at the time of the wake. Transitions that
+-- happen between a wake and the next TIOCMIWAIT do not wake the waiter, but they are counted and
+-- show up at the next wake.
+--
+-- INTERRUPT_SIGNAL is SIGUSR2 and its handler is process-wide. The first monitor to start keeps
+-- whatever handler was installed and the last one to stop puts it back, after its waiter's thread
+-- has ended so no interrupt can arrive without a handler. While a port is watched, a SIGUSR2 sent
+-- to the process for some other reason is swallowed by the empty handler. Monitors are started
+-- and stopped on one thread, the one the sessions live on, so the count of them needs no lock.
+--
+-- Drivers that do not support TIOCMIWAIT, and other systems, fall back to reading the lines every
+-- POLL_INTERVAL milliseconds. A pulse shorter than the poll interval can be missed.
+--------------------------------------------------------------------------------------------------*/
+#include <QtGlobal>
+
+#ifdef Q_OS_LINUX
+#include <cerrno>
+#include <linux/serial.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/ioctl.h>
+#endif
+
+#include "CaptureFile.h"
+#include "ModemLineMonitor.h"
+
+#ifdef Q_OS_LINUX
+static const int INTERRUPT_SIGNAL = SIGUSR2;
+
+static struct sigaction previousAction;
+static int handlerUsers = 0;
+
+static void interrupted(int)
+{
+}
+#endif
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: ModemLineWaiter (int descriptor)
+--
+-- NOTES:
+-- Constructor for a waiter on the open serial port descriptor.
+--------------------------------------------------------------------------------------------------*/
+ModemLineWaiter::ModemLineWaiter(int descriptor)
+	: mDescriptor(descriptor)
+	, mAborted(0)
+	, mStarted(0)
+	, mThreadId(nullptr)
+{
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: abort
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void abort (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Called from the monitor's thread to have run() return the next time it wakes.
+--------------------------------------------------------------------------------------------------*/
+void ModemLineWaiter::abort()
+{
+	mAborted.storeRelease(1);
+	interrupt();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: interrupt
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void interrupt (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Wakes the waiter's thread from TIOCMIWAIT if it has started waiting.
+--------------------------------------------------------------------------------------------------*/
+void ModemLineWaiter::interrupt()
+{
+#ifdef Q_OS_LINUX
+	if (mStarted.loadAcquire())
+	{
+		pthread_kill(reinterpret_cast<pthread_t>(mThreadId), INTERRUPT_SIGNAL);
+	}
+#endif
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: run
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Passes on the driver's transition counts with each change.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void run (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the waiter's thread starts.
+--
+-- Waits for the device's lines to change until aborted, emitting changed() with the time of each
+-- change and the transitions on each line since the last one. The counts are all 0 if the driver
+-- does not keep them. If the driver refuses the wait, unsupported() is emitted and the waiter
+-- returns.
+--------------------------------------------------------------------------------------------------*/
+void ModemLineWaiter::run()
+{
+#ifdef Q_OS_LINUX
+	mThreadId = QThread::currentThreadId();
+	mStarted.storeRelease(1);
+
+	struct serial_icounter_struct last;
+	bool counting = ::ioctl(mDescriptor, TIOCGICOUNT, &last) == 0;
+
+	while (!mAborted.loadAcquire())
+	{
+		if (::ioctl(mDescriptor, TIOCMIWAIT, TIOCM_CTS | TIOCM_DSR | TIOCM_CD | TIOCM_RNG) == 0)
+		{
+			qint64 timestamp = CaptureFile::now();
+			ModemLineCounts transitions = { 0, 0, 0, 0 };
+			struct serial_icounter_struct counts;
+			if (counting && ::ioctl(mDescriptor, TIOCGICOUNT, &counts) == 0)
+			{
+				transitions.cts = static_cast<quint32>(counts.cts) - static_cast<quint32>(last.cts);
+				transitions.dsr = static_cast<quint32>(counts.dsr) - static_cast<quint32>(last.dsr);
+				transitions.dcd = static_cast<quint32>(counts.dcd) - static_cast<quint32>(last.dcd);
+				transitions.ring = static_cast<quint32>(counts.rng) - static_cast<quint32>(last.rng);
+				last = counts;
+			}
+			emit changed(timestamp, transitions);
+		}
+		else if (errno != EINTR)
+		{
+			emit unsupported();
+			return;
+		}
+	}
+#else
+	emit unsupported();
+#endif
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Registers ModemLineCounts.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: ModemLineMonitor (QObject*)
+--
+-- NOTES:
+-- Constructor for a monitor that is not watching a port. Registers the transition counts so the
+-- waiter can send them across threads.
+--------------------------------------------------------------------------------------------------*/
+ModemLineMonitor::ModemLineMonitor(QObject* parent)
+	: QObject(parent)
+	, mPort(nullptr)
+	, mThread(nullptr)
+	, mWaiter(nullptr)
+	, mLines(QSerialPort::NoSignal)
+{
+	qRegisterMetaType<ModemLineCounts>();
+	connect(&mPoll, &QTimer::timeout, this, &ModemLineMonitor::poll);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Deconstructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: ~ModemLineMonitor ()
+--
+-- NOTES:
+-- Stops watching and ends the waiter's thread.
+--------------------------------------------------------------------------------------------------*/
+ModemLineMonitor::~ModemLineMonitor()
+{
+	stop();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: start
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Keeps the interrupt signal's previous handler, and takes the waiter's
+--     transition counts.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void start (QSerialPort* port)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Starts watching the open port, reporting its lines as they are now straight away. On Linux
+-- the waiter's thread is started, and if no other monitor is running the handler for its
+-- interrupt signal is installed without SA_RESTART so the signal ends the ioctl, keeping the
+-- handler it replaces. Elsewhere the lines are polled.
+--------------------------------------------------------------------------------------------------*/
+void ModemLineMonitor::start(QSerialPort* port)
+{
+	stop();
+
+	mPort = port;
+	mLines = QSerialPort::NoSignal;
+	check(CaptureFile::now());
+
+#ifdef Q_OS_LINUX
+	if (handlerUsers++ == 0)
+	{
+		struct sigaction action;
+		action.sa_handler = interrupted;
+		action.sa_flags = 0;
+		sigemptyset(&action.sa_mask);
+		sigaction(INTERRUPT_SIGNAL, &action, &previousAction);
+	}
+
+	mWaiter = new ModemLineWaiter(static_cast<int>(port->handle()));
+	mThread = new QThread();
+	mWaiter->moveToThread(mThread);
+	connect(mThread, &QThread::started, mWaiter, &ModemLineWaiter::run);
+	connect(mWaiter, &ModemLineWaiter::changed, this, &ModemLineMonitor::count);
+	connect(mWaiter, &ModemLineWaiter::unsupported, this, &ModemLineMonitor::startPolling);
+	mThread->start();
+#else
+	startPolling();
+#endif
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: stop
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Puts back the interrupt signal's previous handler.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void stop (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Stops watching. Must be called before the port is closed, while the waiter's descriptor is
+-- still valid. Waits for the waiter's thread to end, interrupting it until it does. The last
+-- monitor to stop puts back the interrupt signal's previous handler once its thread has ended.
+--------------------------------------------------------------------------------------------------*/
+void ModemLineMonitor::stop()
+{
+	mPoll.stop();
+	if (mThread)
+	{
+		mWaiter->abort();
+		mThread->quit();
+		while (!mThread->wait(ABORT_RETRY))
+		{
+			mWaiter->interrupt();
+		}
+		delete mWaiter;
+		delete mThread;
+		mWaiter = nullptr;
+		mThread = nullptr;
+
+#ifdef Q_OS_LINUX
+		if (--handlerUsers == 0)
+		{
+			sigaction(INTERRUPT_SIGNAL, &previousAction, nullptr);
+		}
+#endif
+	}
+	mPort = nullptr;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: isRunning
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool isRunning (void) const
+--
+-- RETURNS: bool - true while a port is being watched.
+--------------------------------------------------------------------------------------------------*/
+bool ModemLineMonitor::isRunning() const
+{
+	return mPort != nullptr;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: isEventDriven
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool isEventDriven (void) const
+--
+-- RETURNS: bool - true if changes are reported by the driver rather than found by polling.
+--------------------------------------------------------------------------------------------------*/
+bool ModemLineMonitor::isEventDriven() const
+{
+	return mPort != nullptr && !mPoll.isActive();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: lines
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QSerialPort::PinoutSignals lines (void) const
+--
+-- RETURNS: QSerialPort::PinoutSignals - the lines as last seen.
+--------------------------------------------------------------------------------------------------*/
+QSerialPort::PinoutSignals ModemLineMonitor::lines() const
+{
+	return mLines;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: check
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - The waiter's changes go to count() instead.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void check (qint64 timestamp)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when a line is polled. It is also called after DTR
+-- or RTS is set, since the driver does not report our own lines.
+--
+-- Reads the lines and emits linesChanged() with timestamp if they differ from the last reading.
+--------------------------------------------------------------------------------------------------*/
+void ModemLineMonitor::check(qint64 timestamp)
+{
+	if (!mPort || !mPort->isOpen())
+	{
+		return;
+	}
+
+	QSerialPort::PinoutSignals lines = mPort->pinoutSignals();
+	if (lines != mLines)
+	{
+		mLines = lines;
+		emit linesChanged(lines, timestamp);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: count
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void count (qint64 timestamp, const ModemLineCounts &transitions)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the waiter sees a change.
+--
+-- Reads the lines like check(), but first reports any line that the counts say moved while it
+-- reads the same as before: the lines are emitted with it flipped, then as read, so the pulse is
+-- not lost between the two readings.
+--------------------------------------------------------------------------------------------------*/
+void ModemLineMonitor::count(qint64 timestamp, const ModemLineCounts &transitions)
+{
+	if (!mPort || !mPort->isOpen())
+	{
+		return;
+	}
+
+	QSerialPort::PinoutSignals lines = mPort->pinoutSignals();
+	QSerialPort::PinoutSignals moved = lines ^ mLines;
+	QSerialPort::PinoutSignals pulsed = QSerialPort::NoSignal;
+	if (transitions.cts > 0 && !(moved & QSerialPort::ClearToSendSignal))
+	{
+		pulsed |= QSerialPort::ClearToSendSignal;
+	}
+	if (transitions.dsr > 0 && !(moved & QSerialPort::DataSetReadySignal))
+	{
+		pulsed |= QSerialPort::DataSetReadySignal;
+	}
+	if (transitions.dcd > 0 && !(moved & QSerialPort::DataCarrierDetectSignal))
+	{
+		pulsed |= QSerialPort::DataCarrierDetectSignal;
+	}
+	if (transitions.ring > 0 && !(moved & QSerialPort::RingIndicatorSignal))
+	{
+		pulsed |= QSerialPort::RingIndicatorSignal;
+	}
+
+	if (pulsed != QSerialPort::NoSignal)
+	{
+		mLines ^= pulsed;
+		emit linesChanged(mLines, timestamp);
+	}
+	if (lines != mLines)
+	{
+		mLines = lines;
+		emit linesChanged(lines, timestamp);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: poll
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void poll (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered every POLL_INTERVAL milliseconds when polling.
+--------------------------------------------------------------------------------------------------*/
+void ModemLineMonitor::poll()
+{
+	check(CaptureFile::now());
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: startPolling
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void startPolling (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the driver cannot wait for line changes.
+--------------------------------------------------------------------------------------------------*/
+void ModemLineMonitor::startPolling()
+{
+	if (mPort)
+	{
+		mPoll.start(POLL_INTERVAL);
+	}
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QMetaType>
+#include <QObject>
+#include <QSerialPort>
+#include <QThread>
+#include <QTimer>
+
+struct ModemLineCounts
+{
+	quint32 cts;
+	quint32 dsr;
+	quint32 dcd;
+	quint32 ring;
+};
+
+Q_DECLARE_METATYPE(ModemLineCounts)
+
+class ModemLineWaiter
+	: public QObject
+{
+	Q_OBJECT
+
+public:
+	explicit ModemLineWaiter(int descriptor);
+
+	void abort();
+	void interrupt();
+
+public slots:
+	void run();
+
+private:
+	int mDescriptor;
+	QAtomicInt mAborted;
+	QAtomicInt mStarted;
+	Qt::HANDLE mThreadId;
+
+signals:
+	void changed(qint64 timestamp, const ModemLineCounts &transitions);
+	void unsupported();
+};
+
+class ModemLineMonitor
+	: public QObject
+{
+	Q_OBJECT
+
+public:
+	static const int POLL_INTERVAL = 20;
+	static const int ABORT_RETRY = 50;
+
+	explicit ModemLineMonitor(QObject *parent = nullptr);
+	~ModemLineMonitor();
+
+	void start(QSerialPort* port);
+	void stop();
+	bool isRunning() const;
+	bool isEventDriven() const;
+
+	QSerialPort::PinoutSignals lines() const;
+
+public slots:
+	void check(qint64 timestamp);
+
+private:
+	QSerialPort* mPort;
+	QThread* mThread;
+	ModemLineWaiter* mWaiter;
+	QTimer mPoll;
+	QSerialPort::PinoutSignals mLines;
+
+private slots:
+	void count(qint64 timestamp, const ModemLineCounts &transitions);
+	void poll();
+	void startPolling();
+
+signals:
+	void linesChanged(QSerialPort::PinoutSignals lines, qint64 timestamp);
+};
@@ -0,0 +1,642 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: ScriptRunner.cpp - Runs JavaScript automation against the serial port.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- ScriptApi:
+-- void feed(const QByteArray &data);
+-- void abort();
+-- void send(const QString &text);
+-- bool expect(const QString &text, int timeout);
+-- QVariant expectRegex(const QString &pattern, int timeout);
+-- QString readAvailable();
+-- void wait(int milliseconds);
+-- void log(const QString &message);
+-- void run(const QString &program, const QString &fileName);
+--
+-- ScriptRunner:
+-- bool start(const QString &path, QString* error);
+-- void stop();
+-- bool isRunning() const;
+-- QString scriptName() const;
+-- void feed(const QByteArray &data);
+-- void scriptFinished(bool ok, const QString &message);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- Scripts are plain JavaScript run by a QJSEngine on a thread of their own, so a script that is
+-- waiting for the device never blocks the window or the draining of the serial port. A script
+-- sees these global functions:
+--
+--     send(text)                  write text to the port
+--     expect(text, timeoutMs)     wait for text to be received, returns true or false on timeout
+--     expectRegex(re, timeoutMs)  wait for a regex match, returns the matched text or undefined
+--     readAvailable()             return and consume everything received so far
+--     wait(ms)                    sleep
+--     log(message)                show a message (status bar, or stdout when headless)
+--
+-- Received data reaches the script through feed(), which is called from the receive path and
+-- only holds a lock long enough to append to a buffer. expect() consumes the buffer up to the end
+-- of the match, so a sequence of expect() calls walks forward through the stream in order.
+--
+-- The runner is not tied to the window. main() uses it to run scripts headless with --script.
+--------------------------------------------------------------------------------------------------*/
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJSEngine>
+#include <QJSValue>
+#include <QQmlEngine>
+#include <QRegularExpression>
+
+#include "ScriptRunner.h"
+
+const char* ScriptApi::PRELUDE =
+	"function send(text) { port.send(String(text)); }\n"
+	"function expect(text, timeout) { return port.expect(String(text), timeout === undefined ? 5000 : timeout); }\n"
+	"function expectRegex(re, timeout) { return port.expectRegex(re instanceof RegExp ? re.source : String(re), timeout === undefined ? 5000 : timeout); }\n"
+	"function readAvailable() { return port.readAvailable(); }\n"
+	"function wait(ms) { port.wait(ms); }\n"
+	"function log(message) { port.log(String(message)); }\n";
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: ScriptApi
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: ScriptApi (QObject*)
+--
+-- NOTES:
+-- Constructor for the object scripts use to talk to the port. It is moved to the script thread
+-- before run() is called.
+--------------------------------------------------------------------------------------------------*/
+ScriptApi::ScriptApi(QObject* parent)
+	: QObject(parent)
+	, mAborted(0)
+	, mEngine(nullptr)
+{
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: feed
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void feed (const QByteArray &data)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Called from the receive path on the main thread. Appends data for the script and wakes it if it
+-- is waiting. If the script stops reading, only the newest MAX_PENDING_BYTES are kept.
+--------------------------------------------------------------------------------------------------*/
+void ScriptApi::feed(const QByteArray &data)
+{
+	QMutexLocker lock(&mMutex);
+	mPending.append(data);
+	if (mPending.size() > MAX_PENDING_BYTES)
+	{
+		mPending.remove(0, mPending.size() - MAX_PENDING_BYTES);
+	}
+	mArrived.wakeAll();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: abort
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void abort (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Called from the main thread to stop the script. Any wait in progress returns immediately and
+-- every later call to the API returns without doing anything, so a script that uses the API
+-- finishes quickly.
+--
+-- On Qt 5.14 and later the engine is also interrupted, which stops scripts that are busy in pure
+-- JavaScript. Older versions can only stop a script at its next call to the API.
+--------------------------------------------------------------------------------------------------*/
+void ScriptApi::abort()
+{
+	QMutexLocker lock(&mMutex);
+	mAborted.store(1);
+	mArrived.wakeAll();
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+	if (mEngine)
+	{
+		mEngine->setInterrupted(true);
+	}
+#endif
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: send
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void send (const QString &text)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Asks the owner of the port to write text. The request is queued to the main thread so the
+-- script never touches the port directly.
+--------------------------------------------------------------------------------------------------*/
+void ScriptApi::send(const QString &text)
+{
+	if (mAborted.load())
+	{
+		return;
+	}
+	emit sendRequested(text.toLocal8Bit());
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: expect
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool expect (const QString &text, int timeout)
+--
+-- RETURNS: bool - true if text was received within timeout milliseconds.
+--
+-- NOTES:
+-- Waits for text to appear in the received data and consumes everything up to and including it.
+-- Only this script thread sleeps while waiting.
+--------------------------------------------------------------------------------------------------*/
+bool ScriptApi::expect(const QString &text, int timeout)
+{
+	QByteArray needle = text.toLocal8Bit();
+	QElapsedTimer timer;
+	timer.start();
+
+	QMutexLocker lock(&mMutex);
+	for (;;)
+	{
+		int index = mPending.indexOf(needle);
+		if (index >= 0)
+		{
+			mPending.remove(0, index + needle.size());
+			return true;
+		}
+
+		qint64 remaining = timeout - timer.elapsed();
+		if (mAborted.load() || remaining <= 0)
+		{
+			return false;
+		}
+		mArrived.wait(&mMutex, static_cast<unsigned long>(remaining));
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: expectRegex
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QVariant expectRegex (const QString &pattern, int timeout)
+--
+-- RETURNS: QVariant - the matched text, or an invalid QVariant (undefined in the script) on
+--          timeout or if the pattern is not valid.
+--
+-- NOTES:
+-- Like expect, but matches a regular expression against the received data.
+--------------------------------------------------------------------------------------------------*/
+QVariant ScriptApi::expectRegex(const QString &pattern, int timeout)
+{
+	QRegularExpression regex(pattern);
+	if (!regex.isValid())
+	{
+		emit logMessage(tr("expectRegex: %1").arg(regex.errorString()));
+		return QVariant();
+	}
+
+	QElapsedTimer timer;
+	timer.start();
+
+	QMutexLocker lock(&mMutex);
+	for (;;)
+	{
+		QString text = QString::fromLocal8Bit(mPending);
+		QRegularExpressionMatch match = regex.match(text);
+		if (match.hasMatch())
+		{
+			mPending.remove(0, text.left(match.capturedEnd()).toLocal8Bit().size());
+			return match.captured();
+		}
+
+		qint64 remaining = timeout - timer.elapsed();
+		if (mAborted.load() || remaining <= 0)
+		{
+			return QVariant();
+		}
+		mArrived.wait(&mMutex, static_cast<unsigned long>(remaining));
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: readAvailable
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QString readAvailable (void)
+--
+-- RETURNS: QString - everything received and not yet consumed.
+--------------------------------------------------------------------------------------------------*/
+QString ScriptApi::readAvailable()
+{
+	QMutexLocker lock(&mMutex);
+	QString text = QString::fromLocal8Bit(mPending);
+	mPending.clear();
+	return text;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: wait
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void wait (int milliseconds)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Sleeps the script thread. Received data keeps being buffered meanwhile, and abort() ends the
+-- sleep early.
+--------------------------------------------------------------------------------------------------*/
+void ScriptApi::wait(int milliseconds)
+{
+	QElapsedTimer timer;
+	timer.start();
+
+	QMutexLocker lock(&mMutex);
+	for (;;)
+	{
+		qint64 remaining = milliseconds - timer.elapsed();
+		if (mAborted.load() || remaining <= 0)
+		{
+			return;
+		}
+		mArrived.wait(&mMutex, static_cast<unsigned long>(remaining));
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: log
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void log (const QString &message)
+--
+-- RETURNS: void.
+--------------------------------------------------------------------------------------------------*/
+void ScriptApi::log(const QString &message)
+{
+	emit logMessage(message);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: run
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void run (const QString &program, const QString &fileName)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and runs on the script thread.
+--
+-- Creates the engine on this thread, exposes this object as "port" along with the global helper
+-- functions, and evaluates the program. The engine must not delete this object when it is
+-- destroyed, so C++ ownership is set explicitly. The engine is published to abort() only while
+-- the program is being evaluated.
+--------------------------------------------------------------------------------------------------*/
+void ScriptApi::run(const QString &program, const QString &fileName)
+{
+	QJSEngine engine;
+	QQmlEngine::setObjectOwnership(this, QQmlEngine::CppOwnership);
+	engine.globalObject().setProperty("port", engine.newQObject(this));
+	engine.evaluate(PRELUDE);
+
+	mMutex.lock();
+	mEngine = &engine;
+	mMutex.unlock();
+
+	QJSValue result = engine.evaluate(program, fileName);
+
+	mMutex.lock();
+	mEngine = nullptr;
+	mMutex.unlock();
+
+	if (mAborted.load())
+	{
+		emit finished(false, tr("Stopped"));
+	}
+	else if (result.isError())
+	{
+		emit finished(false, QString("%1:%2: %3")
+			.arg(QFileInfo(fileName).fileName())
+			.arg(result.property("lineNumber").toInt())
+			.arg(result.toString()));
+	}
+	else
+	{
+		emit finished(true, tr("Finished"));
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: ScriptRunner
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: ScriptRunner (QObject*)
+--
+-- NOTES:
+-- Constructor for an idle runner.
+--------------------------------------------------------------------------------------------------*/
+ScriptRunner::ScriptRunner(QObject* parent)
+	: QObject(parent)
+	, mThread(nullptr)
+	, mApi(nullptr)
+{
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: ~ScriptRunner
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: ~ScriptRunner ()
+--
+-- NOTES:
+-- Stops a running script and waits for its thread to end.
+--------------------------------------------------------------------------------------------------*/
+ScriptRunner::~ScriptRunner()
+{
+	if (mThread)
+	{
+		mApi->abort();
+		mThread->quit();
+		mThread->wait();
+		delete mApi;
+		delete mThread;
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: start
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool start (const QString &path, QString* error)
+--
+-- RETURNS: bool - true if the script was started.
+--
+-- NOTES:
+-- Reads the script at path and starts it on a new thread. Only one script runs at a time.
+--------------------------------------------------------------------------------------------------*/
+bool ScriptRunner::start(const QString &path, QString* error)
+{
+	if (mThread)
+	{
+		*error = tr("A script is already running.");
+		return false;
+	}
+
+	QFile file(path);
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		*error = file.errorString();
+		return false;
+	}
+	QString program = QString::fromUtf8(file.readAll());
+
+	mScriptName = QFileInfo(path).fileName();
+	mThread = new QThread();
+	mApi = new ScriptApi();
+	mApi->moveToThread(mThread);
+
+	ScriptApi* api = mApi;
+	connect(mThread, &QThread::started, mApi, [api, program, path]()
+	{
+		api->run(program, path);
+	});
+	connect(mApi, &ScriptApi::sendRequested, this, &ScriptRunner::sendRequested);
+	connect(mApi, &ScriptApi::logMessage, this, &ScriptRunner::logMessage);
+	connect(mApi, &ScriptApi::finished, this, &ScriptRunner::scriptFinished);
+	connect(mThread, &QThread::finished, mApi, &QObject::deleteLater);
+	connect(mThread, &QThread::finished, mThread, &QObject::deleteLater);
+
+	mThread->start();
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: stop
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void stop (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Asks the running script to stop. The finished signal is emitted once it has.
+--------------------------------------------------------------------------------------------------*/
+void ScriptRunner::stop()
+{
+	if (mApi)
+	{
+		mApi->abort();
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: isRunning
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool isRunning (void) const
+--
+-- RETURNS: bool - true while a script is running.
+--------------------------------------------------------------------------------------------------*/
+bool ScriptRunner::isRunning() const
+{
+	return mThread != nullptr;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: scriptName
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QString scriptName (void) const
+--
+-- RETURNS: QString - the file name of the running or last run script.
+--------------------------------------------------------------------------------------------------*/
+QString ScriptRunner::scriptName() const
+{
+	return mScriptName;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: feed
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void feed (const QByteArray &data)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Passes received data to the running script. Does nothing when no script is running.
+--------------------------------------------------------------------------------------------------*/
+void ScriptRunner::feed(const QByteArray &data)
+{
+	if (mApi)
+	{
+		mApi->feed(data);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: scriptFinished
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void scriptFinished (bool ok, const QString &message)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered on the main thread when the script ends.
+--
+-- Lets the script thread exit; the thread and API object delete themselves once it has.
+--------------------------------------------------------------------------------------------------*/
+void ScriptRunner::scriptFinished(bool ok, const QString &message)
+{
+	mThread->quit();
+	mThread = nullptr;
+	mApi = nullptr;
+	emit finished(ok, message);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QThread>
+#include <QVariant>
+#include <QWaitCondition>
+
+class QJSEngine;
+
+class ScriptApi
+	: public QObject
+{
+	Q_OBJECT
+
+public:
+	static const int MAX_PENDING_BYTES = 1024 * 1024;
+
+	explicit ScriptApi(QObject *parent = nullptr);
+
+	void feed(const QByteArray &data);
+	void abort();
+
+	Q_INVOKABLE void send(const QString &text);
+	Q_INVOKABLE bool expect(const QString &text, int timeout);
+	Q_INVOKABLE QVariant expectRegex(const QString &pattern, int timeout);
+	Q_INVOKABLE QString readAvailable();
+	Q_INVOKABLE void wait(int milliseconds);
+	Q_INVOKABLE void log(const QString &message);
+
+public slots:
+	void run(const QString &program, const QString &fileName);
+
+private:
+	QMutex mMutex;
+	QWaitCondition mArrived;
+	QByteArray mPending;
+	QAtomicInt mAborted;
+	QJSEngine* mEngine;
+
+	static const char* PRELUDE;
+
+signals:
+	void sendRequested(const QByteArray &data);
+	void logMessage(const QString &message);
+	void finished(bool ok, const QString &message);
+};
+
+class ScriptRunner
+	: public QObject
+{
+	Q_OBJECT
+
+public:
+	explicit ScriptRunner(QObject *parent = nullptr);
+	~ScriptRunner();
+
+	bool start(const QString &path, QString* error);
+	void stop();
+	bool isRunning() const;
+	QString scriptName() const;
+
+	void feed(const QByteArray &data);
+
+private:
+	QThread* mThread;
+	ScriptApi* mApi;
+	QString mScriptName;
+
+private slots:
+	void scriptFinished(bool ok, const QString &message);
+
+signals:
+	void sendRequested(const QByteArray &data);
+	void logMessage(const QString &message);
+	void finished(bool ok, const QString &message);
+};
@@ -0,0 +1,742 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: SerialBridge.cpp - Shares the open serial port with other local programs.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- bool startTcp(quint16 port, const QHostAddress &address);
+-- bool startPty();
+-- void stop();
+--
+-- void setMaxBacklog(int bytes);
+-- int maxBacklog() const;
+--
+-- bool isActive() const;
+-- quint16 tcpPort() const;
+-- int clientCount() const;
+-- int droppedClients() const;
+-- QString description() const;
+-- QString errorString() const;
+--
+-- void broadcast(const QByteArray &data);
+--
+-- void acceptClient();
+-- void readFromClient();
+-- void dropClient();
+-- void readFromPty();
+--
+-- void removeClient(QTcpSocket* client);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Disconnect TCP clients that fall more than MAX_BACKLOG bytes behind.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- The bridge lets scripts and other tools use the serial port while it is open in dcTerm. Two
+-- transports are offered and both may be active at once:
+-- - A raw TCP server. Every connected client receives every byte read from the port and anything
+--   a client sends is written to the port.
+-- - A pseudo-terminal (Unix only). Programs open the slave side, e.g. /dev/pts/5, as if it were
+--   the serial device itself.
+--
+-- Received data is handed to every client as the same implicitly shared QByteArray, so fanning out
+-- to many clients never copies the receive buffer inside dcTerm.
+--
+-- A client that stops reading would otherwise make its socket buffer everything the port receives.
+-- Once a client has more than the backlog limit waiting to be sent it is disconnected; dropping
+-- bytes instead would hand it a stream with silent holes, while a client that is cut off knows to
+-- reconnect.
+--
+-- The bridge only binds to the loopback interface by default so it can be exercised entirely on
+-- localhost (e.g. "nc 127.0.0.1 7000").
+--------------------------------------------------------------------------------------------------*/
+#include "SerialBridge.h"
+
+#ifdef Q_OS_UNIX
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: SerialBridge (QObject*)
+--
+-- NOTES:
+-- Constructor for an idle bridge. Nothing is listening until startTcp or startPty is called.
+--------------------------------------------------------------------------------------------------*/
+SerialBridge::SerialBridge(QObject* parent)
+	: QObject(parent)
+	, mServer(new QTcpServer(this))
+	, mMaxBacklog(MAX_BACKLOG)
+	, mDroppedClients(0)
+	, mPtyMaster(-1)
+	, mPtySlave(-1)
+	, mPtyNotifier(nullptr)
+{
+	connect(mServer, &QTcpServer::newConnection, this, &SerialBridge::acceptClient);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Deconstructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: ~SerialBridge ()
+--
+-- NOTES:
+-- Disconnects every client and releases the pseudo-terminal.
+--------------------------------------------------------------------------------------------------*/
+SerialBridge::~SerialBridge()
+{
+	stop();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: startTcp
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Reset the count of clients dropped for falling behind.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool startTcp (quint16 port, const QHostAddress &address)
+--
+-- RETURNS: bool - true if the server is listening.
+--
+-- NOTES:
+-- Starts a raw TCP server on the given address and port. If a server is already running it is
+-- stopped first and its clients are disconnected.
+--------------------------------------------------------------------------------------------------*/
+bool SerialBridge::startTcp(quint16 port, const QHostAddress &address)
+{
+	stopTcp();
+	mDroppedClients = 0;
+
+	if (!mServer->listen(address, port))
+	{
+		mError = mServer->errorString();
+		return false;
+	}
+
+	emit clientCountChanged(clientCount());
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: startPty
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool startPty (void)
+--
+-- RETURNS: bool - true if a pseudo-terminal was created.
+--
+-- NOTES:
+-- Creates a pseudo-terminal pair in raw mode and watches the master side for data written by
+-- whichever program has the slave side open. The slave path is available from description().
+--
+-- The bridge keeps its own descriptor to the slave side open. Without it Linux reports a hang-up
+-- on the master whenever no program has the slave open, which would wake the notifier endlessly.
+--
+-- Pseudo-terminals are not available on Windows, where this always fails.
+--------------------------------------------------------------------------------------------------*/
+bool SerialBridge::startPty()
+{
+	stopPty();
+
+#ifdef Q_OS_UNIX
+	int master = posix_openpt(O_RDWR | O_NOCTTY);
+	if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0)
+	{
+		mError = QString::fromLocal8Bit(strerror(errno));
+		if (master >= 0)
+		{
+			::close(master);
+		}
+		return false;
+	}
+
+	struct termios tio;
+	if (tcgetattr(master, &tio) == 0)
+	{
+		cfmakeraw(&tio);
+		tcsetattr(master, TCSANOW, &tio);
+	}
+	fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+
+	mPtyMaster = master;
+	mPtyName = QString::fromLocal8Bit(ptsname(master));
+	mPtySlave = ::open(ptsname(master), O_RDWR | O_NOCTTY);
+	mPtyNotifier = new QSocketNotifier(mPtyMaster, QSocketNotifier::Read, this);
+	connect(mPtyNotifier, &QSocketNotifier::activated, this, &SerialBridge::readFromPty);
+
+	emit clientCountChanged(clientCount());
+	return true;
+#else
+	mError = tr("Pseudo-terminals are not supported on this platform.");
+	return false;
+#endif
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: stop
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void stop (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Stops both the TCP server and the pseudo-terminal.
+--------------------------------------------------------------------------------------------------*/
+void SerialBridge::stop()
+{
+	stopTcp();
+	stopPty();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: stopTcp
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void stopTcp (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Closes the listening socket and disconnects every TCP client.
+--------------------------------------------------------------------------------------------------*/
+void SerialBridge::stopTcp()
+{
+	mServer->close();
+
+	QList<QTcpSocket*> clients = mClients;
+	mClients.clear();
+	for (QTcpSocket* client : clients)
+	{
+		client->disconnect(this);
+		client->abort();
+		client->deleteLater();
+	}
+
+	if (!clients.isEmpty())
+	{
+		emit clientCountChanged(clientCount());
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: stopPty
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void stopPty (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Closes the master side of the pseudo-terminal. Programs holding the slave side will see a
+-- hang-up.
+--------------------------------------------------------------------------------------------------*/
+void SerialBridge::stopPty()
+{
+	if (mPtyMaster < 0)
+	{
+		return;
+	}
+
+	delete mPtyNotifier;
+	mPtyNotifier = nullptr;
+#ifdef Q_OS_UNIX
+	if (mPtySlave >= 0)
+	{
+		::close(mPtySlave);
+	}
+	::close(mPtyMaster);
+#endif
+	mPtySlave = -1;
+	mPtyMaster = -1;
+	mPtyName.clear();
+
+	emit clientCountChanged(clientCount());
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setMaxBacklog
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setMaxBacklog (int bytes)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Sets how many bytes may wait to be sent to one TCP client before it is disconnected.
+--------------------------------------------------------------------------------------------------*/
+void SerialBridge::setMaxBacklog(int bytes)
+{
+	mMaxBacklog = qMax(1, bytes);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: maxBacklog
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int maxBacklog (void) const
+--
+-- RETURNS: int - the bytes a TCP client may fall behind before it is disconnected.
+--------------------------------------------------------------------------------------------------*/
+int SerialBridge::maxBacklog() const
+{
+	return mMaxBacklog;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: isActive
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool isActive (void) const
+--
+-- RETURNS: bool - true if either transport is running.
+--------------------------------------------------------------------------------------------------*/
+bool SerialBridge::isActive() const
+{
+	return mServer->isListening() || mPtyMaster >= 0;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: tcpPort
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: quint16 tcpPort (void) const
+--
+-- RETURNS: quint16 - the port the TCP server listens on, or 0 if it is not running.
+--
+-- NOTES:
+-- Useful when startTcp was given port 0 and the system picked a free one.
+--------------------------------------------------------------------------------------------------*/
+quint16 SerialBridge::tcpPort() const
+{
+	return mServer->isListening() ? mServer->serverPort() : 0;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: clientCount
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int clientCount (void) const
+--
+-- RETURNS: int - the number of connected TCP clients.
+--
+-- NOTES:
+-- The pseudo-terminal is not counted since there is no way to tell how many programs have the
+-- slave side open.
+--------------------------------------------------------------------------------------------------*/
+int SerialBridge::clientCount() const
+{
+	return mClients.size();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: droppedClients
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int droppedClients (void) const
+--
+-- RETURNS: int - the number of TCP clients disconnected for falling too far behind.
+--------------------------------------------------------------------------------------------------*/
+int SerialBridge::droppedClients() const
+{
+	return mDroppedClients;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: description
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Show how many clients were disconnected for falling behind.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QString description (void) const
+--
+-- RETURNS: QString - a short summary of the active transports, e.g. "tcp 127.0.0.1:7000".
+--------------------------------------------------------------------------------------------------*/
+QString SerialBridge::description() const
+{
+	QStringList parts;
+	if (mServer->isListening())
+	{
+		QString clients = QString("%1 clients").arg(mClients.size());
+		if (mDroppedClients > 0)
+		{
+			clients += QString(", %1 dropped as too slow").arg(mDroppedClients);
+		}
+		parts << QString("tcp %1:%2 (%3)")
+			.arg(mServer->serverAddress().toString())
+			.arg(mServer->serverPort())
+			.arg(clients);
+	}
+	if (mPtyMaster >= 0)
+	{
+		parts << QString("pty %1").arg(mPtyName);
+	}
+	return parts.join(", ");
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: errorString
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QString errorString (void) const
+--
+-- RETURNS: QString - the reason the last call to startTcp or startPty failed.
+--------------------------------------------------------------------------------------------------*/
+QString SerialBridge::errorString() const
+{
+	return mError;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: broadcast
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Disconnect a client instead of queueing past its backlog limit.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void broadcast (const QByteArray &data)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Sends bytes read from the serial port to every client. Each socket is given the same shared
+-- QByteArray so the data is never copied per client before it reaches the socket. A client that
+-- would have more than the backlog limit waiting is disconnected instead of being written to.
+--
+-- The pseudo-terminal is written without blocking. If nothing is reading the slave side and its
+-- buffer is full, the data is dropped rather than stalling the receive path.
+--------------------------------------------------------------------------------------------------*/
+void SerialBridge::broadcast(const QByteArray &data)
+{
+	if (data.isEmpty())
+	{
+		return;
+	}
+
+	QList<QTcpSocket*> clients = mClients;
+	for (QTcpSocket* client : clients)
+	{
+		if (client->bytesToWrite() + data.size() > mMaxBacklog)
+		{
+			mDroppedClients++;
+			removeClient(client);
+			continue;
+		}
+		client->write(data);
+	}
+
+#ifdef Q_OS_UNIX
+	if (mPtyMaster >= 0)
+	{
+		const char* p = data.constData();
+		qint64 remaining = data.size();
+		while (remaining > 0)
+		{
+			ssize_t n = ::write(mPtyMaster, p, remaining);
+			if (n <= 0)
+			{
+				break;
+			}
+			p += n;
+			remaining -= n;
+		}
+	}
+#endif
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: acceptClient
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void acceptClient (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the TCP server has pending connections.
+--
+-- Low delay is requested on each socket so single keystrokes are not held back by Nagle's
+-- algorithm.
+--------------------------------------------------------------------------------------------------*/
+void SerialBridge::acceptClient()
+{
+	while (mServer->hasPendingConnections())
+	{
+		QTcpSocket* client = mServer->nextPendingConnection();
+		client->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+		connect(client, &QTcpSocket::readyRead, this, &SerialBridge::readFromClient);
+		connect(client, &QTcpSocket::disconnected, this, &SerialBridge::dropClient);
+		mClients.append(client);
+	}
+
+	emit clientCountChanged(clientCount());
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: readFromClient
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void readFromClient (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when a TCP client has sent data.
+--
+-- Forwards everything the client sent so it can be written to the serial port.
+--------------------------------------------------------------------------------------------------*/
+void SerialBridge::readFromClient()
+{
+	QTcpSocket* client = qobject_cast<QTcpSocket*>(QObject::sender());
+	if (client == nullptr)
+	{
+		return;
+	}
+
+	QByteArray data = client->readAll();
+	if (!data.isEmpty())
+	{
+		emit dataFromClient(data);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: dropClient
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Share the clean up with removeClient.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void dropClient (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when a TCP client disconnects.
+--------------------------------------------------------------------------------------------------*/
+void SerialBridge::dropClient()
+{
+	QTcpSocket* client = qobject_cast<QTcpSocket*>(QObject::sender());
+	if (client == nullptr)
+	{
+		return;
+	}
+
+	removeClient(client);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: readFromPty
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void readFromPty (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the master side of the pseudo-terminal is
+-- readable.
+--
+-- Drains the master side and forwards the data so it can be written to the serial port.
+--------------------------------------------------------------------------------------------------*/
+void SerialBridge::readFromPty()
+{
+#ifdef Q_OS_UNIX
+	char buffer[4096];
+	QByteArray data;
+
+	for (;;)
+	{
+		ssize_t n = ::read(mPtyMaster, buffer, sizeof(buffer));
+		if (n <= 0)
+		{
+			break;
+		}
+		data.append(buffer, static_cast<int>(n));
+	}
+
+	if (!data.isEmpty())
+	{
+		emit dataFromClient(data);
+	}
+#endif
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: removeClient
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void removeClient (QTcpSocket* client)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Forgets a TCP client and closes its socket, discarding anything still waiting to be sent. The
+-- socket's signals are disconnected first so the close does not come back through dropClient.
+--------------------------------------------------------------------------------------------------*/
+void SerialBridge::removeClient(QTcpSocket* client)
+{
+	if (!mClients.removeOne(client))
+	{
+		return;
+	}
+
+	client->disconnect(this);
+	client->abort();
+	client->deleteLater();
+	emit clientCountChanged(clientCount());
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHostAddress>
+#include <QList>
+#include <QObject>
+#include <QSocketNotifier>
+#include <QStringList>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+class SerialBridge
+	: public QObject
+{
+	Q_OBJECT
+
+public:
+	static const int MAX_BACKLOG = 4 * 1024 * 1024;
+
+	explicit SerialBridge(QObject *parent = nullptr);
+	~SerialBridge();
+
+	bool startTcp(quint16 port, const QHostAddress &address = QHostAddress::LocalHost);
+	bool startPty();
+	void stop();
+
+	void setMaxBacklog(int bytes);
+	int maxBacklog() const;
+
+	bool isActive() const;
+	quint16 tcpPort() const;
+	int clientCount() const;
+	int droppedClients() const;
+	QString description() const;
+	QString errorString() const;
+
+	void broadcast(const QByteArray &data);
+
+private:
+	QTcpServer* mServer;
+	QList<QTcpSocket*> mClients;
+	int mMaxBacklog;
+	int mDroppedClients;
+
+	int mPtyMaster;
+	int mPtySlave;
+	QString mPtyName;
+	QSocketNotifier* mPtyNotifier;
+
+	QString mError;
+
+	void stopTcp();
+	void stopPty();
+	void removeClient(QTcpSocket* client);
+
+private slots:
+	void acceptClient();
+	void readFromClient();
+	void dropClient();
+	void readFromPty();
+
+signals:
+	void dataFromClient(const QByteArray &data);
+	void clientCountChanged(int count);
+};
@@ -0,0 +1,1877 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: SerialSession.cpp - A serial port connection and everything done with its data.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- int SerialSettings::bitsPerCharacter() const;
+--
+-- void setView(SessionView* view);
+-- void setDevice(QIODevice* device);
+-- QIODevice* device() const;
+-- SerialSettings &settings();
+-- const SerialSettings &settings() const;
+--
+-- bool open();
+-- void close();
+-- bool isOpen() const;
+-- QString errorString() const;
+--
+-- bool startDetection(const QVector<qint32> &bitRates);
+-- void stopDetection();
+-- bool isDetecting() const;
+--
+-- bool setDataTerminalReady(bool set);
+-- bool setRequestToSend(bool set);
+-- bool sendBreak(int milliseconds);
+-- bool isSendingBreak() const;
+-- bool hasControlLines() const;
+-- QSerialPort::PinoutSignals lines() const;
+-- QString lineText(QSerialPort::PinoutSignals lines);
+--
+-- void setDecoder(FrameDecoder* decoder);
+-- FrameDecoder* decoder() const;
+-- void setCrcCheck(bool enabled);
+--
+-- void setEcho(bool enabled);
+-- bool isEchoing() const;
+--
+-- TriggerEngine &triggers();
+--
+-- bool startCapture(const QString &path);
+-- void stopCapture();
+-- bool isCapturing() const;
+-- QString captureFileName() const;
+-- qint64 captureDroppedBytes() const;
+-- QString defaultCaptureName() const;
+--
+-- void setTimingEnabled(bool enabled);
+-- const TimingRecorder &timing() const;
+-- void clearTiming();
+--
+-- void setLatencyEnabled(bool enabled);
+-- LatencyTracker &latency();
+-- const LatencyTracker &latency() const;
+--
+-- const SessionStatistics &statistics() const;
+-- void resetStatistics();
+--
+-- MemoryBudget &budget();
+-- const MemoryBudget &budget() const;
+-- qint64 readBufferLimit() const;
+--
+-- const ByteStore &history() const;
+--
+-- void receive(const QByteArray &data);
+-- void applyCandidate(qint32 bitRate, QSerialPort::DataBits dataBits, QSerialPort::Parity parity);
+-- void applyTuning();
+-- void restoreTuning();
+-- int historyCapacity() const;
+-- void deliver(const char* data, int size, qint64 timestamp, const QTime &time);
+-- void runTrigger(const TriggerRule &rule);
+--
+-- void write(const QByteArray &data);
+-- void readFromPort();
+-- void nextCandidate();
+-- void recordLines(QSerialPort::PinoutSignals lines, qint64 timestamp);
+-- void endBreak();
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- The session owns the port, its settings and the whole receive and transmit path: trigger rules,
+-- capture, timing, framing and statistics. It has no widgets. Whatever shows the data implements
+-- SessionView, which the session calls with each piece of received data or decoded frame and for
+-- the few trigger actions that need a screen. A session without a view still runs every other
+-- stage, which is how scripts are run headless.
+--
+-- Other consumers of the received bytes, such as the bridge and scripts, connect to received(),
+-- which is emitted once per read with the whole chunk.
+--
+-- Everything the session keeps that grows with traffic is charged to its memory budget. Reads go
+-- into blocks recycled from a pool rather than a new buffer per read, and timing recording stops
+-- once it reaches its limit, so a session can stay connected for weeks without creeping.
+--
+-- The most recent received bytes are kept once in the history, sized by its budget, for views
+-- that draw straight from the bytes such as the hex pane.
+--
+-- When latency is measured, each line sent is timed until the device answers it.
+--
+-- With echo on, everything written to the port is also passed to the view as it is sent. Sending
+-- and receiving both run on the session's thread, so the view sees the two directions in the
+-- order they happened without either path waiting on the other.
+--
+-- The session normally talks to its own QSerialPort, but any QIODevice that behaves like an open
+-- port can take its place with setDevice(), e.g. a SimulatedSerialDevice for load testing. The
+-- port settings only apply to a real port.
+--
+-- While the bit rate and framing are being detected, the port is switched through the detector's
+-- candidate settings and what it reads goes only to the detector, since at the wrong settings it
+-- is garbage. A candidate is left as soon as it has enough bytes, or after its dwell time on a
+-- quiet line. The best settings found become the session's settings.
+--
+-- Besides the line settings, a port can be tuned for interactive or bulk use:
+-- - readBufferSize: the most QSerialPort buffers before it stops reading the port, 0 for as much
+--   as the receive memory limit allows. It is never allowed more than that limit.
+-- - lowLatency: on Linux, sets ASYNC_LOW_LATENCY on the port. USB adapters such as FTDI's
+--   otherwise hold received bytes for up to 16 ms to fill a USB packet; with it they pass bytes
+--   on at once, at the cost of more interrupts. The port's flags are put back on close.
+-- - exclusive: on Unix, QSerialPort opens ports with TIOCEXCL so no other program can open them.
+--   Turning this off clears it with TIOCNXCL, e.g. to let a logger share the port.
+-- Neither low latency nor shared access can be set from here on Windows, where the adapter's
+-- latency timer is a driver setting and ports are always opened exclusively.
+--
+-- The receive path is:
+--
+--     read -> timing -> trigger rules -> capture -> decoder or raw display -> received()
+--
+-- Received data is split where each trigger match ends and the rule's action runs between the
+-- pieces, so e.g. a capture started by a rule holds exactly the bytes after the pattern.
+--------------------------------------------------------------------------------------------------*/
+#include <QDateTime>
+
+#ifdef Q_OS_UNIX
+#include <sys/ioctl.h>
+#endif
+#ifdef Q_OS_LINUX
+#include <linux/serial.h>
+#endif
+
+#include "Escape.h"
+#include "SerialSession.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: bitsPerCharacter
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int SerialSettings::bitsPerCharacter (void) const
+--
+-- RETURNS: int - the start, data, parity and stop bits sent for each character.
+--------------------------------------------------------------------------------------------------*/
+int SerialSettings::bitsPerCharacter() const
+{
+	return 1 + dataBits + (parity == QSerialPort::NoParity ? 0 : 1) + (stopBits == QSerialPort::TwoStop ? 2 : 1);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Creates the read pool and the capture file on the session's budget.
+-- October 18, 2026 - Sizes the history from its budget.
+-- October 18, 2026 - Defaults to an unlimited read buffer, low latency off and exclusive access.
+-- October 18, 2026 - Sets up the detection dwell timer.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: SerialSession (QObject*)
+--
+-- NOTES:
+-- Constructor for a closed session with these settings:
+-- - Port Name: NULL
+-- - Baud Rate: 2400 bps
+-- - Data Bits: 8
+-- - Parity: No Parity
+-- - Stop Bits: 1
+-- - Flow Control: Hardware
+--------------------------------------------------------------------------------------------------*/
+SerialSession::SerialSession(QObject* parent)
+	: QObject(parent)
+	, mView(nullptr)
+	, mSavedSerialFlags(-1)
+	, mEcho(false)
+	, mReadPool(READ_BLOCK_SIZE, READ_BLOCKS_KEPT, &mBudget, MemoryBudget::Receive)
+	, mHistory(historyCapacity())
+	, mDecoder(nullptr)
+	, mCrcCheck(false)
+	, mCapture(&mBudget)
+	, mRecordTiming(false)
+	, mMeasureLatency(false)
+{
+	mSettings.portName = "";
+	mSettings.bitRate = 2400;
+	mSettings.dataBits = QSerialPort::Data8;
+	mSettings.parity = QSerialPort::NoParity;
+	mSettings.stopBits = QSerialPort::OneStop;
+	mSettings.flowControl = QSerialPort::HardwareControl;
+	mSettings.readBufferSize = 0;
+	mSettings.lowLatency = false;
+	mSettings.exclusive = true;
+
+	resetStatistics();
+
+	mDetectTimer.setSingleShot(true);
+	connect(&mDetectTimer, &QTimer::timeout, this, &SerialSession::nextCandidate);
+	connect(&mLineMonitor, &ModemLineMonitor::linesChanged, this, &SerialSession::recordLines);
+
+	mBreakTimer.setSingleShot(true);
+	connect(&mBreakTimer, &QTimer::timeout, this, &SerialSession::endBreak);
+
+	mPort = new QSerialPort(this);
+	mDevice = mPort;
+	connect(mPort, &QSerialPort::readyRead, this, &SerialSession::readFromPort);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Deconstructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Deletes a replacement device.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: ~SerialSession ()
+--
+-- NOTES:
+-- Closes the port and deletes the frame decoder.
+--------------------------------------------------------------------------------------------------*/
+SerialSession::~SerialSession()
+{
+	close();
+	delete mDecoder;
+	if (mDevice != mPort)
+	{
+		delete mDevice;
+	}
+	delete mPort;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setView
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setView (SessionView* view)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Sets what received data is shown on. The session does not own the view. nullptr runs the
+-- session without one.
+--------------------------------------------------------------------------------------------------*/
+void SerialSession::setView(SessionView* view)
+{
+	mView = view;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setDevice
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setDevice (QIODevice* device)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Replaces the serial port with device, which the session takes ownership of. The current device
+-- is closed first and a previous replacement is deleted. nullptr goes back to the serial port.
+--------------------------------------------------------------------------------------------------*/
+void SerialSession::setDevice(QIODevice* device)
+{
+	close();
+
+	if (mDevice != mPort)
+	{
+		delete mDevice;
+	}
+
+	if (device == nullptr)
+	{
+		mDevice = mPort;
+		return;
+	}
+
+	device->setParent(this);
+	mDevice = device;
+	connect(mDevice, &QIODevice::readyRead, this, &SerialSession::readFromPort);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: device
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QIODevice* device (void) const
+--
+-- RETURNS: QIODevice* - the device the session reads and writes, the serial port by default.
+--------------------------------------------------------------------------------------------------*/
+QIODevice* SerialSession::device() const
+{
+	return mDevice;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: settings
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: SerialSettings &settings (void)
+--
+-- RETURNS: SerialSettings& - the port settings, applied the next time the port is opened.
+--------------------------------------------------------------------------------------------------*/
+SerialSettings &SerialSession::settings()
+{
+	return mSettings;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: settings
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: const SerialSettings &settings (void) const
+--
+-- RETURNS: const SerialSettings& - the port settings.
+--------------------------------------------------------------------------------------------------*/
+const SerialSettings &SerialSession::settings() const
+{
+	return mSettings;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: open
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Settings are only applied to the serial port, not a replacement device.
+-- October 18, 2026 - Applies the read buffer size, low latency and exclusive access settings.
+-- October 18, 2026 - Starts watching the control lines.
+-- October 18, 2026 - Bounds the read buffer by the receive limit and resizes the receive history
+--     to its limit.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool open (void)
+--
+-- RETURNS: bool - true if the port was opened.
+--
+-- NOTES:
+-- Applies the settings and opens the port for reading and writing. On success the trigger rules'
+-- match state is reset, the timing recorder is told the new character time and the serial port's
+-- control lines are watched. If the history limit has changed since the last connection the
+-- history starts over at the new size.
+--------------------------------------------------------------------------------------------------*/
+bool SerialSession::open()
+{
+	ByteStore history(historyCapacity());
+	if (history.capacity() != mHistory.capacity())
+	{
+		mHistory = history;
+		mBudget.set(MemoryBudget::History, mHistory.memoryUsage());
+	}
+
+	if (mDevice == mPort)
+	{
+		mPort->setPortName(mSettings.portName);
+		mPort->setBaudRate(mSettings.bitRate);
+		mPort->setDataBits(mSettings.dataBits);
+		mPort->setParity(mSettings.parity);
+		mPort->setStopBits(mSettings.stopBits);
+		mPort->setFlowControl(mSettings.flowControl);
+		mPort->setReadBufferSize(readBufferLimit());
+	}
+
+	if (!mDevice->open(QIODevice::ReadWrite))
+	{
+		return false;
+	}
+
+	if (mDevice == mPort)
+	{
+		applyTuning();
+		mLineMonitor.start(mPort);
+	}
+
+	mTriggers.reset();
+	mTiming.setFormat(mSettings.bitRate, mSettings.bitsPerCharacter());
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: close
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Works on whichever device the session is using.
+-- October 18, 2026 - Stops any detection in progress.
+-- October 18, 2026 - Ends any break and stops watching the control lines.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void close (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Flushes anything still waiting to be sent and closes the port if it is open.
+--------------------------------------------------------------------------------------------------*/
+void SerialSession::close()
+{
+	stopDetection();
+	if (mDevice->isOpen())
+	{
+		if (mDevice == mPort)
+		{
+			if (mBreakTimer.isActive())
+			{
+				endBreak();
+			}
+			mLineMonitor.stop();
+			mPort->flush();
+			restoreTuning();
+		}
+		mDevice->close();
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: isOpen
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool isOpen (void) const
+--
+-- RETURNS: bool - true if the port is open.
+--------------------------------------------------------------------------------------------------*/
+bool SerialSession::isOpen() const
+{
+	return mDevice->isOpen();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: errorString
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QString errorString (void) const
+--
+-- RETURNS: QString - the reason the port last failed.
+--------------------------------------------------------------------------------------------------*/
+QString SerialSession::errorString() const
+{
+	return mDevice->errorString();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: startDetection
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool startDetection (const QVector<qint32> &bitRates)
+--
+-- RETURNS: bool - true if detection started, false if the serial port is not open.
+--
+-- NOTES:
+-- Starts trying bitRates, most likely first, with each framing the detector knows on the open
+-- port. detectionFinished() is emitted when the detector has settled.
+--------------------------------------------------------------------------------------------------*/
+bool SerialSession::startDetection(const QVector<qint32> &bitRates)
+{
+	if (mDevice != mPort || !mPort->isOpen() || bitRates.isEmpty())
+	{
+		return false;
+	}
+
+	mDetector.start(bitRates);
+	const BaudCandidate &candidate = mDetector.current();
+	applyCandidate(candidate.bitRate, candidate.dataBits, candidate.parity);
+	mDetectTimer.start(mDetector.dwell());
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: stopDetection
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void stopDetection (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Abandons detection and puts the port back in the session's settings.
+--------------------------------------------------------------------------------------------------*/
+void SerialSession::stopDetection()
+{
+	if (!mDetector.isRunning())
+	{
+		return;
+	}
+
+	mDetector.stop();
+	mDetectTimer.stop();
+	applyCandidate(mSettings.bitRate, mSettings.dataBits, mSettings.parity);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: isDetecting
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool isDetecting (void) const
+--
+-- RETURNS: bool - true while the bit rate and framing are being detected.
+--------------------------------------------------------------------------------------------------*/
+bool SerialSession::isDetecting() const
+{
+	return mDetector.isRunning();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setDataTerminalReady
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool setDataTerminalReady (bool set)
+--
+-- RETURNS: bool - true if DTR was changed.
+--
+-- NOTES:
+-- Raises or drops DTR on the serial port. The change is recorded like a change from the device.
+--------------------------------------------------------------------------------------------------*/
+bool SerialSession::setDataTerminalReady(bool set)
+{
+	if (!hasControlLines() || !mPort->setDataTerminalReady(set))
+	{
+		return false;
+	}
+	mLineMonitor.check(CaptureFile::now());
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setRequestToSend
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool setRequestToSend (bool set)
+--
+-- RETURNS: bool - true if RTS was changed.
+--
+-- NOTES:
+-- Raises or drops RTS on the serial port. With hardware flow control the driver owns RTS, so the
+-- view is told why nothing happened.
+--------------------------------------------------------------------------------------------------*/
+bool SerialSession::setRequestToSend(bool set)
+{
+	if (!hasControlLines())
+	{
+		return false;
+	}
+	if (mPort->flowControl() == QSerialPort::HardwareControl || !mPort->setRequestToSend(set))
+	{
+		if (mView)
+		{
+			mView->showMessage(RTS_FAILED_TEXT);
+		}
+		return false;
+	}
+	mLineMonitor.check(CaptureFile::now());
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: sendBreak
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool sendBreak (int milliseconds)
+--
+-- RETURNS: bool - true if the break was started.
+--
+-- NOTES:
+-- Holds the transmit line in the break condition for milliseconds, as bootloaders expect. The
+-- event loop keeps running meanwhile; endBreak() releases the line. Both ends of the break are
+-- recorded in the capture file.
+--------------------------------------------------------------------------------------------------*/
+bool SerialSession::sendBreak(int milliseconds)
+{
+	if (!hasControlLines() || mBreakTimer.isActive() || !mPort->setBreakEnabled(true))
+	{
+		return false;
+	}
+	mCapture.write(CaptureFile::Event, CaptureFile::now(), BREAK_TEXT.arg(milliseconds).toLatin1());
+	mBreakTimer.start(milliseconds);
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: isSendingBreak
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool isSendingBreak (void) const
+--
+-- RETURNS: bool - true while a break is being held.
+--------------------------------------------------------------------------------------------------*/
+bool SerialSession::isSendingBreak() const
+{
+	return mBreakTimer.isActive();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: hasControlLines
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool hasControlLines (void) const
+--
+-- RETURNS: bool - true if the session is using the serial port and it is open.
+--------------------------------------------------------------------------------------------------*/
+bool SerialSession::hasControlLines() const
+{
+	return mDevice == mPort && mPort->isOpen();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: lines
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QSerialPort::PinoutSignals lines (void) const
+--
+-- RETURNS: QSerialPort::PinoutSignals - the control lines as last seen.
+--------------------------------------------------------------------------------------------------*/
+QSerialPort::PinoutSignals SerialSession::lines() const
+{
+	return mLineMonitor.lines();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: lineText
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: static QString lineText (QSerialPort::PinoutSignals lines)
+--
+-- RETURNS: QString - the state of every control line, such as "CTS=1 DSR=0 DCD=1 RI=0 DTR=1 RTS=1".
+--------------------------------------------------------------------------------------------------*/
+QString SerialSession::lineText(QSerialPort::PinoutSignals lines)
+{
+	return QString("CTS=%1 DSR=%2 DCD=%3 RI=%4 DTR=%5 RTS=%6")
+		.arg(lines.testFlag(QSerialPort::ClearToSendSignal) ? 1 : 0)
+		.arg(lines.testFlag(QSerialPort::DataSetReadySignal) ? 1 : 0)
+		.arg(lines.testFlag(QSerialPort::DataCarrierDetectSignal) ? 1 : 0)
+		.arg(lines.testFlag(QSerialPort::RingIndicatorSignal) ? 1 : 0)
+		.arg(lines.testFlag(QSerialPort::DataTerminalReadySignal) ? 1 : 0)
+		.arg(lines.testFlag(QSerialPort::RequestToSendSignal) ? 1 : 0);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setDecoder
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setDecoder (FrameDecoder* decoder)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Replaces the frame decoder and takes ownership of it. nullptr shows bytes as they arrive. The
+-- CRC setting is carried over to the new decoder.
+--------------------------------------------------------------------------------------------------*/
+void SerialSession::setDecoder(FrameDecoder* decoder)
+{
+	delete mDecoder;
+	mDecoder = decoder;
+
+	if (mDecoder)
+	{
+		mDecoder->setCrcCheck(mCrcCheck);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: decoder
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: FrameDecoder* decoder (void) const
+--
+-- RETURNS: FrameDecoder* - the frame decoder, or nullptr if none is set.
+--------------------------------------------------------------------------------------------------*/
+FrameDecoder* SerialSession::decoder() const
+{
+	return mDecoder;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setCrcCheck
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setCrcCheck (bool enabled)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Saves the setting so it also applies to decoders set later.
+--------------------------------------------------------------------------------------------------*/
+void SerialSession::setCrcCheck(bool enabled)
+{
+	mCrcCheck = enabled;
+	if (mDecoder)
+	{
+		mDecoder->setCrcCheck(enabled);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setEcho
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setEcho (bool enabled)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Turns local echo on or off. With echo on the view is shown what is sent as well as what is
+-- received, for devices that do not echo what they are sent.
+--------------------------------------------------------------------------------------------------*/
+void SerialSession::setEcho(bool enabled)
+{
+	mEcho = enabled;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: isEchoing
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool isEchoing (void) const
+--
+-- RETURNS: bool - true if sent data is shown in the view.
+--------------------------------------------------------------------------------------------------*/
+bool SerialSession::isEchoing() const
+{
+	return mEcho;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: triggers
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: TriggerEngine &triggers (void)
+--
+-- RETURNS: TriggerEngine& - the trigger rules run on received data.
+--------------------------------------------------------------------------------------------------*/
+TriggerEngine &SerialSession::triggers()
+{
+	return mTriggers;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: startCapture
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool startCapture (const QString &path)
+--
+-- RETURNS: bool - true if the capture was started.
+--
+-- NOTES:
+-- Starts recording everything sent and received to path. Errors are shown on the view rather
+-- than returned as text since a trigger rule may have started the capture while nobody is
+-- watching.
+--------------------------------------------------------------------------------------------------*/
+bool SerialSession::startCapture(const QString &path)
+{
+	if (!mCapture.open(path))
+	{
+		if (mView)
+		{
+			mView->showMessage(mCapture.errorString());
+		}
+		return false;
+	}
+
+	emit captureChanged(path);
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: stopCapture
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void stopCapture (void)
+--
+-- RETURNS: void.
+--------------------------------------------------------------------------------------------------*/
+void SerialSession::stopCapture()
+{
+	mCapture.close();
+	emit captureChanged(QString());
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: isCapturing
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool isCapturing (void) const
+--
+-- RETURNS: bool - true if traffic is being recorded.
+--------------------------------------------------------------------------------------------------*/
+bool SerialSession::isCapturing() const
+{
+	return mCapture.isOpen();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: captureFileName
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QString captureFileName (void) const
+--
+-- RETURNS: QString - the path of the current or last capture.
+--------------------------------------------------------------------------------------------------*/
+QString SerialSession::captureFileName() const
+{
+	return mCapture.fileName();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: captureDroppedBytes
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 captureDroppedBytes (void) const
+--
+-- RETURNS: qint64 - the bytes left out of the current or last capture because it went over its
+--          memory limit.
+--------------------------------------------------------------------------------------------------*/
+qint64 SerialSession::captureDroppedBytes() const
+{
+	return mCapture.droppedBytes();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: defaultCaptureName
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QString defaultCaptureName (void) const
+--
+-- RETURNS: QString - a file name for a new capture based on the current time.
+--------------------------------------------------------------------------------------------------*/
+QString SerialSession::defaultCaptureName() const
+{
+	return DEFAULT_CAPTURE_NAME.arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss"));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setTimingEnabled
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setTimingEnabled (bool enabled)
+--
+-- RETURNS: void.
+--------------------------------------------------------------------------------------------------*/
+void SerialSession::setTimingEnabled(bool enabled)
+{
+	mRecordTiming = enabled;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: timing
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: const TimingRecorder &timing (void) const
+--
+-- RETURNS: const TimingRecorder& - the recorded arrival times.
+--------------------------------------------------------------------------------------------------*/
+const TimingRecorder &SerialSession::timing() const
+{
+	return mTiming;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: clearTiming
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Updates the timing budget.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void clearTiming (void)
+--
+-- RETURNS: void.
+--------------------------------------------------------------------------------------------------*/
+void SerialSession::clearTiming()
+{
+	mTiming.clear();
+	mBudget.set(MemoryBudget::Timing, mTiming.memoryUsage());
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setLatencyEnabled
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setLatencyEnabled (bool enabled)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Starts or stops timing how long the device takes to answer each line sent.
+--------------------------------------------------------------------------------------------------*/
+void SerialSession::setLatencyEnabled(bool enabled)
+{
+	mMeasureLatency = enabled;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: latency
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: LatencyTracker &latency (void)
+--
+-- RETURNS: LatencyTracker & - the answer latencies measured, for changing how answers are found.
+--------------------------------------------------------------------------------------------------*/
+LatencyTracker &SerialSession::latency()
+{
+	return mLatency;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: latency
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: const LatencyTracker &latency (void) const
+--
+-- RETURNS: const LatencyTracker & - the answer latencies measured.
+--------------------------------------------------------------------------------------------------*/
+const LatencyTracker &SerialSession::latency() const
+{
+	return mLatency;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: statistics
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: const SessionStatistics &statistics (void) const
+--
+-- RETURNS: const SessionStatistics& - the traffic counters since the last reset.
+--------------------------------------------------------------------------------------------------*/
+const SessionStatistics &SerialSession::statistics() const
+{
+	return mStatistics;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: resetStatistics
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void resetStatistics (void)
+--
+-- RETURNS: void.
+--------------------------------------------------------------------------------------------------*/
+void SerialSession::resetStatistics()
+{
+	mStatistics = SessionStatistics();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: budget
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: MemoryBudget &budget (void)
+--
+-- RETURNS: MemoryBudget& - the memory budget of the session, which the view also charges its
+--                          scrollback and highlight cache to.
+--------------------------------------------------------------------------------------------------*/
+MemoryBudget &SerialSession::budget()
+{
+	return mBudget;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: budget
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: const MemoryBudget &budget (void) const
+--
+-- RETURNS: const MemoryBudget& - the memory budget of the session.
+--------------------------------------------------------------------------------------------------*/
+const MemoryBudget &SerialSession::budget() const
+{
+	return mBudget;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: readBufferLimit
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 readBufferLimit (void) const
+--
+-- RETURNS: qint64 - the read buffer size the serial port is given when it is opened.
+--
+-- NOTES:
+-- The receive budget covers the read blocks and what QSerialPort holds for them, so the port gets
+-- whatever the blocks kept by the read pool leave of the limit, or the tuned size if that is
+-- smaller. Once the buffer is full QSerialPort stops reading and the port's flow control holds off
+-- the sender, instead of the buffer growing without bound while the session falls behind.
+--------------------------------------------------------------------------------------------------*/
+qint64 SerialSession::readBufferLimit() const
+{
+	qint64 room = qMax<qint64>(READ_BLOCK_SIZE,
+		mBudget.limit(MemoryBudget::Receive) - static_cast<qint64>(READ_BLOCK_SIZE) * READ_BLOCKS_KEPT);
+	if (mSettings.readBufferSize > 0)
+	{
+		return qMin(mSettings.readBufferSize, room);
+	}
+	return room;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: history
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: const ByteStore &history (void) const
+--
+-- RETURNS: const ByteStore& - the most recent received bytes.
+--------------------------------------------------------------------------------------------------*/
+const ByteStore &SerialSession::history() const
+{
+	return mHistory;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: write
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Passes the data to the view when echo is on.
+-- October 18, 2026 - Starts a latency measurement for each line sent.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void write (const QByteArray &data)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is the single path for everything sent to the port, whether
+-- typed, from a bridge client, from a script or from a trigger rule. The data is also recorded in
+-- the capture file and, with echo on, shown in the view.
+--------------------------------------------------------------------------------------------------*/
+void SerialSession::write(const QByteArray &data)
+{
+	qint64 timestamp = CaptureFile::now();
+	mDevice->write(data);
+	mCapture.write(CaptureFile::Transmitted, timestamp, data);
+
+	if (mMeasureLatency)
+	{
+		mLatency.sent(timestamp, data.constData(), data.size());
+	}
+
+	if (mEcho && mView && !data.isEmpty())
+	{
+		mView->displayTransmitted(data.constData(), data.size(), QTime::currentTime());
+	}
+
+	mStatistics.writes++;
+	mStatistics.bytesSent += data.size();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: readFromPort
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Reads from whichever device the session is using.
+-- October 18, 2026 - Reads into blocks from the read pool instead of a new buffer per read.
+-- October 18, 2026 - Hands what is read to the detector while detecting.
+-- October 18, 2026 - No longer clears the port's input after reading, which threw away whatever
+--     the driver received between the read and the clear.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void readFromPort (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the device emits readyRead.
+--
+-- Reads everything waiting on the port into a pooled block and passes it down the receive path,
+-- a block at a time. While detecting, the blocks are only scored and the next candidate is tried
+-- as soon as this one has enough. What waits in QSerialPort is not charged here: reading it only
+-- frees memory, and its size is bounded when the port is opened by readBufferLimit().
+--------------------------------------------------------------------------------------------------*/
+void SerialSession::readFromPort()
+{
+	QByteArray block = mReadPool.acquire();
+	while (mDevice->bytesAvailable() > 0)
+	{
+		block.resize(static_cast<int>(qMin<qint64>(mDevice->bytesAvailable(), mReadPool.blockSize())));
+		qint64 size = mDevice->read(block.data(), block.size());
+		if (size <= 0)
+		{
+			break;
+		}
+		block.resize(static_cast<int>(size));
+		if (mDetector.isRunning())
+		{
+			mDetector.feed(block.constData(), block.size());
+		}
+		else
+		{
+			receive(block);
+		}
+	}
+	mReadPool.release(block);
+
+	if (mDetector.hasEnough())
+	{
+		nextCandidate();
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: nextCandidate
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Gives the timing recorder the detected bit rate and framing.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void nextCandidate (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when a candidate's dwell time is up, or called once
+-- it has enough bytes.
+--
+-- Moves the port to the next candidate. When the detector has settled, the best settings it found
+-- become the session's settings, the port is put in the session's settings, the timing recorder
+-- is told the character time they give and detectionFinished() is emitted.
+--------------------------------------------------------------------------------------------------*/
+void SerialSession::nextCandidate()
+{
+	if (!mDetector.isRunning())
+	{
+		return;
+	}
+
+	if (mDetector.advance())
+	{
+		const BaudCandidate &candidate = mDetector.current();
+		applyCandidate(candidate.bitRate, candidate.dataBits, candidate.parity);
+		mDetectTimer.start(mDetector.dwell());
+		return;
+	}
+
+	mDetectTimer.stop();
+	bool found = mDetector.found();
+	if (found)
+	{
+		BaudCandidate best = mDetector.best();
+		mSettings.bitRate = best.bitRate;
+		mSettings.dataBits = best.dataBits;
+		mSettings.parity = best.parity;
+	}
+	applyCandidate(mSettings.bitRate, mSettings.dataBits, mSettings.parity);
+	mTiming.setFormat(mSettings.bitRate, mSettings.bitsPerCharacter());
+	emit detectionFinished(found);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: recordLines
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void recordLines (QSerialPort::PinoutSignals lines, qint64 timestamp)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the line monitor sees the control lines
+-- change.
+--
+-- Writes the new state to the capture file as an event, adds it to the timing recording and
+-- passes it on with linesChanged().
+--------------------------------------------------------------------------------------------------*/
+void SerialSession::recordLines(QSerialPort::PinoutSignals lines, qint64 timestamp)
+{
+	mCapture.write(CaptureFile::Event, timestamp, lineText(lines).toLatin1());
+
+	if (mRecordTiming)
+	{
+		mTiming.recordLines(timestamp, static_cast<quint32>(lines));
+		mBudget.set(MemoryBudget::Timing, mTiming.memoryUsage());
+	}
+
+	emit linesChanged(lines);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: endBreak
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void endBreak (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the break time is up, or called when the port
+-- is closed during a break.
+--------------------------------------------------------------------------------------------------*/
+void SerialSession::endBreak()
+{
+	mBreakTimer.stop();
+	if (mPort->isOpen())
+	{
+		mPort->setBreakEnabled(false);
+	}
+	mCapture.write(CaptureFile::Event, CaptureFile::now(), BREAK_END_TEXT.toLatin1());
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: receive
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Charges recorded timing to the budget and stops recording at its limit.
+-- October 18, 2026 - Keeps the data in the history.
+-- October 18, 2026 - Passes the data to the latency measurement.
+-- October 18, 2026 - Also stops recording timing when the session's total limit is reached.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void receive (const QByteArray &data)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Runs one chunk of received data through the receive path as if it had just been read from the
+-- port. Public so the path can be driven and measured without a port.
+--------------------------------------------------------------------------------------------------*/
+void SerialSession::receive(const QByteArray &data)
+{
+	if (data.isEmpty())
+	{
+		return;
+	}
+
+	qint64 timestamp = CaptureFile::now();
+	QTime time = QTime::currentTime();
+
+	mStatistics.reads++;
+	mStatistics.bytesReceived += data.size();
+
+	mHistory.append(data.constData(), data.size());
+	mBudget.set(MemoryBudget::History, mHistory.memoryUsage());
+
+	if (mMeasureLatency)
+	{
+		mLatency.received(timestamp, data.constData(), data.size());
+	}
+
+	if (mRecordTiming)
+	{
+		mTiming.record(timestamp, data.size());
+		mBudget.set(MemoryBudget::Timing, mTiming.memoryUsage());
+		if (mBudget.exceeded(MemoryBudget::Timing) || mBudget.totalExceeded())
+		{
+			mRecordTiming = false;
+			if (mView)
+			{
+				mView->showMessage(TIMING_STOPPED_TEXT);
+			}
+			emit timingStopped();
+		}
+	}
+
+	mMatches.clear();
+	if (!mTriggers.isEmpty())
+	{
+		mTriggers.process(data.constData(), data.size(), mMatches);
+		mStatistics.triggerMatches += mMatches.size();
+	}
+
+	int start = 0;
+	for (const TriggerMatch &match : mMatches)
+	{
+		deliver(data.constData() + start, match.end - start, timestamp, time);
+		start = match.end;
+		runTrigger(mTriggers.rules()[match.rule]);
+	}
+	deliver(data.constData() + start, data.size() - start, timestamp, time);
+
+	emit received(data);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: applyCandidate
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void applyCandidate (qint32 bitRate, QSerialPort::DataBits dataBits,
+--                                 QSerialPort::Parity parity)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Changes the open port's bit rate and framing and drops anything read under the old settings.
+--------------------------------------------------------------------------------------------------*/
+void SerialSession::applyCandidate(qint32 bitRate, QSerialPort::DataBits dataBits, QSerialPort::Parity parity)
+{
+	if (!mPort->isOpen())
+	{
+		return;
+	}
+
+	mPort->setBaudRate(bitRate);
+	mPort->setDataBits(dataBits);
+	mPort->setParity(parity);
+	mPort->clear(QSerialPort::Input);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: applyTuning
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void applyTuning (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Applies the low latency and exclusive access settings to the port just opened. The port's
+-- serial flags are saved before they are changed so restoreTuning() can put them back. A setting
+-- the port or platform cannot take is reported to the view and the port is left open without it.
+--------------------------------------------------------------------------------------------------*/
+void SerialSession::applyTuning()
+{
+	bool lowLatencyFailed = mSettings.lowLatency;
+	bool sharedFailed = !mSettings.exclusive;
+
+#ifdef Q_OS_UNIX
+	int descriptor = static_cast<int>(mPort->handle());
+
+#ifdef Q_OS_LINUX
+	struct serial_struct serial;
+	if (mSettings.lowLatency && ::ioctl(descriptor, TIOCGSERIAL, &serial) == 0)
+	{
+		int flags = serial.flags;
+		serial.flags |= ASYNC_LOW_LATENCY;
+		if (::ioctl(descriptor, TIOCSSERIAL, &serial) == 0)
+		{
+			mSavedSerialFlags = flags;
+			lowLatencyFailed = false;
+		}
+	}
+#endif
+
+	if (!mSettings.exclusive && ::ioctl(descriptor, TIOCNXCL) == 0)
+	{
+		sharedFailed = false;
+	}
+#endif
+
+	if (mView && lowLatencyFailed)
+	{
+		mView->showMessage(LOW_LATENCY_FAILED_TEXT);
+	}
+	if (mView && sharedFailed)
+	{
+		mView->showMessage(SHARED_ACCESS_FAILED_TEXT);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: restoreTuning
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void restoreTuning (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Puts back the serial flags saved by applyTuning(), before the port is closed. The low latency
+-- flag belongs to the driver and outlives the port being open, so other programs would otherwise
+-- find the port left in low latency mode.
+--------------------------------------------------------------------------------------------------*/
+void SerialSession::restoreTuning()
+{
+#ifdef Q_OS_LINUX
+	if (mSavedSerialFlags >= 0)
+	{
+		int descriptor = static_cast<int>(mPort->handle());
+		struct serial_struct serial;
+		if (::ioctl(descriptor, TIOCGSERIAL, &serial) == 0)
+		{
+			serial.flags = mSavedSerialFlags;
+			::ioctl(descriptor, TIOCSSERIAL, &serial);
+		}
+	}
+#endif
+	mSavedSerialFlags = -1;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: historyCapacity
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int historyCapacity (void) const
+--
+-- RETURNS: int - how many bytes the history is asked to hold.
+--
+-- NOTES:
+-- The history is charged its ring and its line index, so the ring is given what the index leaves
+-- of the history limit. ByteStore rounds that down to a power of two, so the history stays within
+-- its limit but may use as little as half of it, e.g. 512 KB of the default 1 MB.
+--------------------------------------------------------------------------------------------------*/
+int SerialSession::historyCapacity() const
+{
+	qint64 index = static_cast<qint64>(ByteStore::LINE_INDEX_SIZE) * sizeof(qint64);
+	return static_cast<int>(qMax<qint64>(1, mBudget.limit(MemoryBudget::History) - index));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: deliver
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void deliver (const char* data, int size, qint64 timestamp, const QTime &time)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Records a piece of received data in the capture file and passes it to the view, through the
+-- frame decoder if one is set. Decoded frames are stamped with time and counted even when there
+-- is no view.
+--------------------------------------------------------------------------------------------------*/
+void SerialSession::deliver(const char* data, int size, qint64 timestamp, const QTime &time)
+{
+	if (size <= 0)
+	{
+		return;
+	}
+
+	mCapture.write(CaptureFile::Received, timestamp, data, size);
+
+	if (mDecoder)
+	{
+		mDecoder->feed(data, size,
+			[this, &time](const char* frame, int length, FrameDecoder::FrameStatus status)
+		{
+			mStatistics.frames++;
+			if (status != FrameDecoder::FrameOk)
+			{
+				mStatistics.frameErrors++;
+			}
+			if (mView)
+			{
+				mView->displayFrame(frame, length, status, time);
+			}
+		});
+	}
+	else if (mView)
+	{
+		mView->displayData(data, size);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: runTrigger
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void runTrigger (const TriggerRule &rule)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Carries out the action of a matched trigger rule:
+-- - send: writes the argument, with escapes, to the port.
+-- - highlight: highlights the current line in the argument color (default yellow).
+-- - capture-start: starts a capture to the argument path, or to a time stamped file if empty. A
+--   capture already running is left alone.
+-- - capture-stop: stops the capture.
+-- - beep: sounds the system bell.
+--------------------------------------------------------------------------------------------------*/
+void SerialSession::runTrigger(const TriggerRule &rule)
+{
+	switch (rule.action)
+	{
+	case TriggerRule::Send:
+		write(unescape(rule.argument));
+		break;
+	case TriggerRule::Highlight:
+		if (mView)
+		{
+			mView->highlightLine(rule.argument.isEmpty() ? QString("yellow") : rule.argument);
+		}
+		break;
+	case TriggerRule::StartCapture:
+		if (!mCapture.isOpen())
+		{
+			startCapture(rule.argument.isEmpty() ? defaultCaptureName() : rule.argument);
+		}
+		break;
+	case TriggerRule::StopCapture:
+		stopCapture();
+		break;
+	case TriggerRule::Beep:
+		if (mView)
+		{
+			mView->beep();
+		}
+		break;
+	}
+}
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QObject>
+#include <QSerialPort>
+#include <QString>
+#include <QTime>
+#include <QTimer>
+#include <QVector>
+
+#include "BaudDetector.h"
+#include "BlockPool.h"
+#include "ByteStore.h"
+#include "CaptureFile.h"
+#include "FrameDecoder.h"
+#include "LatencyTracker.h"
+#include "MemoryBudget.h"
+#include "ModemLineMonitor.h"
+#include "TimingRecorder.h"
+#include "TriggerEngine.h"
+
+struct SerialSettings
+{
+	QString portName;
+	qint32 bitRate;
+	QSerialPort::DataBits dataBits;
+	QSerialPort::Parity parity;
+	QSerialPort::StopBits stopBits;
+	QSerialPort::FlowControl flowControl;
+
+	qint64 readBufferSize;
+	bool lowLatency;
+	bool exclusive;
+
+	int bitsPerCharacter() const;
+};
+
+struct SessionStatistics
+{
+	qint64 bytesReceived;
+	qint64 bytesSent;
+	qint64 reads;
+	qint64 writes;
+	qint64 frames;
+	qint64 frameErrors;
+	qint64 triggerMatches;
+};
+
+class SessionView
+{
+public:
+	virtual ~SessionView() {}
+
+	virtual void displayData(const char* data, int size) = 0;
+	virtual void displayFrame(const char* data, int length, FrameDecoder::FrameStatus status, const QTime &time) = 0;
+	virtual void displayTransmitted(const char* data, int size, const QTime &time) = 0;
+	virtual void highlightLine(const QString &color) = 0;
+	virtual void beep() = 0;
+	virtual void showMessage(const QString &message) = 0;
+};
+
+class SerialSession
+	: public QObject
+{
+	Q_OBJECT
+
+public:
+	static const int READ_BLOCK_SIZE = 64 * 1024;
+	static const int READ_BLOCKS_KEPT = 2;
+
+	explicit SerialSession(QObject *parent = nullptr);
+	~SerialSession();
+
+	void setView(SessionView* view);
+
+	void setDevice(QIODevice* device);
+	QIODevice* device() const;
+
+	SerialSettings &settings();
+	const SerialSettings &settings() const;
+
+	bool open();
+	void close();
+	bool isOpen() const;
+	QString errorString() const;
+
+	bool startDetection(const QVector<qint32> &bitRates);
+	void stopDetection();
+	bool isDetecting() const;
+
+	bool setDataTerminalReady(bool set);
+	bool setRequestToSend(bool set);
+	bool sendBreak(int milliseconds);
+	bool isSendingBreak() const;
+	bool hasControlLines() const;
+	QSerialPort::PinoutSignals lines() const;
+	static QString lineText(QSerialPort::PinoutSignals lines);
+
+	void setDecoder(FrameDecoder* decoder);
+	FrameDecoder* decoder() const;
+	void setCrcCheck(bool enabled);
+
+	void setEcho(bool enabled);
+	bool isEchoing() const;
+
+	TriggerEngine &triggers();
+
+	bool startCapture(const QString &path);
+	void stopCapture();
+	bool isCapturing() const;
+	QString captureFileName() const;
+	qint64 captureDroppedBytes() const;
+	QString defaultCaptureName() const;
+
+	void setTimingEnabled(bool enabled);
+	const TimingRecorder &timing() const;
+	void clearTiming();
+
+	void setLatencyEnabled(bool enabled);
+	LatencyTracker &latency();
+	const LatencyTracker &latency() const;
+
+	const SessionStatistics &statistics() const;
+	void resetStatistics();
+
+	MemoryBudget &budget();
+	const MemoryBudget &budget() const;
+	qint64 readBufferLimit() const;
+
+	const ByteStore &history() const;
+
+	void receive(const QByteArray &data);
+
+private:
+	const QString DEFAULT_CAPTURE_NAME = "capture-%1.dcap";
+	const QString TIMING_STOPPED_TEXT = "Timing recording stopped: its memory limit was reached.";
+	const QString LOW_LATENCY_FAILED_TEXT = "This port does not support low latency mode.";
+	const QString SHARED_ACCESS_FAILED_TEXT = "This port could not be opened for shared access.";
+	const QString RTS_FAILED_TEXT = "RTS is driven by hardware flow control and cannot be set.";
+	const QString BREAK_TEXT = "BREAK %1 ms";
+	const QString BREAK_END_TEXT = "BREAK end";
+
+	QSerialPort* mPort;
+	QIODevice* mDevice;
+	SerialSettings mSettings;
+	SessionView* mView;
+	int mSavedSerialFlags;
+
+	BaudDetector mDetector;
+	QTimer mDetectTimer;
+	ModemLineMonitor mLineMonitor;
+	QTimer mBreakTimer;
+	bool mEcho;
+
+	MemoryBudget mBudget;
+	BlockPool mReadPool;
+	ByteStore mHistory;
+
+	FrameDecoder* mDecoder;
+	bool mCrcCheck;
+
+	TriggerEngine mTriggers;
+	QVector<TriggerMatch> mMatches;
+
+	CaptureFile mCapture;
+
+	TimingRecorder mTiming;
+	bool mRecordTiming;
+
+	LatencyTracker mLatency;
+	bool mMeasureLatency;
+
+	SessionStatistics mStatistics;
+
+	void applyCandidate(qint32 bitRate, QSerialPort::DataBits dataBits, QSerialPort::Parity parity);
+	void applyTuning();
+	void restoreTuning();
+	int historyCapacity() const;
+	void deliver(const char* data, int size, qint64 timestamp, const QTime &time);
+	void runTrigger(const TriggerRule &rule);
+
+public slots:
+	void write(const QByteArray &data);
+
+private slots:
+	void readFromPort();
+	void nextCandidate();
+	void recordLines(QSerialPort::PinoutSignals lines, qint64 timestamp);
+	void endBreak();
+
+signals:
+	void received(const QByteArray &data);
+	void captureChanged(const QString &fileName);
+	void timingStopped();
+	void detectionFinished(bool found);
+	void linesChanged(QSerialPort::PinoutSignals lines);
+};
@@ -0,0 +1,1116 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: SimulatedSerialDevice.cpp - A serial port that exists only in software.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- bool configure(const QString &spec, QString* error);
+-- QString description() const;
+--
+-- void setMode(Mode mode);
+-- void setRate(qint64 bytesPerSecond);
+-- void setPattern(const QByteArray &pattern);
+-- bool loadReplay(const QString &path, QString* error, double from);
+-- void setSpeed(double speed);
+-- void setParityErrorRate(double rate);
+-- void setFramingErrorRate(double rate);
+-- void setReaderRate(qint64 bytesPerSecond);
+-- void setLoopback(bool enabled);
+--
+-- qint64 bytesGenerated() const;
+-- qint64 errorsInjected() const;
+-- qint64 overruns() const;
+--
+-- bool open(OpenMode mode);
+-- void close();
+-- bool isSequential() const;
+-- qint64 bytesAvailable() const;
+-- qint64 bytesToWrite() const;
+-- qint64 readData(char* data, qint64 maxSize);
+-- qint64 writeData(const char* data, qint64 size);
+--
+-- int generate(qint64 elapsed, double seconds);
+-- void injectErrors(char* data, int size);
+-- int drainWrites(double seconds);
+-- void deliver(const char* data, int size);
+-- quint32 nextRandom();
+-- qint64 nextErrorGap(double rate);
+-- void tick();
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- A QIODevice that behaves like an open serial port so the whole receive path can be loaded and
+-- measured without hardware. SerialSession uses it in place of its QSerialPort.
+--
+-- Received traffic is one of:
+-- - random bytes at a set rate,
+-- - a repeated pattern at a set rate,
+-- - the received records of a capture file, replayed with their recorded timing (scaled by a
+--   speed factor) and looped at the end.
+--
+-- A timer ticks every TICK_INTERVAL milliseconds and generates however many bytes the rate owes
+-- since the last tick, so rates of tens of MB/s arrive as a few large chunks per millisecond just
+-- as they would from a fast USB adapter. If the reader falls more than MAX_BUFFER bytes behind,
+-- new bytes are dropped and counted as overruns, like a UART FIFO overflowing.
+--
+-- Errors are injected at a chosen probability per byte. A parity error flips one bit of the byte
+-- and a framing error replaces it with a zero byte, which is what most drivers deliver. Error
+-- positions are drawn from a geometric distribution so the cost does not depend on the rate.
+--
+-- Bytes written to the device are consumed at the reader rate, emulating a slow device on the
+-- other end; until then they count in bytesToWrite(). In loopback mode consumed bytes are
+-- received back.
+--
+-- configure() takes the same settings as a comma separated string, e.g.
+--
+--     mode=random,rate=1000000,parity=0.0001
+--     mode=pattern,pattern=Hello\r\n,rate=11520,reader=960
+--     mode=replay,file=boot.dcap,speed=10
+--     mode=replay,file=soak.dcap,from=3600
+--
+-- Keys are mode, rate, pattern, file, from, speed, parity, framing, reader and loopback. A pattern
+-- may use the escapes understood by unescape(); a comma is written \x2c. from is how many seconds
+-- into the capture to start the replay.
+--------------------------------------------------------------------------------------------------*/
+#include <cmath>
+#include <cstring>
+
+#include <QStringList>
+
+#include "CaptureReader.h"
+#include "Escape.h"
+#include "SimulatedSerialDevice.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: SimulatedSerialDevice (QObject*)
+--
+-- NOTES:
+-- Constructor for a closed device sending random bytes at 11520 bytes per second, the speed of a
+-- 115200 baud line, with no errors and a reader that keeps up.
+--------------------------------------------------------------------------------------------------*/
+SimulatedSerialDevice::SimulatedSerialDevice(QObject* parent)
+	: QIODevice(parent)
+	, mMode(Random)
+	, mRate(11520)
+	, mPattern("dcTerm simulated device\r\n")
+	, mPatternPosition(0)
+	, mSpeed(1.0)
+	, mParityErrorRate(0.0)
+	, mFramingErrorRate(0.0)
+	, mReaderRate(0)
+	, mLoopback(false)
+	, mReplayPosition(0)
+	, mReplayStart(0)
+	, mLastTick(0)
+	, mReadCredit(0.0)
+	, mWriteCredit(0.0)
+	, mRandom(2463534242u)
+	, mNextParityError(0)
+	, mNextFramingError(0)
+	, mGenerated(0)
+	, mErrors(0)
+	, mOverruns(0)
+{
+	mTimer.setTimerType(Qt::PreciseTimer);
+	mTimer.setInterval(TICK_INTERVAL);
+	connect(&mTimer, &QTimer::timeout, this, &SimulatedSerialDevice::tick);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: configure
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Use Qt::SkipEmptyParts on Qt 5.14 and later, where the QString one is
+--     deprecated.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool configure (const QString &spec, QString* error)
+--
+-- RETURNS: bool - true if every setting in spec was understood.
+--
+-- NOTES:
+-- Applies the settings in spec, described at the top of this file. Settings not mentioned keep
+-- their current values. Giving a pattern or file without a mode selects the matching mode.
+--------------------------------------------------------------------------------------------------*/
+bool SimulatedSerialDevice::configure(const QString &spec, QString* error)
+{
+	QString mode;
+	QString file;
+	double from = 0;
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+	const QStringList fields = spec.split(',', Qt::SkipEmptyParts);
+#else
+	const QStringList fields = spec.split(',', QString::SkipEmptyParts);
+#endif
+	for (const QString &field : fields)
+	{
+		int equals = field.indexOf('=');
+		QString key = field.left(equals).trimmed().toLower();
+		QString value = equals < 0 ? QString() : field.mid(equals + 1);
+		bool ok = true;
+
+		if (key == "mode")
+		{
+			mode = value.trimmed().toLower();
+		}
+		else if (key == "rate")
+		{
+			setRate(value.toLongLong(&ok));
+		}
+		else if (key == "pattern")
+		{
+			setPattern(unescape(value));
+			if (mode.isEmpty())
+			{
+				mode = "pattern";
+			}
+		}
+		else if (key == "file")
+		{
+			file = value.trimmed();
+			if (mode.isEmpty())
+			{
+				mode = "replay";
+			}
+		}
+		else if (key == "from")
+		{
+			from = value.toDouble(&ok);
+		}
+		else if (key == "speed")
+		{
+			setSpeed(value.toDouble(&ok));
+		}
+		else if (key == "parity")
+		{
+			setParityErrorRate(value.toDouble(&ok));
+		}
+		else if (key == "framing")
+		{
+			setFramingErrorRate(value.toDouble(&ok));
+		}
+		else if (key == "reader")
+		{
+			setReaderRate(value.toLongLong(&ok));
+		}
+		else if (key == "loopback")
+		{
+			setLoopback(value.toInt(&ok) != 0);
+		}
+		else
+		{
+			*error = QString("Unknown setting \"%1\".").arg(key);
+			return false;
+		}
+
+		if (!ok)
+		{
+			*error = QString("Invalid value \"%1\" for %2.").arg(value).arg(key);
+			return false;
+		}
+	}
+
+	if (mode == "random")
+	{
+		setMode(Random);
+	}
+	else if (mode == "pattern")
+	{
+		setMode(Pattern);
+	}
+	else if (mode == "replay")
+	{
+		if (file.isEmpty())
+		{
+			*error = "Replay needs a capture file, e.g. file=capture.dcap.";
+			return false;
+		}
+		if (!loadReplay(file, error, from))
+		{
+			return false;
+		}
+		setMode(Replay);
+	}
+	else if (!mode.isEmpty())
+	{
+		*error = QString("Unknown mode \"%1\".").arg(mode);
+		return false;
+	}
+
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: description
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QString description (void) const
+--
+-- RETURNS: QString - a short description for the status bar.
+--------------------------------------------------------------------------------------------------*/
+QString SimulatedSerialDevice::description() const
+{
+	switch (mMode)
+	{
+	case Random:
+		return QString("Simulated random %1 B/s").arg(mRate);
+	case Pattern:
+		return QString("Simulated pattern %1 B/s").arg(mRate);
+	case Replay:
+		return QString("Simulated replay x%1").arg(mSpeed);
+	}
+	return QString();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setMode
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setMode (Mode mode)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Replay mode needs a capture loaded with loadReplay() first.
+--------------------------------------------------------------------------------------------------*/
+void SimulatedSerialDevice::setMode(Mode mode)
+{
+	mMode = mode;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setRate
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setRate (qint64 bytesPerSecond)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Sets how fast random and pattern traffic is received.
+--------------------------------------------------------------------------------------------------*/
+void SimulatedSerialDevice::setRate(qint64 bytesPerSecond)
+{
+	mRate = qMax<qint64>(0, bytesPerSecond);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setPattern
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setPattern (const QByteArray &pattern)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Sets the bytes repeated in pattern mode. An empty pattern is ignored.
+--------------------------------------------------------------------------------------------------*/
+void SimulatedSerialDevice::setPattern(const QByteArray &pattern)
+{
+	if (!pattern.isEmpty())
+	{
+		mPattern = pattern;
+		mPatternPosition = 0;
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: loadReplay
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Reads the capture with CaptureReader.
+-- October 18, 2026 - Can start part way into the capture.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool loadReplay (const QString &path, QString* error, double from)
+--
+-- RETURNS: bool - true if the capture was read and holds received data.
+--
+-- NOTES:
+-- Reads the received records of a capture file, from the given number of seconds into it, into
+-- memory. Each record keeps its time relative to the first one so it can be replayed with the same
+-- spacing. A compressed capture seeks straight to the block holding the start.
+--------------------------------------------------------------------------------------------------*/
+bool SimulatedSerialDevice::loadReplay(const QString &path, QString* error, double from)
+{
+	CaptureReader reader;
+	if (!reader.open(path, error))
+	{
+		return false;
+	}
+	if (from > 0)
+	{
+		reader.seek(reader.startTime() + static_cast<qint64>(from * 1000000));
+	}
+
+	mReplayData.clear();
+	mReplayRecords.clear();
+
+	CaptureRecord record;
+	qint64 first = -1;
+	while (reader.next(record))
+	{
+		if (record.direction == CaptureFile::Received && !record.data.isEmpty())
+		{
+			if (first < 0)
+			{
+				first = record.timestamp;
+			}
+			ReplayRecord replay = { record.timestamp - first, mReplayData.size(), record.data.size() };
+			mReplayRecords.append(replay);
+			mReplayData.append(record.data);
+		}
+	}
+
+	if (mReplayRecords.isEmpty())
+	{
+		*error = QString("%1 holds no received data.").arg(path);
+		return false;
+	}
+
+	mReplayPosition = 0;
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setSpeed
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setSpeed (double speed)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Sets how many times faster than recorded a capture is replayed.
+--------------------------------------------------------------------------------------------------*/
+void SimulatedSerialDevice::setSpeed(double speed)
+{
+	mSpeed = speed > 0.0 ? speed : 1.0;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setParityErrorRate
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setParityErrorRate (double rate)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Sets the probability that a received byte has a bit flipped.
+--------------------------------------------------------------------------------------------------*/
+void SimulatedSerialDevice::setParityErrorRate(double rate)
+{
+	mParityErrorRate = qBound(0.0, rate, 1.0);
+	mNextParityError = nextErrorGap(mParityErrorRate);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setFramingErrorRate
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setFramingErrorRate (double rate)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Sets the probability that a received byte is replaced by a zero byte.
+--------------------------------------------------------------------------------------------------*/
+void SimulatedSerialDevice::setFramingErrorRate(double rate)
+{
+	mFramingErrorRate = qBound(0.0, rate, 1.0);
+	mNextFramingError = nextErrorGap(mFramingErrorRate);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setReaderRate
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setReaderRate (qint64 bytesPerSecond)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Sets how fast the simulated device consumes what is written to it. 0 consumes everything on the
+-- next tick.
+--------------------------------------------------------------------------------------------------*/
+void SimulatedSerialDevice::setReaderRate(qint64 bytesPerSecond)
+{
+	mReaderRate = qMax<qint64>(0, bytesPerSecond);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setLoopback
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setLoopback (bool enabled)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- When enabled, bytes written to the device are received back once the reader consumes them.
+--------------------------------------------------------------------------------------------------*/
+void SimulatedSerialDevice::setLoopback(bool enabled)
+{
+	mLoopback = enabled;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: bytesGenerated
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 bytesGenerated (void) const
+--
+-- RETURNS: qint64 - the number of bytes received since the device was opened.
+--------------------------------------------------------------------------------------------------*/
+qint64 SimulatedSerialDevice::bytesGenerated() const
+{
+	return mGenerated;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: errorsInjected
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 errorsInjected (void) const
+--
+-- RETURNS: qint64 - the number of parity and framing errors injected since the device was opened.
+--------------------------------------------------------------------------------------------------*/
+qint64 SimulatedSerialDevice::errorsInjected() const
+{
+	return mErrors;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: overruns
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 overruns (void) const
+--
+-- RETURNS: qint64 - the number of bytes dropped because the reader fell too far behind.
+--------------------------------------------------------------------------------------------------*/
+qint64 SimulatedSerialDevice::overruns() const
+{
+	return mOverruns;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: open
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool open (OpenMode mode)
+--
+-- RETURNS: bool - true.
+--
+-- NOTES:
+-- Opens the device unbuffered, since it keeps its own buffer, resets the counters and starts the
+-- clock. Replays start from the first record.
+--------------------------------------------------------------------------------------------------*/
+bool SimulatedSerialDevice::open(OpenMode mode)
+{
+	if (!QIODevice::open(mode | QIODevice::Unbuffered))
+	{
+		return false;
+	}
+
+	mReadBuffer.clear();
+	mWriteBuffer.clear();
+	mReadCredit = 0.0;
+	mWriteCredit = 0.0;
+	mReplayPosition = 0;
+	mGenerated = 0;
+	mErrors = 0;
+	mOverruns = 0;
+
+	mClock.start();
+	mLastTick = 0;
+	mReplayStart = 0;
+	mTimer.start();
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: close
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void close (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Stops the clock and discards anything not yet read or consumed.
+--------------------------------------------------------------------------------------------------*/
+void SimulatedSerialDevice::close()
+{
+	mTimer.stop();
+	mReadBuffer.clear();
+	mWriteBuffer.clear();
+	QIODevice::close();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: isSequential
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool isSequential (void) const
+--
+-- RETURNS: bool - true, like a real serial port.
+--------------------------------------------------------------------------------------------------*/
+bool SimulatedSerialDevice::isSequential() const
+{
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: bytesAvailable
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 bytesAvailable (void) const
+--
+-- RETURNS: qint64 - the number of received bytes waiting to be read.
+--------------------------------------------------------------------------------------------------*/
+qint64 SimulatedSerialDevice::bytesAvailable() const
+{
+	return mReadBuffer.size() + QIODevice::bytesAvailable();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: bytesToWrite
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 bytesToWrite (void) const
+--
+-- RETURNS: qint64 - the number of written bytes the simulated reader has not consumed yet.
+--------------------------------------------------------------------------------------------------*/
+qint64 SimulatedSerialDevice::bytesToWrite() const
+{
+	return mWriteBuffer.size();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: readData
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 readData (char* data, qint64 maxSize)
+--
+-- RETURNS: qint64 - the number of bytes copied into data.
+--------------------------------------------------------------------------------------------------*/
+qint64 SimulatedSerialDevice::readData(char* data, qint64 maxSize)
+{
+	int size = static_cast<int>(qMin<qint64>(maxSize, mReadBuffer.size()));
+	if (size <= 0)
+	{
+		return 0;
+	}
+
+	memcpy(data, mReadBuffer.constData(), size);
+	if (size == mReadBuffer.size())
+	{
+		mReadBuffer.resize(0);
+	}
+	else
+	{
+		mReadBuffer.remove(0, size);
+	}
+	return size;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: writeData
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 writeData (const char* data, qint64 size)
+--
+-- RETURNS: qint64 - size; everything is accepted and consumed later at the reader rate.
+--------------------------------------------------------------------------------------------------*/
+qint64 SimulatedSerialDevice::writeData(const char* data, qint64 size)
+{
+	mWriteBuffer.append(data, static_cast<int>(size));
+	return size;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: tick
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void tick (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered by the device's timer.
+--
+-- Works out how long it has been since the last tick, receives whatever traffic is due in that
+-- time and lets the reader consume written bytes. readyRead and bytesWritten are emitted like a
+-- serial port would.
+--------------------------------------------------------------------------------------------------*/
+void SimulatedSerialDevice::tick()
+{
+	qint64 now = mClock.nsecsElapsed();
+	double seconds = (now - mLastTick) / 1e9;
+	mLastTick = now;
+
+	int before = mReadBuffer.size();
+	generate(now, seconds);
+	int consumed = drainWrites(seconds);
+
+	if (consumed > 0)
+	{
+		emit bytesWritten(consumed);
+	}
+	if (mReadBuffer.size() > before)
+	{
+		emit readyRead();
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: generate
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int generate (qint64 elapsed, double seconds)
+--
+-- RETURNS: int - the number of bytes received.
+--
+-- NOTES:
+-- Random and pattern traffic accrue rate bytes per second of credit and receive the whole bytes
+-- owed, at most MAX_CHUNK per tick so a stalled event loop does not come back to one huge read.
+-- Replays receive every record whose scaled time has passed and start over after the last one.
+--------------------------------------------------------------------------------------------------*/
+int SimulatedSerialDevice::generate(qint64 elapsed, double seconds)
+{
+	if (mMode == Replay)
+	{
+		if (mReplayRecords.isEmpty())
+		{
+			return 0;
+		}
+
+		int before = mReadBuffer.size();
+		qint64 position = static_cast<qint64>((elapsed - mReplayStart) / 1000 * mSpeed);
+		while (mReplayPosition < mReplayRecords.size() && mReplayRecords[mReplayPosition].offset <= position)
+		{
+			const ReplayRecord &record = mReplayRecords[mReplayPosition];
+			deliver(mReplayData.constData() + record.start, record.size);
+			mReplayPosition++;
+		}
+		if (mReplayPosition == mReplayRecords.size())
+		{
+			mReplayPosition = 0;
+			mReplayStart = elapsed;
+		}
+		return mReadBuffer.size() - before;
+	}
+
+	mReadCredit = qMin(mReadCredit + mRate * seconds, static_cast<double>(MAX_CHUNK));
+	int size = static_cast<int>(mReadCredit);
+	if (size <= 0)
+	{
+		return 0;
+	}
+	mReadCredit -= size;
+
+	int space = MAX_BUFFER - mReadBuffer.size();
+	if (size > space)
+	{
+		mOverruns += size - space;
+		size = space;
+	}
+	if (size <= 0)
+	{
+		return 0;
+	}
+
+	int start = mReadBuffer.size();
+	mReadBuffer.resize(start + size);
+	char* out = mReadBuffer.data() + start;
+
+	if (mMode == Random)
+	{
+		int i = 0;
+		for (; i + 4 <= size; i += 4)
+		{
+			quint32 value = nextRandom();
+			memcpy(out + i, &value, 4);
+		}
+		quint32 value = nextRandom();
+		memcpy(out + i, &value, size - i);
+	}
+	else
+	{
+		int i = 0;
+		while (i < size)
+		{
+			int count = qMin(size - i, mPattern.size() - mPatternPosition);
+			memcpy(out + i, mPattern.constData() + mPatternPosition, count);
+			i += count;
+			mPatternPosition = (mPatternPosition + count) % mPattern.size();
+		}
+	}
+
+	injectErrors(out, size);
+	mGenerated += size;
+	return size;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: deliver
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void deliver (const char* data, int size)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Receives a copy of data, with errors injected, dropping whatever does not fit in MAX_BUFFER.
+--------------------------------------------------------------------------------------------------*/
+void SimulatedSerialDevice::deliver(const char* data, int size)
+{
+	int space = MAX_BUFFER - mReadBuffer.size();
+	if (size > space)
+	{
+		mOverruns += size - space;
+		size = space;
+	}
+	if (size <= 0)
+	{
+		return;
+	}
+
+	int start = mReadBuffer.size();
+	mReadBuffer.append(data, size);
+	injectErrors(mReadBuffer.data() + start, size);
+	mGenerated += size;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: injectErrors
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void injectErrors (char* data, int size)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Corrupts the bytes that the error countdowns land on. Each countdown carries over into the next
+-- call so error spacing does not depend on how traffic is chunked.
+--------------------------------------------------------------------------------------------------*/
+void SimulatedSerialDevice::injectErrors(char* data, int size)
+{
+	if (mParityErrorRate > 0.0)
+	{
+		qint64 i = mNextParityError;
+		for (; i < size; i += 1 + nextErrorGap(mParityErrorRate))
+		{
+			data[i] = static_cast<char>(data[i] ^ (1 << (nextRandom() % 8)));
+			mErrors++;
+		}
+		mNextParityError = i - size;
+	}
+
+	if (mFramingErrorRate > 0.0)
+	{
+		qint64 i = mNextFramingError;
+		for (; i < size; i += 1 + nextErrorGap(mFramingErrorRate))
+		{
+			data[i] = '\0';
+			mErrors++;
+		}
+		mNextFramingError = i - size;
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: drainWrites
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int drainWrites (double seconds)
+--
+-- RETURNS: int - the number of written bytes consumed.
+--
+-- NOTES:
+-- Lets the simulated reader consume what it can in seconds. Consumed bytes are received back in
+-- loopback mode.
+--------------------------------------------------------------------------------------------------*/
+int SimulatedSerialDevice::drainWrites(double seconds)
+{
+	if (mWriteBuffer.isEmpty())
+	{
+		mWriteCredit = 0.0;
+		return 0;
+	}
+
+	int size = mWriteBuffer.size();
+	if (mReaderRate > 0)
+	{
+		mWriteCredit += mReaderRate * seconds;
+		size = qMin(size, static_cast<int>(mWriteCredit));
+		mWriteCredit -= size;
+	}
+	if (size <= 0)
+	{
+		return 0;
+	}
+
+	if (mLoopback)
+	{
+		deliver(mWriteBuffer.constData(), size);
+	}
+	mWriteBuffer.remove(0, size);
+	return size;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: nextRandom
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: quint32 nextRandom (void)
+--
+-- RETURNS: quint32 - the next value of a xorshift32 generator.
+--
+-- NOTES:
+-- Fast and the same on every platform, so a simulated run is repeatable.
+--------------------------------------------------------------------------------------------------*/
+quint32 SimulatedSerialDevice::nextRandom()
+{
+	mRandom ^= mRandom << 13;
+	mRandom ^= mRandom >> 17;
+	mRandom ^= mRandom << 5;
+	return mRandom;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: nextErrorGap
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 nextErrorGap (double rate)
+--
+-- RETURNS: qint64 - the number of good bytes before the next error.
+--
+-- NOTES:
+-- Draws from the geometric distribution of the gap between events of probability rate.
+--------------------------------------------------------------------------------------------------*/
+qint64 SimulatedSerialDevice::nextErrorGap(double rate)
+{
+	if (rate <= 0.0)
+	{
+		return 0;
+	}
+	if (rate >= 1.0)
+	{
+		return 0;
+	}
+
+	double uniform = (nextRandom() + 1.0) / 4294967296.0;
+	return static_cast<qint64>(std::log(uniform) / std::log(1.0 - rate));
+}
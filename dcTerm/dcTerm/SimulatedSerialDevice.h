@@ -0,0 +1,106 @@
+#pragma once
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QIODevice>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+
+class SimulatedSerialDevice
+	: public QIODevice
+{
+	Q_OBJECT
+
+public:
+	enum Mode
+	{
+		Random,
+		Pattern,
+		Replay
+	};
+
+	static const int TICK_INTERVAL = 1;
+	static const int MAX_CHUNK = 1024 * 1024;
+	static const int MAX_BUFFER = 16 * 1024 * 1024;
+
+	explicit SimulatedSerialDevice(QObject *parent = nullptr);
+
+	bool configure(const QString &spec, QString* error);
+	QString description() const;
+
+	void setMode(Mode mode);
+	void setRate(qint64 bytesPerSecond);
+	void setPattern(const QByteArray &pattern);
+	bool loadReplay(const QString &path, QString* error, double from = 0);
+	void setSpeed(double speed);
+	void setParityErrorRate(double rate);
+	void setFramingErrorRate(double rate);
+	void setReaderRate(qint64 bytesPerSecond);
+	void setLoopback(bool enabled);
+
+	qint64 bytesGenerated() const;
+	qint64 errorsInjected() const;
+	qint64 overruns() const;
+
+	bool open(OpenMode mode) Q_DECL_OVERRIDE;
+	void close() Q_DECL_OVERRIDE;
+	bool isSequential() const Q_DECL_OVERRIDE;
+	qint64 bytesAvailable() const Q_DECL_OVERRIDE;
+	qint64 bytesToWrite() const Q_DECL_OVERRIDE;
+
+protected:
+	qint64 readData(char* data, qint64 maxSize) Q_DECL_OVERRIDE;
+	qint64 writeData(const char* data, qint64 size) Q_DECL_OVERRIDE;
+
+private:
+	struct ReplayRecord
+	{
+		qint64 offset;
+		int start;
+		int size;
+	};
+
+	Mode mMode;
+	qint64 mRate;
+	QByteArray mPattern;
+	int mPatternPosition;
+	double mSpeed;
+	double mParityErrorRate;
+	double mFramingErrorRate;
+	qint64 mReaderRate;
+	bool mLoopback;
+
+	QByteArray mReplayData;
+	QVector<ReplayRecord> mReplayRecords;
+	int mReplayPosition;
+	qint64 mReplayStart;
+
+	QTimer mTimer;
+	QElapsedTimer mClock;
+	qint64 mLastTick;
+	double mReadCredit;
+	double mWriteCredit;
+
+	QByteArray mReadBuffer;
+	QByteArray mWriteBuffer;
+
+	quint32 mRandom;
+	qint64 mNextParityError;
+	qint64 mNextFramingError;
+
+	qint64 mGenerated;
+	qint64 mErrors;
+	qint64 mOverruns;
+
+	int generate(qint64 elapsed, double seconds);
+	void injectErrors(char* data, int size);
+	int drainWrites(double seconds);
+	void deliver(const char* data, int size);
+
+	quint32 nextRandom();
+	qint64 nextErrorGap(double rate);
+
+private slots:
+	void tick();
+};
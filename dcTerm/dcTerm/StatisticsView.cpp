@@ -0,0 +1,232 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: StatisticsView.cpp - Shows the traffic and memory figures of a session.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- QString formatBytes(qint64 bytes);
+-- QString formatLatency(qint64 microseconds);
+--
+-- void paintEvent(QPaintEvent* e);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Shows the answer latency percentiles.
+-- October 18, 2026 - Shows the port tuning and the average bytes per read.
+-- October 18, 2026 - Shows the read buffer the port is given, the total limit and any bytes
+--     dropped from the capture.
+-- October 18, 2026 - Shows the percentiles of recent answers beside those of the whole run.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- A window with the session's traffic counts, its answer latencies over the whole run and over
+-- the last few seconds and, for each subsystem of its memory budget, the memory held now, the most
+-- held since the statistics were reset and the limit. A long running session can be checked at a
+-- glance for anything growing, and a device that has only just slowed down shows up in the recent
+-- latencies even when hours of answers hold the overall ones steady.
+--
+-- Like the timing view it repaints itself every REFRESH_INTERVAL milliseconds while it is shown.
+--------------------------------------------------------------------------------------------------*/
+#include <QPainter>
+
+#include "StatisticsView.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: StatisticsView (const SerialSession*, QWidget*)
+--
+-- NOTES:
+-- Constructor for a view of session. The view is a top level window.
+--------------------------------------------------------------------------------------------------*/
+StatisticsView::StatisticsView(const SerialSession* session, QWidget* parent)
+	: QWidget(parent, Qt::Window)
+	, mSession(session)
+{
+	setWindowTitle(tr("dcTerm - Statistics"));
+	resize(480, 320);
+
+	QPalette p = palette();
+	p.setColor(QPalette::Window, Qt::black);
+	p.setColor(QPalette::WindowText, Qt::green);
+	setPalette(p);
+	setAutoFillBackground(true);
+
+	connect(&mRefresh, &QTimer::timeout, this, static_cast<void (QWidget::*)()>(&QWidget::update));
+	mRefresh.start(REFRESH_INTERVAL);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: paintEvent
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Shows the answer latency percentiles.
+-- October 18, 2026 - Shows the port tuning and the average bytes per read.
+-- October 18, 2026 - Shows the read buffer the port is given, the total limit and any bytes
+--     dropped from the capture.
+-- October 18, 2026 - Shows the percentiles of recent answers beside those of the whole run.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void paintEvent (QPaintEvent* e)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Draws the traffic counts followed by a table of memory use with one row per subsystem and a
+-- total. Subsystems over their limit are drawn in red.
+--------------------------------------------------------------------------------------------------*/
+void StatisticsView::paintEvent(QPaintEvent* e)
+{
+	Q_UNUSED(e);
+
+	QPainter painter(this);
+	QColor text = palette().color(QPalette::WindowText);
+	painter.setPen(text);
+
+	const SessionStatistics &stats = mSession->statistics();
+	const MemoryBudget &budget = mSession->budget();
+	int line = fontMetrics().height();
+	int y = line;
+
+	painter.drawText(4, y, tr("Received %1 in %2 reads, %3 per read").arg(formatBytes(stats.bytesReceived))
+		.arg(stats.reads).arg(formatBytes(stats.reads > 0 ? stats.bytesReceived / stats.reads : 0)));
+	y += line;
+	painter.drawText(4, y, tr("Sent %1 in %2 writes").arg(formatBytes(stats.bytesSent)).arg(stats.writes));
+	y += line;
+	painter.drawText(4, y, tr("%1 frames, %2 frame errors, %3 trigger matches")
+		.arg(stats.frames).arg(stats.frameErrors).arg(stats.triggerMatches));
+	y += line;
+
+	const SerialSettings &settings = mSession->settings();
+	painter.drawText(4, y, tr("Read buffer %1, low latency %2, %3 access")
+		.arg(formatBytes(mSession->readBufferLimit()))
+		.arg(settings.lowLatency ? tr("on") : tr("off"))
+		.arg(settings.exclusive ? tr("exclusive") : tr("shared")));
+	y += line;
+	if (mSession->captureDroppedBytes() > 0)
+	{
+		painter.setPen(Qt::red);
+		painter.drawText(4, y, tr("Capture fell behind and dropped %1")
+			.arg(formatBytes(mSession->captureDroppedBytes())));
+		painter.setPen(text);
+	}
+	y += line;
+
+	const LatencyTracker &latency = mSession->latency();
+	painter.drawText(4, y, tr("Latency: %1 answered, %2 timed out, %3 waiting")
+		.arg(latency.count()).arg(latency.timeouts()).arg(latency.pending()));
+	y += line;
+	painter.drawText(4, y, tr("min %1  p50 %2  p95 %3  p99 %4  max %5")
+		.arg(formatLatency(latency.minimum()))
+		.arg(formatLatency(latency.percentile(50)))
+		.arg(formatLatency(latency.percentile(95)))
+		.arg(formatLatency(latency.percentile(99)))
+		.arg(formatLatency(latency.maximum())));
+	y += line;
+	qint64 now = CaptureFile::now();
+	painter.drawText(4, y, tr("Last %1 s: %2 answered, p50 %3  p95 %4  p99 %5")
+		.arg(LatencyTracker::WINDOW_INTERVAL * 2 / 1000000)
+		.arg(latency.recentCount(now))
+		.arg(formatLatency(latency.recentPercentile(50, now)))
+		.arg(formatLatency(latency.recentPercentile(95, now)))
+		.arg(formatLatency(latency.recentPercentile(99, now))));
+	y += line * 2;
+
+	int column = qMax(80, (width() - 8) / 4);
+	painter.drawText(4, y, tr("Memory"));
+	painter.drawText(4 + column, y, tr("Current"));
+	painter.drawText(4 + column * 2, y, tr("Peak"));
+	painter.drawText(4 + column * 3, y, tr("Limit"));
+	y += line;
+
+	for (int i = 0; i < MemoryBudget::SUBSYSTEM_COUNT; i++)
+	{
+		MemoryBudget::Subsystem subsystem = static_cast<MemoryBudget::Subsystem>(i);
+		painter.setPen(budget.exceeded(subsystem) ? QColor(Qt::red) : text);
+		painter.drawText(4, y, MemoryBudget::name(subsystem));
+		painter.drawText(4 + column, y, formatBytes(budget.current(subsystem)));
+		painter.drawText(4 + column * 2, y, formatBytes(budget.peak(subsystem)));
+		painter.drawText(4 + column * 3, y, formatBytes(budget.limit(subsystem)));
+		y += line;
+	}
+
+	painter.setPen(budget.totalExceeded() ? QColor(Qt::red) : text);
+	painter.drawText(4, y, tr("Total"));
+	painter.drawText(4 + column, y, formatBytes(budget.total()));
+	painter.drawText(4 + column * 2, y, formatBytes(budget.peakTotal()));
+	painter.drawText(4 + column * 3, y,
+		budget.totalLimit() > 0 ? formatBytes(budget.totalLimit()) : tr("none"));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: formatBytes
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: static QString formatBytes (qint64 bytes)
+--
+-- RETURNS: QString - bytes in B, KB or MB, whichever reads best.
+--------------------------------------------------------------------------------------------------*/
+QString StatisticsView::formatBytes(qint64 bytes)
+{
+	if (bytes < 1024)
+	{
+		return QString("%1 B").arg(bytes);
+	}
+	if (bytes < 1024 * 1024)
+	{
+		return QString("%1 KB").arg(bytes / 1024.0, 0, 'f', 1);
+	}
+	return QString("%1 MB").arg(bytes / (1024.0 * 1024.0), 0, 'f', 1);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: formatLatency
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: static QString formatLatency (qint64 microseconds)
+--
+-- RETURNS: QString - microseconds in us, ms or s, whichever reads best.
+--------------------------------------------------------------------------------------------------*/
+QString StatisticsView::formatLatency(qint64 microseconds)
+{
+	if (microseconds < 1000)
+	{
+		return QString("%1 us").arg(microseconds);
+	}
+	if (microseconds < 1000000)
+	{
+		return QString("%1 ms").arg(microseconds / 1000.0, 0, 'f', 2);
+	}
+	return QString("%1 s").arg(microseconds / 1000000.0, 0, 'f', 3);
+}
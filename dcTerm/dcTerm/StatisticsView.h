@@ -0,0 +1,27 @@
+#pragma once
+
+#include <QTimer>
+#include <QWidget>
+
+#include "SerialSession.h"
+
+class StatisticsView
+	: public QWidget
+{
+	Q_OBJECT
+
+public:
+	static const int REFRESH_INTERVAL = 500;
+
+	explicit StatisticsView(const SerialSession* session, QWidget *parent = nullptr);
+
+private:
+	const SerialSession* mSession;
+	QTimer mRefresh;
+
+	static QString formatBytes(qint64 bytes);
+	static QString formatLatency(qint64 microseconds);
+
+protected:
+	void paintEvent(QPaintEvent* e) Q_DECL_OVERRIDE;
+};
@@ -0,0 +1,606 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: StreamExporter.cpp - Exports captures and received data on a background thread.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- ExportJob:
+-- void abort();
+-- void run();
+-- void writeData(const QByteArray &data, qint64 done, qint64 total);
+-- void reportProgress(qint64 done, qint64 total);
+-- void finish(bool truncated);
+--
+-- StreamExporter:
+-- bool exportCapture(const QString &capture, const QString &path, ExportWriter::Format format,
+--                    int linkType, QString* error);
+-- bool exportHistory(const ByteStore &history, qint64 timestamp, const QString &path,
+--                    ExportWriter::Format format, int linkType, QString* error);
+-- void stop();
+-- bool isRunning() const;
+-- ExportWriter::Format formatForFile(const QString &path);
+-- bool start(ExportJob* job, QString* error);
+-- void sendHistory();
+-- void jobFinished(bool ok, const QString &message);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - The history is streamed to the job a chunk at a time instead of copied whole.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- An export runs as an ExportJob on a thread of its own, the same way a script does, so the
+-- window and the port carry on while gigabytes are written. Only one export runs at a time.
+--
+-- A capture is streamed: each record is read with CaptureReader into the same buffer and passed
+-- straight to an ExportWriter, which writes to the file FLUSH_SIZE bytes at a time. An export
+-- holds about one record and one flush of output in memory whatever the size of the capture.
+--
+-- The session's history has no records of its own and is exported as received records of
+-- DATA_RECORD_SIZE bytes all stamped with the time of the export. The history belongs to the
+-- session's thread, so the job cannot read it directly and it is not copied whole either, which
+-- could double the memory it takes. Instead the job asks for data with needData() and the
+-- exporter, on the session's thread, reads the next HISTORY_CHUNK_SIZE bytes of the history and
+-- queues them to the job. One chunk is in flight at a time, so the history export also holds a
+-- constant amount of memory. Only what was in the history when the export started is exported.
+-- If newer data overwrites part of it before it is reached, that part is skipped and the result
+-- says how many bytes were lost.
+--
+-- Progress is reported as a percentage, only when it changes, so a large export sends at most a
+-- hundred signals to the window.
+--------------------------------------------------------------------------------------------------*/
+#include <QFile>
+#include <QFileInfo>
+
+#include "CaptureReader.h"
+#include "StreamExporter.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Takes its data through writeData() instead of a copy.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: ExportJob (const QString &capture, qint64 timestamp, const QString &path,
+--                       ExportWriter::Format format, int linkType)
+--
+-- NOTES:
+-- Constructor for an export to path of the capture file capture or, if capture is empty, of the
+-- data passed to writeData(), stamped with timestamp.
+--------------------------------------------------------------------------------------------------*/
+ExportJob::ExportJob(const QString &capture, qint64 timestamp, const QString &path,
+	ExportWriter::Format format, int linkType)
+	: mCapture(capture)
+	, mTimestamp(timestamp)
+	, mFile(path)
+	, mWriter(format, linkType)
+	, mAborted(0)
+	, mPercent(-1)
+{
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: abort
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void abort (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Asks the job to stop after the record it is on. Safe to call from any thread.
+--------------------------------------------------------------------------------------------------*/
+void ExportJob::abort()
+{
+	mAborted.storeRelease(1);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: run
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Without a capture, asks for the data a chunk at a time.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void run (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and starts the export on the job's thread. A capture is exported
+-- here in one go. Otherwise needData() is emitted and the export goes on in writeData(). Either
+-- way finished is emitted when it is done, has failed or has been aborted, and the file is left as
+-- far as it got.
+--------------------------------------------------------------------------------------------------*/
+void ExportJob::run()
+{
+	if (!mFile.open(QIODevice::WriteOnly | QIODevice::Truncate) || !mWriter.begin(&mFile))
+	{
+		emit finished(false, mFile.errorString());
+		return;
+	}
+
+	if (mCapture.isEmpty())
+	{
+		emit needData();
+		return;
+	}
+
+	CaptureReader reader;
+	QString error;
+	if (!reader.open(mCapture, &error))
+	{
+		emit finished(false, error);
+		return;
+	}
+
+	CaptureRecord record;
+	while (!mAborted.loadAcquire() && reader.next(record))
+	{
+		if (!mWriter.write(record.timestamp, record.direction, record.data.constData(), record.data.size()))
+		{
+			emit finished(false, mFile.errorString());
+			return;
+		}
+		reportProgress(reader.position(), reader.size());
+	}
+	finish(reader.isTruncated());
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: writeData
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void writeData (const QByteArray &data, qint64 done, qint64 total)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is queued to the job with each chunk it asked for. done and
+-- total are how far through the data the chunk ends, for progress. Writes the chunk as records of
+-- DATA_RECORD_SIZE bytes and asks for the next one; an empty chunk means there is no more.
+--------------------------------------------------------------------------------------------------*/
+void ExportJob::writeData(const QByteArray &data, qint64 done, qint64 total)
+{
+	if (data.isEmpty() || mAborted.loadAcquire())
+	{
+		finish(false);
+		return;
+	}
+
+	for (int i = 0; i < data.size(); i += DATA_RECORD_SIZE)
+	{
+		int size = qMin(static_cast<int>(DATA_RECORD_SIZE), data.size() - i);
+		if (!mWriter.write(mTimestamp, CaptureFile::Received, data.constData() + i, size))
+		{
+			emit finished(false, mFile.errorString());
+			return;
+		}
+	}
+	reportProgress(done, total);
+	emit needData();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: reportProgress
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void reportProgress (qint64 done, qint64 total)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Emits progress if the percentage done has changed since it was last emitted.
+--------------------------------------------------------------------------------------------------*/
+void ExportJob::reportProgress(qint64 done, qint64 total)
+{
+	int percent = total > 0 ? static_cast<int>(done * 100 / total) : 100;
+	if (percent != mPercent)
+	{
+		mPercent = percent;
+		emit progress(percent);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: finish
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void finish (bool truncated)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Finishes the file and emits finished, saying whether the export was stopped or its capture was
+-- cut short.
+--------------------------------------------------------------------------------------------------*/
+void ExportJob::finish(bool truncated)
+{
+	QString name = QFileInfo(mFile.fileName()).fileName();
+	if (!mWriter.finish())
+	{
+		emit finished(false, mFile.errorString());
+	}
+	else if (mAborted.loadAcquire())
+	{
+		emit finished(false, tr("Export of %1 stopped.").arg(name));
+	}
+	else if (truncated)
+	{
+		emit finished(true, tr("Exported %1; the capture was cut short.").arg(name));
+	}
+	else
+	{
+		emit finished(true, tr("Exported %1.").arg(name));
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: StreamExporter (QObject*)
+--
+-- NOTES:
+-- Constructor for an exporter with no export running.
+--------------------------------------------------------------------------------------------------*/
+StreamExporter::StreamExporter(QObject* parent)
+	: QObject(parent)
+	, mThread(nullptr)
+	, mJob(nullptr)
+	, mHistory(nullptr)
+	, mHistoryStart(0)
+	, mHistoryNext(0)
+	, mHistoryEnd(0)
+	, mHistoryLost(0)
+{
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Deconstructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: ~StreamExporter ()
+--
+-- NOTES:
+-- Stops a running export and waits for its thread to end.
+--------------------------------------------------------------------------------------------------*/
+StreamExporter::~StreamExporter()
+{
+	if (mThread)
+	{
+		mJob->abort();
+		mThread->quit();
+		mThread->wait();
+		delete mJob;
+		delete mThread;
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: exportCapture
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool exportCapture (const QString &capture, const QString &path,
+--                                ExportWriter::Format format, int linkType, QString* error)
+--
+-- RETURNS: bool - true if the export was started.
+--
+-- NOTES:
+-- Starts exporting the capture file capture to path in format. linkType is used for pcap.
+--------------------------------------------------------------------------------------------------*/
+bool StreamExporter::exportCapture(const QString &capture, const QString &path, ExportWriter::Format format,
+	int linkType, QString* error)
+{
+	return start(new ExportJob(capture, 0, path, format, linkType), error);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: exportHistory
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Takes the history itself instead of a copy of it.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool exportHistory (const ByteStore &history, qint64 timestamp, const QString &path,
+--                                ExportWriter::Format format, int linkType, QString* error)
+--
+-- RETURNS: bool - true if the export was started.
+--
+-- NOTES:
+-- Starts exporting what history holds now, stamped with timestamp, to path in format. linkType is
+-- used for pcap. history must outlive the export and is read on this object's thread.
+--------------------------------------------------------------------------------------------------*/
+bool StreamExporter::exportHistory(const ByteStore &history, qint64 timestamp, const QString &path,
+	ExportWriter::Format format, int linkType, QString* error)
+{
+	if (!start(new ExportJob(QString(), timestamp, path, format, linkType), error))
+	{
+		return false;
+	}
+
+	mHistory = &history;
+	mHistoryStart = history.begin();
+	mHistoryNext = history.begin();
+	mHistoryEnd = history.end();
+	mHistoryLost = 0;
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: stop
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void stop (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Asks the running export to stop. The finished signal is emitted once it has.
+--------------------------------------------------------------------------------------------------*/
+void StreamExporter::stop()
+{
+	if (mJob)
+	{
+		mJob->abort();
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: isRunning
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool isRunning (void) const
+--
+-- RETURNS: bool - true if an export is running.
+--------------------------------------------------------------------------------------------------*/
+bool StreamExporter::isRunning() const
+{
+	return mThread != nullptr;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: formatForFile
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: static ExportWriter::Format formatForFile (const QString &path)
+--
+-- RETURNS: ExportWriter::Format - the format for the file name's extension: .hex for a hex dump,
+--                                 .csv, .pcap, and plain text for anything else.
+--------------------------------------------------------------------------------------------------*/
+ExportWriter::Format StreamExporter::formatForFile(const QString &path)
+{
+	QString suffix = QFileInfo(path).suffix().toLower();
+	if (suffix == "hex")
+	{
+		return ExportWriter::HexDump;
+	}
+	if (suffix == "csv")
+	{
+		return ExportWriter::Csv;
+	}
+	if (suffix == "pcap")
+	{
+		return ExportWriter::Pcap;
+	}
+	return ExportWriter::Text;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: start
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Connects the job's requests for data.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool start (ExportJob* job, QString* error)
+--
+-- RETURNS: bool - true if the job was started.
+--
+-- NOTES:
+-- Runs job on a new thread, taking ownership of it. Only one export runs at a time. The job's
+-- requests for data are answered by sendHistory().
+--------------------------------------------------------------------------------------------------*/
+bool StreamExporter::start(ExportJob* job, QString* error)
+{
+	if (mThread)
+	{
+		delete job;
+		*error = tr("An export is already running.");
+		return false;
+	}
+
+	mThread = new QThread();
+	mJob = job;
+	mJob->moveToThread(mThread);
+
+	connect(mThread, &QThread::started, mJob, &ExportJob::run);
+	connect(mJob, &ExportJob::progress, this, &StreamExporter::progress);
+	connect(mJob, &ExportJob::needData, this, &StreamExporter::sendHistory);
+	connect(mJob, &ExportJob::finished, this, &StreamExporter::jobFinished);
+	connect(mThread, &QThread::finished, mJob, &QObject::deleteLater);
+	connect(mThread, &QThread::finished, mThread, &QObject::deleteLater);
+
+	mThread->start();
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: sendHistory
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void sendHistory (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the job asks for data. Reads the next chunk
+-- of the history and queues it to the job, or an empty chunk once the part being exported has
+-- all been sent. Bytes the history dropped since the last chunk are skipped and counted as lost,
+-- and if the history was started over at a new size the rest is lost.
+--------------------------------------------------------------------------------------------------*/
+void StreamExporter::sendHistory()
+{
+	if (!mJob || !mHistory)
+	{
+		return;
+	}
+
+	if (mHistory->end() < mHistoryNext)
+	{
+		mHistoryLost += mHistoryEnd - mHistoryNext;
+		mHistoryNext = mHistoryEnd;
+	}
+	else if (mHistory->begin() > mHistoryNext)
+	{
+		qint64 skipped = qMin(mHistory->begin(), mHistoryEnd) - mHistoryNext;
+		mHistoryLost += skipped;
+		mHistoryNext += skipped;
+	}
+
+	QByteArray chunk(static_cast<int>(qMin<qint64>(HISTORY_CHUNK_SIZE, mHistoryEnd - mHistoryNext)), 0);
+	chunk.resize(mHistory->read(mHistoryNext, chunk.data(), chunk.size()));
+	mHistoryNext += chunk.size();
+
+	QMetaObject::invokeMethod(mJob, "writeData", Qt::QueuedConnection, Q_ARG(QByteArray, chunk),
+		Q_ARG(qint64, mHistoryNext - mHistoryStart), Q_ARG(qint64, mHistoryEnd - mHistoryStart));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: jobFinished
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Says how much of the history was lost during the export.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void jobFinished (bool ok, const QString &message)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is called when the job is done. Ends its thread, which deletes
+-- the job and itself, and passes the result on.
+--------------------------------------------------------------------------------------------------*/
+void StreamExporter::jobFinished(bool ok, const QString &message)
+{
+	mThread->quit();
+	mThread = nullptr;
+	mJob = nullptr;
+	mHistory = nullptr;
+
+	if (mHistoryLost > 0)
+	{
+		emit finished(ok, tr("%1 %2 bytes were overwritten by newer data before they were exported.")
+			.arg(message).arg(mHistoryLost));
+		mHistoryLost = 0;
+		return;
+	}
+	emit finished(ok, message);
+}
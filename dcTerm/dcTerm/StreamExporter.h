@@ -0,0 +1,86 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QFile>
+#include <QObject>
+#include <QString>
+#include <QThread>
+
+#include "ByteStore.h"
+#include "ExportWriter.h"
+
+class ExportJob
+	: public QObject
+{
+	Q_OBJECT
+
+public:
+	static const int DATA_RECORD_SIZE = 4096;
+
+	ExportJob(const QString &capture, qint64 timestamp, const QString &path, ExportWriter::Format format,
+		int linkType);
+
+	void abort();
+
+public slots:
+	void run();
+	void writeData(const QByteArray &data, qint64 done, qint64 total);
+
+private:
+	QString mCapture;
+	qint64 mTimestamp;
+	QFile mFile;
+	ExportWriter mWriter;
+	QAtomicInt mAborted;
+	int mPercent;
+
+	void reportProgress(qint64 done, qint64 total);
+	void finish(bool truncated);
+
+signals:
+	void progress(int percent);
+	void needData();
+	void finished(bool ok, const QString &message);
+};
+
+class StreamExporter
+	: public QObject
+{
+	Q_OBJECT
+
+public:
+	explicit StreamExporter(QObject *parent = nullptr);
+	~StreamExporter();
+
+	bool exportCapture(const QString &capture, const QString &path, ExportWriter::Format format, int linkType,
+		QString* error);
+	bool exportHistory(const ByteStore &history, qint64 timestamp, const QString &path,
+		ExportWriter::Format format, int linkType, QString* error);
+	void stop();
+	bool isRunning() const;
+
+	static ExportWriter::Format formatForFile(const QString &path);
+
+private:
+	static const int HISTORY_CHUNK_SIZE = 64 * 1024;
+
+	QThread* mThread;
+	ExportJob* mJob;
+
+	const ByteStore* mHistory;
+	qint64 mHistoryStart;
+	qint64 mHistoryNext;
+	qint64 mHistoryEnd;
+	qint64 mHistoryLost;
+
+	bool start(ExportJob* job, QString* error);
+
+private slots:
+	void sendHistory();
+	void jobFinished(bool ok, const QString &message);
+
+signals:
+	void progress(int percent);
+	void finished(bool ok, const QString &message);
+};
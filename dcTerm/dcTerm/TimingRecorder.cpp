@@ -0,0 +1,586 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: TimingRecorder.cpp - Records when received bytes arrived.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- void setFormat(qint32 bitRate, int bitsPerCharacter);
+-- double byteTime() const;
+--
+-- void clear();
+-- void record(qint64 timestamp, int size);
+-- void recordLines(qint64 timestamp, quint32 lines);
+--
+-- int batchCount() const;
+-- qint64 byteCount() const;
+-- qint64 firstTimestamp() const;
+-- qint64 lastTimestamp() const;
+-- int memoryUsage() const;
+--
+-- const QVector<quint64> &histogram() const;
+-- void batches(qint64 from, qint64 to, QVector<TimingBatch> &out) const;
+-- quint32 lineEvents(qint64 from, qint64 to, QVector<LineEvent> &out) const;
+-- qint64 lastLineTimestamp() const;
+--
+-- void addGap(double gap, quint64 count);
+-- void putVarint(QByteArray &column, quint64 value);
+-- quint64 getVarint(const char* &p);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- The serial port only tells us when a batch of bytes is ready, not when each byte arrived. The
+-- recorder stores the time and size of every batch and estimates the time of each byte from the
+-- character time at the current baud rate: the last byte of a batch is taken to have arrived at
+-- the batch's timestamp and the bytes before it one character time apart.
+--
+-- Batches are stored in two columns, one for the time since the previous batch and one for the
+-- size, each written as variable length integers. A typical batch costs 2 to 4 bytes, so hours of
+-- traffic stay small. Every INDEX_INTERVAL batches the absolute time and the column offsets are
+-- saved so the timeline can start decoding near any point instead of from the beginning.
+--
+-- The gap histogram is kept up to date as batches are recorded. Bucket 0 counts gaps under 1 us
+-- and bucket n counts gaps from 2^(n-1) us up to 2^n us; the last bucket also holds anything
+-- longer.
+--
+-- Control line changes are rare next to batches and are kept as a plain list of the time and the
+-- new state of the lines.
+--------------------------------------------------------------------------------------------------*/
+#include <QtGlobal>
+
+#include "TimingRecorder.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: TimingRecorder ()
+--
+-- NOTES:
+-- Constructor for an empty recorder at 9600 baud, 10 bits per character.
+--------------------------------------------------------------------------------------------------*/
+TimingRecorder::TimingRecorder()
+	: mHistogram(HISTOGRAM_BUCKETS, 0)
+{
+	setFormat(9600, 10);
+	clear();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setFormat
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setFormat (qint32 bitRate, int bitsPerCharacter)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Sets the line speed used to estimate byte times. bitsPerCharacter counts the start, data,
+-- parity and stop bits. Only batches recorded afterwards are affected.
+--------------------------------------------------------------------------------------------------*/
+void TimingRecorder::setFormat(qint32 bitRate, int bitsPerCharacter)
+{
+	mByteTime = bitRate > 0 ? bitsPerCharacter * 1000000.0 / bitRate : 0.0;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: byteTime
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: double byteTime (void) const
+--
+-- RETURNS: double - the time to receive one character in microseconds.
+--------------------------------------------------------------------------------------------------*/
+double TimingRecorder::byteTime() const
+{
+	return mByteTime;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: clear
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void clear (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Discards every recorded batch and line change and empties the histogram.
+--------------------------------------------------------------------------------------------------*/
+void TimingRecorder::clear()
+{
+	mDeltas.clear();
+	mSizes.clear();
+	mIndex.clear();
+	mCount = 0;
+	mBytes = 0;
+	mFirst = 0;
+	mLast = 0;
+	mHistogram.fill(0);
+	mLineEvents.clear();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: record
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void record (qint64 timestamp, int size)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Records that size bytes were read at timestamp microseconds. Timestamps must not go backwards;
+-- CaptureFile::now() is monotonic and is what dcTerm uses.
+--
+-- The gap before the batch is the time from the previous batch to the estimated arrival of this
+-- batch's first byte. When the estimate overlaps the previous batch the bytes were arriving back
+-- to back, so the gap is counted as zero.
+--------------------------------------------------------------------------------------------------*/
+void TimingRecorder::record(qint64 timestamp, int size)
+{
+	if (size <= 0)
+	{
+		return;
+	}
+
+	if (mCount == 0)
+	{
+		mFirst = timestamp;
+		mLast = timestamp;
+	}
+	else
+	{
+		double first = timestamp - (size - 1) * mByteTime;
+		addGap(qMax(0.0, first - mLast), 1);
+	}
+
+	if (mCount % INDEX_INTERVAL == 0)
+	{
+		IndexEntry entry = { mLast, mDeltas.size(), mSizes.size() };
+		mIndex.append(entry);
+	}
+
+	putVarint(mDeltas, static_cast<quint64>(qMax<qint64>(0, timestamp - mLast)));
+	putVarint(mSizes, static_cast<quint64>(size));
+	if (size > 1)
+	{
+		addGap(mByteTime, size - 1);
+	}
+
+	mLast = qMax(mLast, timestamp);
+	mCount++;
+	mBytes += size;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: recordLines
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void recordLines (qint64 timestamp, quint32 lines)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Records that the control lines became lines, a set of QSerialPort::PinoutSignal flags, at
+-- timestamp microseconds.
+--------------------------------------------------------------------------------------------------*/
+void TimingRecorder::recordLines(qint64 timestamp, quint32 lines)
+{
+	if (!mLineEvents.isEmpty())
+	{
+		timestamp = qMax(timestamp, mLineEvents.last().timestamp);
+	}
+	LineEvent event = { timestamp, lines };
+	mLineEvents.append(event);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: batchCount
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int batchCount (void) const
+--
+-- RETURNS: int - the number of batches recorded.
+--------------------------------------------------------------------------------------------------*/
+int TimingRecorder::batchCount() const
+{
+	return mCount;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: byteCount
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 byteCount (void) const
+--
+-- RETURNS: qint64 - the number of bytes in all recorded batches.
+--------------------------------------------------------------------------------------------------*/
+qint64 TimingRecorder::byteCount() const
+{
+	return mBytes;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: firstTimestamp
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 firstTimestamp (void) const
+--
+-- RETURNS: qint64 - the time of the first batch, or 0 if nothing was recorded.
+--------------------------------------------------------------------------------------------------*/
+qint64 TimingRecorder::firstTimestamp() const
+{
+	return mFirst;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: lastTimestamp
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 lastTimestamp (void) const
+--
+-- RETURNS: qint64 - the time of the last batch, or 0 if nothing was recorded.
+--------------------------------------------------------------------------------------------------*/
+qint64 TimingRecorder::lastTimestamp() const
+{
+	return mLast;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: memoryUsage
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int memoryUsage (void) const
+--
+-- RETURNS: int - the number of bytes used by the recorded columns and index.
+--------------------------------------------------------------------------------------------------*/
+int TimingRecorder::memoryUsage() const
+{
+	return mDeltas.size() + mSizes.size() + mIndex.size() * static_cast<int>(sizeof(IndexEntry))
+		+ mLineEvents.size() * static_cast<int>(sizeof(LineEvent));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: histogram
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: const QVector<quint64> &histogram (void) const
+--
+-- RETURNS: const QVector<quint64>& - the inter-byte gap counts, HISTOGRAM_BUCKETS long.
+--------------------------------------------------------------------------------------------------*/
+const QVector<quint64> &TimingRecorder::histogram() const
+{
+	return mHistogram;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: batches
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void batches (qint64 from, qint64 to, QVector<TimingBatch> &out) const
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Replaces the contents of out with the batches whose timestamps are between from and to. The
+-- index is searched for the last checkpoint before from so at most INDEX_INTERVAL batches are
+-- decoded that are not returned.
+--------------------------------------------------------------------------------------------------*/
+void TimingRecorder::batches(qint64 from, qint64 to, QVector<TimingBatch> &out) const
+{
+	out.clear();
+	if (mCount == 0 || to < from)
+	{
+		return;
+	}
+
+	int low = 0;
+	int high = mIndex.size() - 1;
+	while (low < high)
+	{
+		int middle = (low + high + 1) / 2;
+		if (mIndex[middle].base < from)
+		{
+			low = middle;
+		}
+		else
+		{
+			high = middle - 1;
+		}
+	}
+
+	const IndexEntry &entry = mIndex[low];
+	const char* delta = mDeltas.constData() + entry.deltaOffset;
+	const char* size = mSizes.constData() + entry.sizeOffset;
+	const char* end = mDeltas.constData() + mDeltas.size();
+	qint64 timestamp = entry.base;
+
+	while (delta < end)
+	{
+		timestamp += static_cast<qint64>(getVarint(delta));
+		int length = static_cast<int>(getVarint(size));
+		if (timestamp > to)
+		{
+			break;
+		}
+		if (timestamp >= from)
+		{
+			TimingBatch batch = { timestamp, length };
+			out.append(batch);
+		}
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: lineEvents
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: quint32 lineEvents (qint64 from, qint64 to, QVector<LineEvent> &out) const
+--
+-- RETURNS: quint32 - the state of the lines at from, before any change in out.
+--
+-- NOTES:
+-- Replaces the contents of out with the control line changes whose timestamps are between from
+-- and to.
+--------------------------------------------------------------------------------------------------*/
+quint32 TimingRecorder::lineEvents(qint64 from, qint64 to, QVector<LineEvent> &out) const
+{
+	out.clear();
+
+	int low = 0;
+	int high = mLineEvents.size();
+	while (low < high)
+	{
+		int middle = (low + high) / 2;
+		if (mLineEvents[middle].timestamp < from)
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+
+	quint32 before = low > 0 ? mLineEvents[low - 1].lines : 0;
+	for (int i = low; i < mLineEvents.size() && mLineEvents[i].timestamp <= to; i++)
+	{
+		out.append(mLineEvents[i]);
+	}
+	return before;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: lastLineTimestamp
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: qint64 lastLineTimestamp (void) const
+--
+-- RETURNS: qint64 - the time of the last control line change, or 0 if there has been none.
+--------------------------------------------------------------------------------------------------*/
+qint64 TimingRecorder::lastLineTimestamp() const
+{
+	return mLineEvents.isEmpty() ? 0 : mLineEvents.last().timestamp;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: addGap
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void addGap (double gap, quint64 count)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Adds count gaps of gap microseconds to the histogram.
+--------------------------------------------------------------------------------------------------*/
+void TimingRecorder::addGap(double gap, quint64 count)
+{
+	quint64 value = static_cast<quint64>(gap);
+	int bucket = 0;
+	while (value != 0 && bucket < HISTOGRAM_BUCKETS - 1)
+	{
+		value >>= 1;
+		bucket++;
+	}
+	mHistogram[bucket] += count;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: putVarint
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void putVarint (QByteArray &column, quint64 value)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Appends value 7 bits at a time, least significant first, with the high bit set on every byte
+-- except the last.
+--------------------------------------------------------------------------------------------------*/
+void TimingRecorder::putVarint(QByteArray &column, quint64 value)
+{
+	while (value >= 0x80)
+	{
+		column.append(static_cast<char>((value & 0x7F) | 0x80));
+		value >>= 7;
+	}
+	column.append(static_cast<char>(value));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: getVarint
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: quint64 getVarint (const char* &p)
+--
+-- RETURNS: quint64 - the value read.
+--
+-- NOTES:
+-- Reads a value written by putVarint and advances p past it.
+--------------------------------------------------------------------------------------------------*/
+quint64 TimingRecorder::getVarint(const char* &p)
+{
+	quint64 value = 0;
+	int shift = 0;
+	unsigned char c;
+	do
+	{
+		c = static_cast<unsigned char>(*p++);
+		value |= static_cast<quint64>(c & 0x7F) << shift;
+		shift += 7;
+	} while (c & 0x80);
+	return value;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QByteArray>
+#include <QVector>
+
+struct TimingBatch
+{
+	qint64 timestamp;
+	int size;
+};
+
+struct LineEvent
+{
+	qint64 timestamp;
+	quint32 lines;
+};
+
+class TimingRecorder
+{
+public:
+	static const int HISTOGRAM_BUCKETS = 32;
+	static const int INDEX_INTERVAL = 1024;
+
+	TimingRecorder();
+
+	void setFormat(qint32 bitRate, int bitsPerCharacter);
+	double byteTime() const;
+
+	void clear();
+	void record(qint64 timestamp, int size);
+	void recordLines(qint64 timestamp, quint32 lines);
+
+	int batchCount() const;
+	qint64 byteCount() const;
+	qint64 firstTimestamp() const;
+	qint64 lastTimestamp() const;
+	int memoryUsage() const;
+
+	const QVector<quint64> &histogram() const;
+	void batches(qint64 from, qint64 to, QVector<TimingBatch> &out) const;
+	quint32 lineEvents(qint64 from, qint64 to, QVector<LineEvent> &out) const;
+	qint64 lastLineTimestamp() const;
+
+private:
+	struct IndexEntry
+	{
+		qint64 base;
+		int deltaOffset;
+		int sizeOffset;
+	};
+
+	double mByteTime;
+
+	QByteArray mDeltas;
+	QByteArray mSizes;
+	QVector<IndexEntry> mIndex;
+
+	int mCount;
+	qint64 mBytes;
+	qint64 mFirst;
+	qint64 mLast;
+
+	QVector<quint64> mHistogram;
+	QVector<LineEvent> mLineEvents;
+
+	void addGap(double gap, quint64 count);
+
+	static void putVarint(QByteArray &column, quint64 value);
+	static quint64 getVarint(const char* &p);
+};
@@ -0,0 +1,305 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: TimingView.cpp - Shows the recorded byte timing.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- void paintHistogram(QPainter &painter, const QRect &area);
+-- void paintTimeline(QPainter &painter, const QRect &area);
+-- void paintLines(QPainter &painter, const QRect &area, qint64 from, double scale);
+--
+-- void paintEvent(QPaintEvent* e);
+-- void wheelEvent(QWheelEvent* e);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- A window split in two. The top half is the inter-byte gap histogram with one bar per power of
+-- two, drawn on a log scale so rare long gaps are still visible next to millions of back to back
+-- bytes. The bottom half is a timeline of the most recent batches, each drawn as a bar from the
+-- estimated arrival of its first byte to its timestamp. Under the batches one row per control
+-- line from the device shows when CTS, DSR, DCD and RI were raised. The mouse wheel zooms the
+-- timeline.
+--
+-- The view repaints itself every REFRESH_INTERVAL milliseconds while it is shown and only decodes
+-- the batches inside the visible window, so leaving it open costs little.
+--------------------------------------------------------------------------------------------------*/
+#include <QPainter>
+#include <QSerialPort>
+#include <QWheelEvent>
+#include <QtMath>
+
+#include "TimingView.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: TimingView (const TimingRecorder*, QWidget*)
+--
+-- NOTES:
+-- Constructor for a view of recorder. The view is a top level window and the timeline starts
+-- out showing the last second.
+--------------------------------------------------------------------------------------------------*/
+TimingView::TimingView(const TimingRecorder* recorder, QWidget* parent)
+	: QWidget(parent, Qt::Window)
+	, mRecorder(recorder)
+	, mWindow(1000000)
+{
+	setWindowTitle(tr("dcTerm - Timing"));
+	resize(640, 480);
+
+	QPalette p = palette();
+	p.setColor(QPalette::Window, Qt::black);
+	p.setColor(QPalette::WindowText, Qt::green);
+	setPalette(p);
+	setAutoFillBackground(true);
+
+	connect(&mRefresh, &QTimer::timeout, this, static_cast<void (QWidget::*)()>(&QWidget::update));
+	mRefresh.start(REFRESH_INTERVAL);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: paintEvent
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void paintEvent (QPaintEvent* e)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Draws the summary line, the histogram and the timeline. The refresh timer's update() does
+-- nothing while the window is hidden.
+--------------------------------------------------------------------------------------------------*/
+void TimingView::paintEvent(QPaintEvent* e)
+{
+	Q_UNUSED(e);
+
+	QPainter painter(this);
+	painter.setPen(palette().color(QPalette::WindowText));
+
+	int line = fontMetrics().height();
+	painter.drawText(4, line, tr("%1 batches, %2 bytes, %3 us per byte, %4 KB recorded")
+		.arg(mRecorder->batchCount())
+		.arg(mRecorder->byteCount())
+		.arg(mRecorder->byteTime(), 0, 'f', 1)
+		.arg(mRecorder->memoryUsage() / 1024));
+
+	QRect body = rect().adjusted(4, line + 4, -4, -4);
+	int half = body.height() / 2;
+	paintHistogram(painter, QRect(body.left(), body.top(), body.width(), half - 4));
+	paintTimeline(painter, QRect(body.left(), body.top() + half + 4, body.width(), body.height() - half - 4));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: paintHistogram
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void paintHistogram (QPainter &painter, const QRect &area)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Draws one bar per histogram bucket with heights on a log scale. Every fourth bucket is labelled
+-- with its lower bound.
+--------------------------------------------------------------------------------------------------*/
+void TimingView::paintHistogram(QPainter &painter, const QRect &area)
+{
+	const QVector<quint64> &histogram = mRecorder->histogram();
+	int label = painter.fontMetrics().height();
+	QRect bars = area.adjusted(0, 0, 0, -label);
+
+	double top = 1.0;
+	for (quint64 count : histogram)
+	{
+		top = qMax(top, std::log10(static_cast<double>(count) + 1.0));
+	}
+
+	double width = static_cast<double>(bars.width()) / histogram.size();
+	for (int i = 0; i < histogram.size(); i++)
+	{
+		int x = bars.left() + static_cast<int>(i * width);
+		int height = static_cast<int>(bars.height() * std::log10(static_cast<double>(histogram[i]) + 1.0) / top);
+		painter.fillRect(x + 1, bars.bottom() - height, qMax(1, static_cast<int>(width) - 2), height, Qt::darkGreen);
+
+		if (i % 4 == 0)
+		{
+			QString bound = i == 0 ? QString("0") : QString::number(1ULL << (i - 1));
+			painter.drawText(x, area.bottom(), bound + "us");
+		}
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: paintTimeline
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Measure text with horizontalAdvance on Qt 5.11 and later, where width is
+--     deprecated.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void paintTimeline (QPainter &painter, const QRect &area)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Draws the batches received and the control line changes in the last mWindow microseconds, the
+-- newest at the right edge. Batches that started before the window but ended inside it are
+-- included by looking back one extra window.
+--------------------------------------------------------------------------------------------------*/
+void TimingView::paintTimeline(QPainter &painter, const QRect &area)
+{
+	int label = painter.fontMetrics().height();
+	int rows = 4 * label;
+	QRect lane = area.adjusted(0, 0, 0, -label - rows);
+	painter.drawRect(lane);
+
+	qint64 to = qMax(mRecorder->lastTimestamp(), mRecorder->lastLineTimestamp());
+	qint64 from = to - mWindow;
+	mRecorder->batches(from - mWindow, to, mVisible);
+
+	double scale = static_cast<double>(lane.width()) / mWindow;
+	for (const TimingBatch &batch : mVisible)
+	{
+		double start = batch.timestamp - (batch.size - 1) * mRecorder->byteTime();
+		int left = lane.left() + static_cast<int>((start - from) * scale);
+		int right = lane.left() + static_cast<int>((batch.timestamp - from) * scale);
+		if (right < lane.left())
+		{
+			continue;
+		}
+		left = qMax(left, lane.left());
+		painter.fillRect(left, lane.top() + 2, qMax(1, right - left), lane.height() - 4, Qt::green);
+	}
+
+	paintLines(painter, QRect(lane.left(), lane.bottom() + 1, lane.width(), rows), from, scale);
+
+	painter.drawText(area.left(), area.bottom(), tr("-%1 ms").arg(mWindow / 1000.0));
+#if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
+	int nowWidth = painter.fontMetrics().horizontalAdvance("now");
+#else
+	int nowWidth = painter.fontMetrics().width("now");
+#endif
+	painter.drawText(area.right() - nowWidth, area.bottom(), "now");
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: paintLines
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Measure the row labels with horizontalAdvance on Qt 5.11 and later.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void paintLines (QPainter &painter, const QRect &area, qint64 from, double scale)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Draws a row each for CTS, DSR, DCD and RI, filled where the line was raised. from and scale
+-- are the timeline's so the rows line up with the batches above them.
+--------------------------------------------------------------------------------------------------*/
+void TimingView::paintLines(QPainter &painter, const QRect &area, qint64 from, double scale)
+{
+	static const quint32 LINES[] = { QSerialPort::ClearToSendSignal, QSerialPort::DataSetReadySignal,
+		QSerialPort::DataCarrierDetectSignal, QSerialPort::RingIndicatorSignal };
+	static const char* const NAMES[] = { "CTS", "DSR", "DCD", "RI" };
+
+	quint32 state = mRecorder->lineEvents(from, from + mWindow, mVisibleLines);
+	int height = area.height() / 4;
+#if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
+	int start = area.left() + painter.fontMetrics().horizontalAdvance("CTS ");
+#else
+	int start = area.left() + painter.fontMetrics().width("CTS ");
+#endif
+
+	for (int row = 0; row < 4; row++)
+	{
+		int top = area.top() + row * height;
+		painter.drawText(area.left(), top + height - 2, NAMES[row]);
+
+		quint32 lines = state;
+		int left = start;
+		for (const LineEvent &event : mVisibleLines)
+		{
+			int x = qMax(start, area.left() + static_cast<int>((event.timestamp - from) * scale));
+			if (lines & LINES[row])
+			{
+				painter.fillRect(left, top + 2, qMax(1, x - left), height - 4, Qt::darkGreen);
+			}
+			lines = event.lines;
+			left = x;
+		}
+		if (lines & LINES[row])
+		{
+			painter.fillRect(left, top + 2, qMax(1, area.right() - left), height - 4, Qt::darkGreen);
+		}
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: wheelEvent
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void wheelEvent (QWheelEvent* e)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Halves or doubles the timeline window, between MIN_WINDOW and MAX_WINDOW microseconds.
+--------------------------------------------------------------------------------------------------*/
+void TimingView::wheelEvent(QWheelEvent* e)
+{
+	if (e->angleDelta().y() > 0 && mWindow / 2 >= MIN_WINDOW)
+	{
+		mWindow /= 2;
+	}
+	else if (e->angleDelta().y() < 0 && mWindow * 2 <= MAX_WINDOW)
+	{
+		mWindow *= 2;
+	}
+	update();
+}
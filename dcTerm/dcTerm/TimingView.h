@@ -0,0 +1,35 @@
+#pragma once
+
+#include <QTimer>
+#include <QVector>
+#include <QWidget>
+
+#include "TimingRecorder.h"
+
+class TimingView
+	: public QWidget
+{
+	Q_OBJECT
+
+public:
+	static const int REFRESH_INTERVAL = 250;
+	static const qint64 MIN_WINDOW = 1000;
+	static const qint64 MAX_WINDOW = 60000000;
+
+	explicit TimingView(const TimingRecorder* recorder, QWidget *parent = nullptr);
+
+private:
+	const TimingRecorder* mRecorder;
+	QTimer mRefresh;
+	qint64 mWindow;
+	QVector<TimingBatch> mVisible;
+	QVector<LineEvent> mVisibleLines;
+
+	void paintHistogram(QPainter &painter, const QRect &area);
+	void paintTimeline(QPainter &painter, const QRect &area);
+	void paintLines(QPainter &painter, const QRect &area, qint64 from, double scale);
+
+protected:
+	void paintEvent(QPaintEvent* e) Q_DECL_OVERRIDE;
+	void wheelEvent(QWheelEvent* e) Q_DECL_OVERRIDE;
+};
@@ -0,0 +1,428 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: TriggerEngine.cpp - Watches the received stream for patterns.
+--
+-- PROGRAM: dcTerm (Data Communication Terminal)
+--
+-- FUNCTIONS:
+-- bool loadRules(const QString &path, QString* error);
+-- void setRules(const QVector<TriggerRule> &rules);
+-- const QVector<TriggerRule> &rules() const;
+-- bool isEmpty() const;
+--
+-- void reset();
+-- void process(const char* data, int size, QVector<TriggerMatch> &matches);
+-- void matchLine(int end, bool complete, QVector<TriggerMatch> &matches);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Run each regex rule on its own, and on the partial line after every chunk.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- A trigger rule pairs a pattern with an action for dcTerm to take when the pattern is received,
+-- such as answering a "login:" prompt or starting a capture when a panic message appears.
+--
+-- Literal patterns are all compiled into one Aho-Corasick automaton so every received byte costs a
+-- single table lookup no matter how many rules are loaded. The automaton state is kept between
+-- chunks, so a pattern split across two reads from the port is still found.
+--
+-- Regular expression patterns are compiled one per rule and run over the line being received, so
+-- rules that match the same text all fire and each keeps its own group numbering for
+-- backreferences. A regex cannot match across a line break. The partial line is searched again at
+-- the end of every chunk so a prompt such as "login:\s*$", which is never followed by a line
+-- ending, fires as soon as it arrives. Each rule remembers where its last match in the line ended
+-- and only searches after it, so a match is reported once however many chunks the line takes.
+-- Because a match is reported as soon as it is seen, a greedy pattern such as "temp=\d+" may fire
+-- on the digits received so far.
+--
+-- Rules are read from a text file with one rule per line and tab separated fields:
+--
+--     <literal|regex> <TAB> <pattern> <TAB> <action> [<TAB> <argument>]
+--
+-- where action is one of send, highlight, capture-start, capture-stop or beep. Literal patterns
+-- and send arguments may use the escapes understood by unescape(). Blank lines and lines starting
+-- with # are ignored.
+--------------------------------------------------------------------------------------------------*/
+#include <QFile>
+#include <QStringList>
+#include <QTextStream>
+
+#include "Escape.h"
+#include "TriggerEngine.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: Constructor
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: TriggerEngine ()
+--
+-- NOTES:
+-- Constructor for an engine with no rules.
+--------------------------------------------------------------------------------------------------*/
+TriggerEngine::TriggerEngine()
+	: mState(0)
+	, mScanned(0)
+{
+	mLine.reserve(MAX_LINE_LENGTH);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: loadRules
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool loadRules (const QString &path, QString* error)
+--
+-- RETURNS: bool - true if every rule in the file was valid and the rules were replaced.
+--
+-- NOTES:
+-- Reads a rule file. If any line is invalid the current rules are kept and error describes the
+-- first bad line.
+--------------------------------------------------------------------------------------------------*/
+bool TriggerEngine::loadRules(const QString &path, QString* error)
+{
+	QFile file(path);
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		*error = file.errorString();
+		return false;
+	}
+
+	QVector<TriggerRule> rules;
+	QTextStream in(&file);
+	int lineNumber = 0;
+
+	while (!in.atEnd())
+	{
+		QString line = in.readLine();
+		lineNumber++;
+
+		if (line.trimmed().isEmpty() || line.trimmed().startsWith('#'))
+		{
+			continue;
+		}
+
+		QStringList fields = line.split('\t');
+		if (fields.size() < 3)
+		{
+			*error = QString("Line %1: expected kind, pattern and action separated by tabs.").arg(lineNumber);
+			return false;
+		}
+
+		TriggerRule rule;
+		QString kind = fields[0].trimmed().toLower();
+		QString action = fields[2].trimmed().toLower();
+		rule.pattern = fields[1];
+		rule.argument = fields.size() > 3 ? fields[3] : QString();
+
+		if (kind == "literal")
+		{
+			rule.kind = TriggerRule::Literal;
+		}
+		else if (kind == "regex")
+		{
+			rule.kind = TriggerRule::Regex;
+			QRegularExpression check(rule.pattern);
+			if (!check.isValid())
+			{
+				*error = QString("Line %1: %2").arg(lineNumber).arg(check.errorString());
+				return false;
+			}
+		}
+		else
+		{
+			*error = QString("Line %1: unknown pattern kind \"%2\".").arg(lineNumber).arg(kind);
+			return false;
+		}
+
+		if (action == "send")
+		{
+			rule.action = TriggerRule::Send;
+		}
+		else if (action == "highlight")
+		{
+			rule.action = TriggerRule::Highlight;
+		}
+		else if (action == "capture-start")
+		{
+			rule.action = TriggerRule::StartCapture;
+		}
+		else if (action == "capture-stop")
+		{
+			rule.action = TriggerRule::StopCapture;
+		}
+		else if (action == "beep")
+		{
+			rule.action = TriggerRule::Beep;
+		}
+		else
+		{
+			*error = QString("Line %1: unknown action \"%2\".").arg(lineNumber).arg(action);
+			return false;
+		}
+
+		rules.append(rule);
+	}
+
+	setRules(rules);
+	return true;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: setRules
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Compile each regex rule separately instead of joining them.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setRules (const QVector<TriggerRule> &rules)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Replaces the rules and compiles them. Literal rules go into the automaton and each regex rule is
+-- compiled and optimized on its own.
+--------------------------------------------------------------------------------------------------*/
+void TriggerEngine::setRules(const QVector<TriggerRule> &rules)
+{
+	mRules = rules;
+
+	mLiterals.clear();
+	mLiteralRules.clear();
+	mRegexes.clear();
+	mRegexRules.clear();
+
+	for (int i = 0; i < mRules.size(); i++)
+	{
+		const TriggerRule &rule = mRules[i];
+		if (rule.kind == TriggerRule::Literal)
+		{
+			mLiterals.addPattern(unescape(rule.pattern));
+			mLiteralRules.append(i);
+		}
+		else
+		{
+			QRegularExpression regex(rule.pattern);
+			regex.optimize();
+			mRegexes.append(regex);
+			mRegexRules.append(i);
+		}
+	}
+
+	mLiterals.build();
+	mRegexOffsets.fill(0, mRegexes.size());
+	reset();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: rules
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: const QVector<TriggerRule> &rules (void) const
+--
+-- RETURNS: const QVector<TriggerRule>& - the rules, indexed by TriggerMatch::rule.
+--------------------------------------------------------------------------------------------------*/
+const QVector<TriggerRule> &TriggerEngine::rules() const
+{
+	return mRules;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: isEmpty
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool isEmpty (void) const
+--
+-- RETURNS: bool - true if there are no rules, in which case process() need not be called.
+--------------------------------------------------------------------------------------------------*/
+bool TriggerEngine::isEmpty() const
+{
+	return mRules.isEmpty();
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: reset
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Also forget where each regex rule last matched in the line.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void reset (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Forgets any partial match, e.g. when a new connection is started.
+--------------------------------------------------------------------------------------------------*/
+void TriggerEngine::reset()
+{
+	mState = 0;
+	mLine.resize(0);
+	mRegexOffsets.fill(0);
+	mScanned = 0;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: process
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Search the partial line at the end of the chunk.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void process (const char* data, int size, QVector<TriggerMatch> &matches)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Scans one chunk of received data and appends every match to matches in the order they end.
+-- TriggerMatch::end is the offset just past the last byte of the match within this chunk, so the
+-- caller can act at exactly the point in the stream where the pattern was seen.
+--
+-- Bytes are only copied into the line buffer when regex rules exist. Lines longer than
+-- MAX_LINE_LENGTH are checked in pieces of that length. Whatever part of a line is left at the end
+-- of the chunk is searched too, and its matches are reported at the end of the chunk.
+--------------------------------------------------------------------------------------------------*/
+void TriggerEngine::process(const char* data, int size, QVector<TriggerMatch> &matches)
+{
+	const bool regex = !mRegexRules.isEmpty();
+
+	for (int i = 0; i < size; i++)
+	{
+		unsigned char c = static_cast<unsigned char>(data[i]);
+
+		mState = mLiterals.next(mState, c);
+		int count = mLiterals.matchCount(mState);
+		if (count > 0)
+		{
+			const int* ids = mLiterals.matches(mState);
+			for (int n = 0; n < count; n++)
+			{
+				TriggerMatch match = { mLiteralRules[ids[n]], i + 1 };
+				matches.append(match);
+			}
+		}
+
+		if (regex)
+		{
+			if (c == '\n' || c == '\r')
+			{
+				matchLine(i + 1, true, matches);
+			}
+			else
+			{
+				mLine.append(static_cast<char>(c));
+				if (mLine.size() >= MAX_LINE_LENGTH)
+				{
+					matchLine(i + 1, true, matches);
+				}
+			}
+		}
+	}
+
+	if (regex && mLine.size() > mScanned)
+	{
+		matchLine(size, false, matches);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: matchLine
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Run every regex rule separately from where its last match ended, and search
+--     partial lines without emptying the buffer.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void matchLine (int end, bool complete, QVector<TriggerMatch> &matches)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Runs each regex rule over the buffered line and reports its new hits at end. A match of no
+-- characters is skipped since it would be found again on every chunk. When complete is true the
+-- line has ended and the buffer and the rules' offsets are cleared for the next line.
+--------------------------------------------------------------------------------------------------*/
+void TriggerEngine::matchLine(int end, bool complete, QVector<TriggerMatch> &matches)
+{
+	if (!mLine.isEmpty())
+	{
+		QString line = QString::fromLocal8Bit(mLine);
+		for (int n = 0; n < mRegexes.size(); n++)
+		{
+			QRegularExpressionMatchIterator it = mRegexes[n].globalMatch(line, mRegexOffsets[n]);
+			while (it.hasNext())
+			{
+				QRegularExpressionMatch hit = it.next();
+				if (hit.capturedLength() == 0)
+				{
+					continue;
+				}
+				TriggerMatch match = { mRegexRules[n], end };
+				matches.append(match);
+				mRegexOffsets[n] = hit.capturedEnd();
+			}
+		}
+	}
+
+	if (complete)
+	{
+		mLine.resize(0);
+		mRegexOffsets.fill(0);
+		mScanned = 0;
+	}
+	else
+	{
+		mScanned = mLine.size();
+	}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <QByteArray>
+#include <QRegularExpression>
+#include <QString>
+#include <QVector>
+
+#include "AhoCorasick.h"
+
+struct TriggerRule
+{
+	enum Kind
+	{
+		Literal,
+		Regex
+	};
+
+	enum Action
+	{
+		Send,
+		Highlight,
+		StartCapture,
+		StopCapture,
+		Beep
+	};
+
+	Kind kind;
+	QString pattern;
+	Action action;
+	QString argument;
+};
+
+struct TriggerMatch
+{
+	int rule;
+	int end;
+};
+
+class TriggerEngine
+{
+public:
+	static const int MAX_LINE_LENGTH = 4096;
+
+	TriggerEngine();
+
+	bool loadRules(const QString &path, QString* error);
+	void setRules(const QVector<TriggerRule> &rules);
+	const QVector<TriggerRule> &rules() const;
+	bool isEmpty() const;
+
+	void reset();
+	void process(const char* data, int size, QVector<TriggerMatch> &matches);
+
+private:
+	QVector<TriggerRule> mRules;
+
+	AhoCorasick mLiterals;
+	QVector<int> mLiteralRules;
+	int mState;
+
+	QVector<QRegularExpression> mRegexes;
+	QVector<int> mRegexRules;
+	QVector<int> mRegexOffsets;
+	QByteArray mLine;
+	int mScanned;
+
+	void matchLine(int end, bool complete, QVector<TriggerMatch> &matches);
+};
@@ -8,6 +8,33 @@
 -- void populatePortMenu();
 -- void createConsole();
 -- void initStatusBarLabels();
+-- void initBridgeMenu();
+-- void initFramingMenu();
+-- void initTriggerMenu();
+-- void initHighlightMenu();
+-- void initCaptureMenu();
+-- void initScriptMenu();
+-- void initExportMenu();
+-- void initTimingMenu();
+-- void initStatisticsMenu();
+-- void initViewMenu();
+-- void initTuningMenu();
+-- void initLinesMenu();
+-- void initBroadcastMenu();
+-- void updateSettingsLabels();
+-- QString parityName(QSerialPort::Parity parity);
+--
+-- bool chooseExportFile(const QString &title, QString* path, ExportWriter::Format* format,
+--                       int* linkType);
+-- bool chooseIgnorePatterns(CaptureDiff* diff);
+-- void showComparison(CaptureDiff &diff, qint64 loaded);
+--
+-- void displayData(const char* data, int size);
+-- void displayFrame(const char* data, int length, FrameDecoder::FrameStatus status, const QTime &time);
+-- void displayTransmitted(const char* data, int size, const QTime &time);
+-- void highlightLine(const QString &color);
+-- void beep();
+-- void showMessage(const QString &message);
 --
 -- void startConnection();
 -- void stopConnection();
@@ -17,15 +44,94 @@
 -- void setParity();
 -- void setStopBits();
 -- void setFlowControl();
+-- void setTuningProfile();
+-- void setReadBufferSize();
+-- void setLowLatency(bool enabled);
+-- void setExclusiveAccess(bool enabled);
+-- void detectSettings();
+-- void detectionFinished(bool found);
+--
+-- void setDataTerminalReady(bool set);
+-- void setRequestToSend(bool set);
+-- void sendBreak();
+-- void updateLines(QSerialPort::PinoutSignals lines);
+--
+-- void addBroadcastPort();
+-- void setBroadcastEnabled(bool enabled);
+-- void showBroadcastStatus();
+-- void broadcastPortDropped(const QString &portName, const QString &message);
+-- void updateBroadcastLabel();
 --
 -- void selectPort();
+-- void selectSimulatedDevice();
 --
--- void writeToPort(QByteArray &data);
--- void readFromPort();
+-- void shareOverTcp();
+-- void shareOverPty();
+-- void stopSharing();
+-- void updateBridgeLabel();
+--
+-- void setFraming();
+-- void setCrcCheck(bool enabled);
+--
+-- void loadTriggers();
+-- void clearTriggers();
+--
+-- void loadHighlights();
+-- void clearHighlights();
+--
+-- void startCapture();
+-- void stopCapture();
+-- void updateCaptureLabel(const QString &fileName);
+-- void compareWithHistory();
+-- void compareCaptures();
+--
+-- void runScript();
+-- void stopScript();
+-- void scriptFinished(bool ok, const QString &message);
+--
+-- void exportHistory();
+-- void exportCapture();
+-- void stopExport();
+-- void updateExportLabel(int percent);
+-- void exportFinished(bool ok, const QString &message);
+--
+-- void setTimingEnabled(bool enabled);
+-- void showTiming();
+-- void clearTiming();
+--
+-- void setLatencyEnabled(bool enabled);
+-- void setLatencyTerminator();
+-- void exportLatency();
+-- void resetLatency();
+--
+-- void showStatistics();
+-- void resetStatistics();
+-- void setMemoryLimit();
+--
+-- void syncHexToConsole();
+-- void syncConsoleToHex(qint64 offset);
 --
 -- DATE: September 29, 2017
 --
--- REVISIONS: N/A
+-- REVISIONS:
+-- October 18, 2026 - Added the bridge menu for sharing the open port over TCP or a pseudo-terminal.
+-- October 18, 2026 - Added the framing menu for decoding SLIP, COBS, length-prefixed and delimited
+--     frames.
+-- October 18, 2026 - Added trigger rules and capture files.
+-- October 18, 2026 - Added the script menu for running automation scripts.
+-- October 18, 2026 - Added per-byte timing capture and the timing view.
+-- October 18, 2026 - Moved the port, its settings and the receive path into SerialSession.
+-- October 18, 2026 - Added a simulated serial device to the port menu.
+-- October 18, 2026 - Added the highlight menu for styling received lines.
+-- October 18, 2026 - Added the statistics window with memory use per subsystem.
+-- October 18, 2026 - Added the hex pane beside the console and the view menu.
+-- October 18, 2026 - Added local echo of sent data to the view menu.
+-- October 18, 2026 - Added answer latency measurement to the timing menu.
+-- October 18, 2026 - Added the export menu for writing out the history and captures.
+-- October 18, 2026 - Added the tuning menu for the port's read buffer, low latency and exclusive
+--     access.
+-- October 18, 2026 - Added detection of the bit rate and framing.
+-- October 18, 2026 - Added control character glyphs to the view menu.
 --
 -- DESIGNER: Benny Wang
 --
@@ -44,18 +150,93 @@
 -- When a serial port is selected and connected with another terminal at the other end of the serial
 -- port all keypresses are sent to the other terminal and vice versa. At this point the user can
 -- either continue to send characters to the other terminal or close the connection.
+--
+-- While connected, the port can also be shared with other local programs through the bridge. Bytes
+-- read from the port are displayed and then handed to every bridge client, and anything a client
+-- sends is written to the port as if it had been typed.
+--
+-- When a framing is selected, received bytes pass through a frame decoder before reaching the
+-- console and each decoded frame is displayed as one row instead of as a raw byte stream.
+--
+-- Received bytes are also checked against the loaded trigger rules. When a rule matches, its
+-- action is carried out at the exact point in the stream where the pattern ended: everything
+-- before the match is displayed and captured first, then the action runs, then the rest of the
+-- chunk is processed.
+--
+-- The Export menu writes the received history or a capture file out as text, a hex dump, CSV or
+-- pcap. Exports run on their own thread and stream, so a capture of any size can be exported
+-- while the port stays in use.
+--
+-- A script run from the Script menu sees every received byte and writes to the port through the
+-- same path as the keyboard. Scripts run on their own thread, so a script waiting on the device
+-- never holds up the window or the reading of the port.
+--
+-- When timing is recorded, the time and size of every read from the port are kept so the gaps
+-- between bytes can be studied in the timing view.
+--
+-- When latency is measured, every line sent is timed until the device answers it. The percentiles
+-- are shown in the statistics window and the distribution can be exported as CSV.
+--
+-- The port and everything done with its data lives in SerialSession, which has no widgets. This
+-- window holds the settings menus and implements SessionView so the session can show what it
+-- receives.
+--
+-- Everything that grows with traffic, the console included, is charged to the session's memory
+-- budget and kept within its limits. The statistics window shows the current and peak use, and
+-- the limits can be changed from the Statistics menu.
+--
+-- Highlight rules style the lines shown in the console, e.g. errors in red, without changing what
+-- is received or captured.
+--
+-- A simulated device can be picked from the port menu in place of a real port. It generates or
+-- replays traffic at a chosen rate, with optional errors, so the program can be load tested
+-- without hardware.
+--
+-- With Local Echo on in the View menu, what is sent is shown in the console among what is received,
+-- in its own color, for devices that do not echo.
+--
+-- The hex pane from the View menu shows the same traffic as the console as a hex dump. It is drawn
+-- from the session's receive history rather than a copy of its own, and scrolling either pane
+-- scrolls the other to the same line.
 --------------------------------------------------------------------------------------------------*/
 #include <QAction>
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QInputDialog>
+#include <QLineEdit>
 #include <QMessageBox>
+#include <QScrollBar>
+#include <QSignalBlocker>
+#include <QSplitter>
 
 #include "dcTerm.h"
+#include "Escape.h"
+#include "SimulatedSerialDevice.h"
 
 /*--------------------------------------------------------------------------------------------------
 -- FUNCTION: Constructor
 --
 -- DATE: September 29, 2017
 --
--- REVISIONS: N/A
+-- REVISIONS:
+-- October 18, 2026 - Creates the serial bridge and connects it to the port.
+-- October 18, 2026 - Creates the framing menu.
+-- October 18, 2026 - Creates the trigger and capture menus.
+-- October 18, 2026 - Creates the script runner and the script menu.
+-- October 18, 2026 - Creates the timing menu.
+-- October 18, 2026 - Creates the serial session and connects the bridge and scripts to it.
+-- October 18, 2026 - Creates the highlight menu.
+-- October 18, 2026 - Creates the statistics menu and charges the console to the session's
+--     budget.
+-- October 18, 2026 - Creates the view menu and keeps the hex pane in step with the console.
+-- October 18, 2026 - Creates the exporter and the export menu.
+-- October 18, 2026 - Creates the tuning menu.
+-- October 18, 2026 - Connects detection of the bit rate and framing.
+-- October 18, 2026 - Creates the lines menu and shows the control lines.
+-- October 18, 2026 - Creates the broadcast group and sends the console's input to it.
 --
 -- DESIGNER: Benny Wang
 --
@@ -66,7 +247,7 @@
 -- NOTES:
 -- Constructor for the main window of the appliaction.
 --
--- The constructor sets these basic settings for the serial port:
+-- The serial port starts with the default settings of SerialSession:
 -- - Port Name: NULL
 -- - Baud Rate: 2400 bps
 -- - Data Bits: 8
@@ -79,24 +260,76 @@
 --------------------------------------------------------------------------------------------------*/
 dcTerm::dcTerm(QWidget* parent)
 	: QMainWindow(parent)
-	, mPortName("")
-	, mBitRate(2400)
-	, mDataBits(QSerialPort::Data8)
-	, mParity(QSerialPort::NoParity)
-	, mStopBits(QSerialPort::OneStop)
-	, mControl(QSerialPort::HardwareControl)
+	, mSyncing(false)
+	, mTimingView(nullptr)
+	, mStatisticsView(nullptr)
+	, mDiffView(nullptr)
 {
 	ui.setupUi(this);
-	mPort = new QSerialPort(this);
+	mSession = new SerialSession(this);
+	mSession->setView(this);
+	mBridge = new SerialBridge(this);
+	mBroadcast = new BroadcastGroup(this);
+	mScript = new ScriptRunner(this);
+	mExporter = new StreamExporter(this);
 	setWindowTitle(TITLE_DISCONNECTED);
 	initMenuConnections();
+	initBridgeMenu();
+	initFramingMenu();
+	initTriggerMenu();
+	initHighlightMenu();
+	initCaptureMenu();
+	initScriptMenu();
+	initExportMenu();
+	initTimingMenu();
+	initStatisticsMenu();
 	initStatusBarLabels();
 	populatePortMenu();
 	createConsole();
+	console->SetMemoryBudget(&mSession->budget());
+	initViewMenu();
+	initTuningMenu();
+	initLinesMenu();
+	initBroadcastMenu();
 
 	// Conencting port functionality
-	connect(mPort, &QSerialPort::readyRead, this, &dcTerm::readFromPort);
-	connect(console, &Console::emitKeyPressed, this, &dcTerm::writeToPort);
+	connect(console, &Console::emitKeyPressed, mSession, &SerialSession::write);
+	connect(mSession, &SerialSession::captureChanged, this, &dcTerm::updateCaptureLabel);
+
+	// Connecting bridge functionality
+	connect(mSession, &SerialSession::received, mBridge, &SerialBridge::broadcast);
+	connect(mBridge, &SerialBridge::dataFromClient, mSession, &SerialSession::write);
+	connect(mBridge, &SerialBridge::clientCountChanged, this, &dcTerm::updateBridgeLabel);
+
+	// Connecting script functionality
+	connect(mSession, &SerialSession::received, mScript, &ScriptRunner::feed);
+	connect(mScript, &ScriptRunner::sendRequested, mSession, &SerialSession::write);
+	connect(mScript, &ScriptRunner::logMessage, ui.statusBar, [this](const QString &message)
+	{
+		ui.statusBar->showMessage(message);
+	});
+	connect(mScript, &ScriptRunner::finished, this, &dcTerm::scriptFinished);
+
+	// Connecting export functionality
+	connect(mExporter, &StreamExporter::progress, this, &dcTerm::updateExportLabel);
+	connect(mExporter, &StreamExporter::finished, this, &dcTerm::exportFinished);
+
+	// Connecting the hex pane
+	connect(mSession, &SerialSession::received, mHexView, &HexView::refresh);
+	connect(console->verticalScrollBar(), &QScrollBar::valueChanged, this, &dcTerm::syncHexToConsole);
+	connect(mHexView, &HexView::scrolled, this, &dcTerm::syncConsoleToHex);
+
+	// Connecting detection of the bit rate and framing
+	connect(mSession, &SerialSession::detectionFinished, this, &dcTerm::detectionFinished);
+
+	// Connecting the control lines
+	connect(mSession, &SerialSession::linesChanged, this, &dcTerm::updateLines);
+
+	// Connecting broadcast to the other ports in the group
+	connect(console, &Console::emitKeyPressed, mBroadcast, &BroadcastGroup::write);
+	connect(mScript, &ScriptRunner::sendRequested, mBroadcast, &BroadcastGroup::write);
+	connect(mBroadcast, &BroadcastGroup::membersChanged, this, &dcTerm::updateBroadcastLabel);
+	connect(mBroadcast, &BroadcastGroup::portDropped, this, &dcTerm::broadcastPortDropped);
 }
 
 /*--------------------------------------------------------------------------------------------------
@@ -104,7 +337,15 @@ dcTerm::dcTerm(QWidget* parent)
 --
 -- DATE: September 29, 2017
 --
--- REVISIONS: N/A
+-- REVISIONS:
+-- October 18, 2026 - Deletes the bridge and its status label.
+-- October 18, 2026 - Deletes the frame decoder and its status label.
+-- October 18, 2026 - Deletes the trigger and capture status labels.
+-- October 18, 2026 - Stops any running script and deletes its status label.
+-- October 18, 2026 - Deletes the timing view.
+-- October 18, 2026 - Deletes the serial session in place of the port and frame decoder.
+-- October 18, 2026 - Deletes the statistics window.
+-- October 18, 2026 - Stops any running export and deletes its status label.
 --
 -- DESIGNER: Benny Wang
 --
@@ -127,8 +368,20 @@ dcTerm::~dcTerm()
 	delete mParityLabel;
 	delete mStopBitsLabel;
 	delete mControlLabel;
+	delete mBridgeLabel;
+	delete mFramingLabel;
+	delete mTriggersLabel;
+	delete mCaptureLabel;
+	delete mScriptLabel;
+	delete mExportLabel;
 
-	delete mPort;
+	delete mScript;
+	delete mExporter;
+	delete mTimingView;
+	delete mStatisticsView;
+
+	delete mBridge;
+	delete mSession;
 }
 
 /*-------------------------------------------------------------------------------------------------
@@ -136,7 +389,8 @@ dcTerm::~dcTerm()
 --
 -- DATE: September 29, 2017
 --
--- REVISIONS: N/A
+-- REVISIONS:
+-- October 18, 2026 - Adds Auto Detect to the File menu.
 --
 -- DESIGNER: Benny Wang
 --
@@ -149,6 +403,9 @@ dcTerm::~dcTerm()
 -- NOTES:
 -- Creates all the signal-slot connections for the menu elements.
 --
+-- Auto Detect sits in the File menu with Connect and Disconnect rather than under Settings, since
+-- Settings is disabled while connected and detecting runs on a connected port.
+--
 -- Signal and slots are the way components talk to each other when using Qt.
 --------------------------------------------------------------------------------------------------*/
 void dcTerm::initMenuConnections()
@@ -160,6 +417,11 @@ void dcTerm::initMenuConnections()
 	connect(ui.actionConnect, &QAction::triggered, this, &dcTerm::startConnection);
 	connect(ui.actionDisconnect, &QAction::triggered, this, &dcTerm::stopConnection);
 
+	// Detecting the bit rate and framing
+	QAction* detect = new QAction(tr("Auto Detect"), this);
+	ui.menuFile->insertAction(ui.actionClose, detect);
+	connect(detect, &QAction::triggered, this, &dcTerm::detectSettings);
+
 	// Setting bit rate 
 	connect(ui.action1200, &QAction::triggered, this, &dcTerm::setBitRate);
 	connect(ui.action2400, &QAction::triggered, this, &dcTerm::setBitRate);
@@ -196,7 +458,15 @@ void dcTerm::initMenuConnections()
 --
 -- DATE: September 29, 2017
 --
--- REVISIONS: N/A
+-- REVISIONS:
+-- October 18, 2026 - Added the bridge label.
+-- October 18, 2026 - Added the framing label.
+-- October 18, 2026 - Added the trigger and capture labels.
+-- October 18, 2026 - Added the script label.
+-- October 18, 2026 - Reads the initial baud rate from the serial session.
+-- October 18, 2026 - Adds the export label.
+-- October 18, 2026 - Adds the control lines label.
+-- October 18, 2026 - Adds the broadcast label.
 --
 -- DESIGNER: Benny Wang
 --
@@ -218,13 +488,29 @@ void dcTerm::initStatusBarLabels()
 	mParityLabel = new QLabel(ui.statusBar);
 	mStopBitsLabel = new QLabel(ui.statusBar);
 	mControlLabel = new QLabel(ui.statusBar);
+	mBridgeLabel = new QLabel(ui.statusBar);
+	mFramingLabel = new QLabel(ui.statusBar);
+	mTriggersLabel = new QLabel(ui.statusBar);
+	mCaptureLabel = new QLabel(ui.statusBar);
+	mScriptLabel = new QLabel(ui.statusBar);
+	mExportLabel = new QLabel(ui.statusBar);
+	mLinesLabel = new QLabel(ui.statusBar);
+	mBroadcastLabel = new QLabel(ui.statusBar);
 
 	mPortLabel->setText(PORT_LABEL_TEXT.arg("N/A"));
-	mBitRateLabel->setText(BIT_RATE_LABEL_TEXT.arg(mBitRate));
+	mBitRateLabel->setText(BIT_RATE_LABEL_TEXT.arg(mSession->settings().bitRate));
 	mDataBitsLabel->setText(DATA_BIT_LABEL_TEXT.arg(8));
 	mParityLabel->setText(PARITY_LABEL_TEXT.arg("None"));
 	mStopBitsLabel->setText(STOP_BITS_LABEL_TEXT.arg(1));
 	mControlLabel->setText(FLOW_CONTROL_LABEL_TEXT.arg("Hardware Control"));
+	mBridgeLabel->setText(BRIDGE_LABEL_TEXT.arg("Off"));
+	mFramingLabel->setText(FRAMING_LABEL_TEXT.arg("None"));
+	mTriggersLabel->setText(TRIGGERS_LABEL_TEXT.arg(0));
+	mCaptureLabel->setText(CAPTURE_LABEL_TEXT.arg("Off"));
+	mScriptLabel->setText(SCRIPT_LABEL_TEXT.arg("None"));
+	mExportLabel->setText(EXPORT_LABEL_TEXT.arg("None"));
+	mLinesLabel->setText(LINES_LABEL_TEXT.arg("N/A"));
+	mBroadcastLabel->setText(BROADCAST_LABEL_TEXT.arg("Off"));
 
 	ui.statusBar->addWidget(mPortLabel);
 	ui.statusBar->addWidget(mBitRateLabel);
@@ -232,12 +518,20 @@ void dcTerm::initStatusBarLabels()
 	ui.statusBar->addWidget(mParityLabel);
 	ui.statusBar->addWidget(mStopBitsLabel);
 	ui.statusBar->addWidget(mControlLabel);
+	ui.statusBar->addWidget(mBridgeLabel);
+	ui.statusBar->addWidget(mFramingLabel);
+	ui.statusBar->addWidget(mTriggersLabel);
+	ui.statusBar->addWidget(mCaptureLabel);
+	ui.statusBar->addWidget(mScriptLabel);
+	ui.statusBar->addWidget(mExportLabel);
+	ui.statusBar->addWidget(mLinesLabel);
+	ui.statusBar->addWidget(mBroadcastLabel);
 }
 
 /*-------------------------------------------------------------------------------------------------
--- FUNCTION: populatePortMenu
+-- FUNCTION: initBridgeMenu
 --
--- DATE: September 29, 2017
+-- DATE: October 18, 2026
 --
 -- REVISIONS: N/A
 --
@@ -245,41 +539,36 @@ void dcTerm::initStatusBarLabels()
 --
 -- PROGRAMMER: Benny Wang
 --
--- INTERFACE: void populatePortMenu (void)
+-- INTERFACE: void initBridgeMenu (void)
 --
 -- RETURNS: void.
 --
 -- NOTES:
--- Populates the port menu with the list of available communication ports on the computer.
+-- Creates the Bridge menu and connects its actions. The menu is built here rather than in the
+-- designer form because it only exposes actions on the SerialBridge.
 --------------------------------------------------------------------------------------------------*/
-void dcTerm::populatePortMenu()
+void dcTerm::initBridgeMenu()
 {
-	QList<QSerialPortInfo> ports = QSerialPortInfo::availablePorts();
-	if (ports.size() == 0)
-	{
-		ui.menuPort->setEnabled(false);
-		setWindowTitle(TITLE_UNDETECTABLE);
-		return;
-	}
-
-	QAction* action;
+	QMenu* menuBridge = ui.menuBar->addMenu(tr("Bridge"));
 
-	for (int i = 0; i < ports.size(); i++)
-	{
-		action = new QAction(this);
-		action->setObjectName(ports[i].portName());
-		action->setText(ports[i].portName());
+	QAction* actionTcp = menuBridge->addAction(tr("Share over TCP..."));
+	QAction* actionPty = menuBridge->addAction(tr("Share over Pseudo-Terminal"));
+	menuBridge->addSeparator();
+	QAction* actionStop = menuBridge->addAction(tr("Stop Sharing"));
 
-		ui.menuPort->addAction(action);
+#ifndef Q_OS_UNIX
+	actionPty->setEnabled(false);
+#endif
 
-		connect(action, &QAction::triggered, this, &dcTerm::selectPort);
-	}
+	connect(actionTcp, &QAction::triggered, this, &dcTerm::shareOverTcp);
+	connect(actionPty, &QAction::triggered, this, &dcTerm::shareOverPty);
+	connect(actionStop, &QAction::triggered, this, &dcTerm::stopSharing);
 }
 
 /*-------------------------------------------------------------------------------------------------
--- FUNCTION: createConsole
+-- FUNCTION: initFramingMenu
 --
--- DATE: September 29, 2017
+-- DATE: October 18, 2026
 --
 -- REVISIONS: N/A
 --
@@ -287,24 +576,36 @@ void dcTerm::populatePortMenu()
 --
 -- PROGRAMMER: Benny Wang
 --
--- INTERFACE: void createConsole (void)
+-- INTERFACE: void initFramingMenu (void)
 --
 -- RETURNS: void.
 --
 -- NOTES:
--- Creates the console where incoming characters are displayed.
+-- Creates the Framing menu. Unlike the port settings, framing can be changed while connected so
+-- the menu lives outside of the Settings menu, which is disabled during a connection.
 --------------------------------------------------------------------------------------------------*/
-void dcTerm::createConsole()
+void dcTerm::initFramingMenu()
 {
-	console = new Console(this);
-	setCentralWidget(console);
-	console->setEnabled(false);
+	QMenu* menuFraming = ui.menuBar->addMenu(tr("Framing"));
+
+	QStringList framings;
+	framings << "None" << "SLIP" << "COBS" << "Length-Prefixed..." << "Delimiter...";
+	for (const QString &framing : framings)
+	{
+		QAction* action = menuFraming->addAction(framing);
+		connect(action, &QAction::triggered, this, &dcTerm::setFraming);
+	}
+
+	menuFraming->addSeparator();
+	QAction* actionCrc = menuFraming->addAction(tr("Check CRC-16"));
+	actionCrc->setCheckable(true);
+	connect(actionCrc, &QAction::toggled, this, &dcTerm::setCrcCheck);
 }
 
 /*-------------------------------------------------------------------------------------------------
--- FUNCTION: startConnection
+-- FUNCTION: initTriggerMenu
 --
--- DATE: September 29, 2017
+-- DATE: October 18, 2026
 --
 -- REVISIONS: N/A
 --
@@ -312,50 +613,24 @@ void dcTerm::createConsole()
 --
 -- PROGRAMMER: Benny Wang
 --
--- INTERFACE: void startConnection (void)
+-- INTERFACE: void initTriggerMenu (void)
 --
 -- RETURNS: void.
 --
 -- NOTES:
--- Creats a new QSerialPort object, sets the settings chosen by the users, and starts the serial
--- port connection. If the port has openned, menu items are disabled/enabled accordingly and
--- the window title is changed to show that the connection is openned.
---
--- QSerialPort is the Qt interface for interaction with a serial port on a computer.
+-- Creates the Triggers menu for loading and clearing trigger rules.
 --------------------------------------------------------------------------------------------------*/
-void dcTerm::startConnection()
+void dcTerm::initTriggerMenu()
 {
-	mPort->setPortName(mPortName);
-	mPort->setBaudRate(mBitRate);
-	mPort->setDataBits(mDataBits);
-	mPort->setParity(mParity);
-	mPort->setStopBits(mStopBits);
-	mPort->setFlowControl(mControl);
-
-	setWindowTitle(TITLE_CONNECTING);
-	bool openned = mPort->open(QIODevice::ReadWrite);
-	
-
-	if (openned)
-	{
-		ui.actionConnect->setEnabled(false);
-		ui.actionDisconnect->setEnabled(true);
-		console->setEnabled(true);
-		ui.menuSettings->setEnabled(false);
-		ui.menuPort->setEnabled(false);
-		setWindowTitle(TITLE_CONNECTED.arg(mPortName));
-	}
-	else
-	{
-		QMessageBox::critical(this, tr("Error"), mPort->errorString());
-		ui.statusBar->showMessage(ERROR_CANNOT_OPEN);
-	}
+	QMenu* menuTriggers = ui.menuBar->addMenu(tr("Triggers"));
+	connect(menuTriggers->addAction(tr("Load Rules...")), &QAction::triggered, this, &dcTerm::loadTriggers);
+	connect(menuTriggers->addAction(tr("Clear Rules")), &QAction::triggered, this, &dcTerm::clearTriggers);
 }
 
 /*-------------------------------------------------------------------------------------------------
--- FUNCTION: stopConnection
+-- FUNCTION: initHighlightMenu
 --
--- DATE: September 29, 2017
+-- DATE: October 18, 2026
 --
 -- REVISIONS: N/A
 --
@@ -363,62 +638,55 @@ void dcTerm::startConnection()
 --
 -- PROGRAMMER: Benny Wang
 --
--- INTERFACE: void stopConnection (void)
+-- INTERFACE: void initHighlightMenu (void)
 --
 -- RETURNS: void.
 --
 -- NOTES:
--- Closes the serial port connection if it is open. If a port was closed, menu items are
--- enabled/disabled accordingly and the window title is changed to show that the port has been
--- disconnected.
+-- Creates the Highlight menu for loading and clearing highlight rules.
 --------------------------------------------------------------------------------------------------*/
-void dcTerm::stopConnection()
+void dcTerm::initHighlightMenu()
 {
-	if (mPort->isOpen())
-	{
-		mPort->flush();
-		mPort->close();
-		ui.actionConnect->setEnabled(true);
-		ui.actionDisconnect->setEnabled(false);
-		console->setEnabled(false);
-		ui.menuSettings->setEnabled(true);
-		ui.menuPort->setEnabled(true);
-		setWindowTitle(TITLE_DISCONNECTED);
-	}
+	QMenu* menuHighlight = ui.menuBar->addMenu(tr("Highlight"));
+	connect(menuHighlight->addAction(tr("Load Rules...")), &QAction::triggered, this, &dcTerm::loadHighlights);
+	connect(menuHighlight->addAction(tr("Clear Rules")), &QAction::triggered, this, &dcTerm::clearHighlights);
 }
 
 /*-------------------------------------------------------------------------------------------------
--- FUNCTION: setBitRate
+-- FUNCTION: initCaptureMenu
 --
--- DATE: September 29, 2017
+-- DATE: October 18, 2026
 --
--- REVISIONS: N/A
+-- REVISIONS:
+-- October 18, 2026 - Adds comparing captures.
 --
 -- DESIGNER: Benny Wang
 --
 -- PROGRAMMER: Benny Wang
 --
--- INTERFACE: void setBitRate (void)
+-- INTERFACE: void initCaptureMenu (void)
 --
 -- RETURNS: void.
 --
 -- NOTES:
--- This function is a Qt slot and is triggered when a menu item concerning baud rate is selected.
---
--- Saves the selected bit rate to a variable and changes the label in the status bar to reflect the
--- change.
+-- Creates the Capture menu for recording traffic to a capture file and comparing captures.
 --------------------------------------------------------------------------------------------------*/
-void dcTerm::setBitRate()
+void dcTerm::initCaptureMenu()
 {
-	QString bitRate(((QAction*)QObject::sender())->text());
-	mBitRate = bitRate.toInt();
-	mBitRateLabel->setText(BIT_RATE_LABEL_TEXT.arg(bitRate));
+	QMenu* menuCapture = ui.menuBar->addMenu(tr("Capture"));
+	connect(menuCapture->addAction(tr("Start Capture...")), &QAction::triggered, this, &dcTerm::startCapture);
+	connect(menuCapture->addAction(tr("Stop Capture")), &QAction::triggered, this, &dcTerm::stopCapture);
+	menuCapture->addSeparator();
+	connect(menuCapture->addAction(tr("Compare with Known-Good...")), &QAction::triggered, this,
+		&dcTerm::compareWithHistory);
+	connect(menuCapture->addAction(tr("Compare Two Captures...")), &QAction::triggered, this,
+		&dcTerm::compareCaptures);
 }
 
 /*-------------------------------------------------------------------------------------------------
--- FUNCTION: setDataBits
+-- FUNCTION: initScriptMenu
 --
--- DATE: September 29, 2017
+-- DATE: October 18, 2026
 --
 -- REVISIONS: N/A
 --
@@ -426,28 +694,24 @@ void dcTerm::setBitRate()
 --
 -- PROGRAMMER: Benny Wang
 --
--- INTERFACE: void setDataBits (void)
+-- INTERFACE: void initScriptMenu (void)
 --
 -- RETURNS: void.
 --
 -- NOTES:
--- This function is a Qt slot and is triggered when a menu item concerning the number of data
--- bits used is selected.
---
--- Saves the number of data bits to a variable and changes the label in the status bar to reflect
--- the change.
+-- Creates the Script menu for running automation scripts against the port.
 --------------------------------------------------------------------------------------------------*/
-void dcTerm::setDataBits()
+void dcTerm::initScriptMenu()
 {
-	QString dataBits(((QAction*)QObject::sender())->text());
-	mDataBits = static_cast<QSerialPort::DataBits> (dataBits.toInt());
-	mDataBitsLabel->setText(DATA_BIT_LABEL_TEXT.arg(dataBits));
+	QMenu* menuScript = ui.menuBar->addMenu(tr("Script"));
+	connect(menuScript->addAction(tr("Run Script...")), &QAction::triggered, this, &dcTerm::runScript);
+	connect(menuScript->addAction(tr("Stop Script")), &QAction::triggered, this, &dcTerm::stopScript);
 }
 
 /*-------------------------------------------------------------------------------------------------
--- FUNCTION: setParity
+-- FUNCTION: initExportMenu
 --
--- DATE: September 29, 2017
+-- DATE: October 18, 2026
 --
 -- REVISIONS: N/A
 --
@@ -455,134 +719,195 @@ void dcTerm::setDataBits()
 --
 -- PROGRAMMER: Benny Wang
 --
--- INTERFACE: void setParity (void)
+-- INTERFACE: void initExportMenu (void)
 --
 -- RETURNS: void.
 --
 -- NOTES:
--- This function is a Qt slot and is triggered when a menu item concerning signal parity is
--- selected.
+-- Creates the Export menu for writing out the received history or a capture file.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::initExportMenu()
+{
+	QMenu* menuExport = ui.menuBar->addMenu(tr("Export"));
+	connect(menuExport->addAction(tr("Export History...")), &QAction::triggered, this, &dcTerm::exportHistory);
+	connect(menuExport->addAction(tr("Export Capture...")), &QAction::triggered, this, &dcTerm::exportCapture);
+	connect(menuExport->addAction(tr("Stop Export")), &QAction::triggered, this, &dcTerm::stopExport);
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: initTimingMenu
 --
--- Saves the number of parity bits to a variable and changes the label in the status bar to reflect
--- the change.
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Unchecks Record Timing when the session stops recording at its memory
+--     limit.
+-- October 18, 2026 - Adds the latency measurement actions.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void initTimingMenu (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Creates the Timing menu for recording when bytes arrive and showing the recorded timing, and
+-- for measuring how long the device takes to answer.
 --------------------------------------------------------------------------------------------------*/
-void dcTerm::setParity()
+void dcTerm::initTimingMenu()
 {
-	QString parity(((QAction*)QObject::sender())->text());
-	mParityLabel->setText(PARITY_LABEL_TEXT.arg(parity));
-	if (parity == QString("Even"))
-	{
-		mParity = QSerialPort::EvenParity;
-	}
-	if (parity == QString("Odd"))
-	{
-		mParity = QSerialPort::OddParity;
-	}
-	if (parity == QString("None"))
+	QMenu* menuTiming = ui.menuBar->addMenu(tr("Timing"));
+
+	QAction* record = menuTiming->addAction(tr("Record Timing"));
+	record->setCheckable(true);
+	connect(record, &QAction::toggled, this, &dcTerm::setTimingEnabled);
+	connect(mSession, &SerialSession::timingStopped, record, [record]()
 	{
-		mParity = QSerialPort::NoParity;
-	}
+		record->setChecked(false);
+	});
+
+	connect(menuTiming->addAction(tr("Show Timing...")), &QAction::triggered, this, &dcTerm::showTiming);
+	connect(menuTiming->addAction(tr("Clear Timing")), &QAction::triggered, this, &dcTerm::clearTiming);
+
+	menuTiming->addSeparator();
+	QAction* measure = menuTiming->addAction(tr("Measure Latency"));
+	measure->setCheckable(true);
+	connect(measure, &QAction::toggled, this, &dcTerm::setLatencyEnabled);
+	connect(menuTiming->addAction(tr("Answer Terminator...")), &QAction::triggered, this,
+		&dcTerm::setLatencyTerminator);
+	connect(menuTiming->addAction(tr("Export Latency...")), &QAction::triggered, this, &dcTerm::exportLatency);
+	connect(menuTiming->addAction(tr("Reset Latency")), &QAction::triggered, this, &dcTerm::resetLatency);
 }
 
 /*-------------------------------------------------------------------------------------------------
--- FUNCTION: setStopBits
+-- FUNCTION: initStatisticsMenu
 --
--- DATE: September 29, 2017
+-- DATE: October 18, 2026
 --
--- REVISIONS: N/A
+-- REVISIONS:
+-- October 18, 2026 - Added Memory Limits.
 --
 -- DESIGNER: Benny Wang
 --
 -- PROGRAMMER: Benny Wang
 --
--- INTERFACE: void setStopBits (void)
+-- INTERFACE: void initStatisticsMenu (void)
 --
 -- RETURNS: void.
 --
 -- NOTES:
--- This function is a Qt slot and is triggered when a menu item concerning the number of stop bits
--- is selected.
---
--- Saves the number of stop bits to a variable and changes the label in the status bar to reflect
--- the change.
+-- Creates the Statistics menu for showing and resetting the session's statistics and setting its
+-- memory limits.
 --------------------------------------------------------------------------------------------------*/
-void dcTerm::setStopBits()
+void dcTerm::initStatisticsMenu()
 {
-	QString stopBits(((QAction*)QObject::sender())->text());
-	mStopBits = static_cast<QSerialPort::StopBits> (stopBits.toInt());
-	mStopBitsLabel->setText(STOP_BITS_LABEL_TEXT.arg(stopBits));
+	QMenu* menuStatistics = ui.menuBar->addMenu(tr("Statistics"));
+	connect(menuStatistics->addAction(tr("Show Statistics...")), &QAction::triggered, this,
+		&dcTerm::showStatistics);
+	connect(menuStatistics->addAction(tr("Reset Statistics")), &QAction::triggered, this,
+		&dcTerm::resetStatistics);
+	menuStatistics->addSeparator();
+	connect(menuStatistics->addAction(tr("Memory Limits...")), &QAction::triggered, this,
+		&dcTerm::setMemoryLimit);
 }
 
 /*-------------------------------------------------------------------------------------------------
--- FUNCTION: setFlowControl
+-- FUNCTION: initViewMenu
 --
--- DATE: September 29, 2017
+-- DATE: October 18, 2026
 --
--- REVISIONS: N/A
+-- REVISIONS:
+-- October 18, 2026 - Added Control Characters.
+-- October 18, 2026 - Keeps the Hex Pane action so a comparison can open the pane.
 --
 -- DESIGNER: Benny Wang
 --
 -- PROGRAMMER: Benny Wang
 --
--- INTERFACE: void setFlowControl (void)
+-- INTERFACE: void initViewMenu (void)
 --
 -- RETURNS: void.
 --
 -- NOTES:
--- This function is a Qt slot and is triggered when a menu item concerning flow control is selected.
---
--- Saves the flow control setting to a variable and changes the label in the status bar to reflect
--- the change.
+-- Creates the View menu for turning local echo on and off and showing and hiding the hex pane.
+-- Control Characters shows control characters in caret notation, e.g. ^@ for NUL, and bytes that
+-- are not valid UTF-8 as their hex value, e.g. <FF>, instead of dropping them from the console.
 --------------------------------------------------------------------------------------------------*/
-void dcTerm::setFlowControl()
+void dcTerm::initViewMenu()
 {
-	QString flowControl(((QAction*)QObject::sender())->text());
-	mControlLabel->setText(FLOW_CONTROL_LABEL_TEXT.arg(flowControl));
-	if (flowControl == QString("No Flow Control"))
-	{
-		mControl = QSerialPort::NoFlowControl;
-	}
-	if (flowControl == QString("Hardware Control"))
-	{
-		mControl = QSerialPort::HardwareControl;
-	}
-	if (flowControl == QString("Software Control"))
+	QMenu* menuView = ui.menuBar->addMenu(tr("View"));
+	QAction* echo = menuView->addAction(tr("Local Echo"));
+	echo->setCheckable(true);
+	connect(echo, &QAction::toggled, mSession, &SerialSession::setEcho);
+
+	mHexPaneAction = menuView->addAction(tr("Hex Pane"));
+	mHexPaneAction->setCheckable(true);
+	connect(mHexPaneAction, &QAction::toggled, this, [this](bool checked)
 	{
-		mControl = QSerialPort::SoftwareControl;
-	}
+		mHexView->setVisible(checked);
+		syncHexToConsole();
+	});
+
+	QAction* controls = menuView->addAction(tr("Control Characters"));
+	controls->setCheckable(true);
+	connect(controls, &QAction::toggled, console, &Console::SetShowControlCharacters);
 }
 
 /*-------------------------------------------------------------------------------------------------
--- FUNCTION: selectPort
+-- FUNCTION: initTuningMenu
 --
--- DATE: September 29, 2017
+-- DATE: October 18, 2026
 --
--- REVISIONS: N/A
+-- REVISIONS:
+-- October 18, 2026 - The default read buffer is bounded by the receive memory limit.
+-- October 18, 2026 - Auto Detect moved to the File menu.
 --
 -- DESIGNER: Benny Wang
 --
 -- PROGRAMMER: Benny Wang
 --
--- INTERFACE: void selectPort (void)
+-- INTERFACE: void initTuningMenu (void)
 --
 -- RETURNS: void.
 --
 -- NOTES:
--- This function is a Qt slot and is triggered when the user selects a serial port.
---
--- Saves the name of the port to a variable and changes the label in the status bar to reflect the
--- change.
+-- Adds a Tuning submenu to the Settings menu. Tuning has the port's read buffer
+-- size, low latency and exclusive access, and three profiles that set all of them at once:
+-- - Default: as much read buffer as the receive memory limit allows, low latency off.
+-- - Interactive: a small read buffer and low latency, for typing and short commands.
+-- - Bulk: a large read buffer and low latency off, for long transfers at high bit rates.
+-- Like the other settings, tuning applies the next time the port is connected.
 --------------------------------------------------------------------------------------------------*/
-void dcTerm::selectPort()
+void dcTerm::initTuningMenu()
 {
-	mPortName = ((QAction*)QObject::sender())->text();
-	mPortLabel->setText(PORT_LABEL_TEXT.arg(mPortName));
+	ui.menuSettings->addSeparator();
+	QMenu* menuTuning = ui.menuSettings->addMenu(tr("Tuning"));
+
+	connect(menuTuning->addAction(tr("Default")), &QAction::triggered, this, &dcTerm::setTuningProfile);
+	connect(menuTuning->addAction(tr("Interactive")), &QAction::triggered, this, &dcTerm::setTuningProfile);
+	connect(menuTuning->addAction(tr("Bulk")), &QAction::triggered, this, &dcTerm::setTuningProfile);
+
+	menuTuning->addSeparator();
+	connect(menuTuning->addAction(tr("Read Buffer Size...")), &QAction::triggered, this,
+		&dcTerm::setReadBufferSize);
+
+	mLowLatencyAction = menuTuning->addAction(tr("Low Latency"));
+	mLowLatencyAction->setCheckable(true);
+	mLowLatencyAction->setChecked(mSession->settings().lowLatency);
+	connect(mLowLatencyAction, &QAction::toggled, this, &dcTerm::setLowLatency);
+
+	mExclusiveAction = menuTuning->addAction(tr("Exclusive Access"));
+	mExclusiveAction->setCheckable(true);
+	mExclusiveAction->setChecked(mSession->settings().exclusive);
+	connect(mExclusiveAction, &QAction::toggled, this, &dcTerm::setExclusiveAccess);
 }
 
 /*-------------------------------------------------------------------------------------------------
--- FUNCTION: writeToPort
+-- FUNCTION: initLinesMenu
 --
--- DATE: September 29, 2017
+-- DATE: October 18, 2026
 --
 -- REVISIONS: N/A
 --
@@ -590,26 +915,35 @@ void dcTerm::selectPort()
 --
 -- PROGRAMMER: Benny Wang
 --
--- INTERFACE: void writeToPort (QByteArray &data)
+-- INTERFACE: void initLinesMenu (void)
 --
 -- RETURNS: void.
 --
 -- NOTES:
--- This function is a Qt slot and is triggered when the console detects a keypress and wants to
--- send it through the serial port.
---
--- Writes the bits, data, to the serial port. The data is encoded in the machine's local 8 bit text
--- encoding.
+-- Adds the Lines menu, which drives the serial port's control lines while it is connected: DTR
+-- and RTS can be raised or dropped and a break of a chosen length sent, as bootloaders expect.
 --------------------------------------------------------------------------------------------------*/
-void dcTerm::writeToPort(QByteArray &data)
+void dcTerm::initLinesMenu()
 {
-	mPort->write(data);
+	mLinesMenu = ui.menuBar->addMenu(tr("Lines"));
+	mLinesMenu->setEnabled(false);
+
+	mDtrAction = mLinesMenu->addAction(tr("DTR"));
+	mDtrAction->setCheckable(true);
+	connect(mDtrAction, &QAction::toggled, this, &dcTerm::setDataTerminalReady);
+
+	mRtsAction = mLinesMenu->addAction(tr("RTS"));
+	mRtsAction->setCheckable(true);
+	connect(mRtsAction, &QAction::toggled, this, &dcTerm::setRequestToSend);
+
+	mLinesMenu->addSeparator();
+	connect(mLinesMenu->addAction(tr("Send Break...")), &QAction::triggered, this, &dcTerm::sendBreak);
 }
 
 /*-------------------------------------------------------------------------------------------------
--- FUNCTION: readFromPort
+-- FUNCTION: initBroadcastMenu
 --
--- DATE: September 29, 2017
+-- DATE: October 18, 2026
 --
 -- REVISIONS: N/A
 --
@@ -617,19 +951,2465 @@ void dcTerm::writeToPort(QByteArray &data)
 --
 -- PROGRAMMER: Benny Wang
 --
--- INTERFACE: void readFromPort (void)
+-- INTERFACE: void initBroadcastMenu (void)
 --
 -- RETURNS: void.
 --
 -- NOTES:
--- THis funciton is a Qt slot and is triggered when the serial port emit's the signal
--- QSerialPort::ReadReady which signals that there are data bits to be read from the incoming port.
+-- Creates the Broadcast menu, which builds the group of extra ports that receive the console's
+-- input and turns broadcasting on and off.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::initBroadcastMenu()
+{
+	QMenu* menuBroadcast = ui.menuBar->addMenu(tr("Broadcast"));
+
+	connect(menuBroadcast->addAction(tr("Add Port...")), &QAction::triggered, this, &dcTerm::addBroadcastPort);
+	connect(menuBroadcast->addAction(tr("Remove All Ports")), &QAction::triggered, mBroadcast,
+		&BroadcastGroup::clear);
+	menuBroadcast->addSeparator();
+
+	QAction* actionEnabled = menuBroadcast->addAction(tr("Broadcast Input"));
+	actionEnabled->setCheckable(true);
+	actionEnabled->setChecked(mBroadcast->isEnabled());
+	connect(actionEnabled, &QAction::toggled, this, &dcTerm::setBroadcastEnabled);
+
+	connect(menuBroadcast->addAction(tr("Status...")), &QAction::triggered, this, &dcTerm::showBroadcastStatus);
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: chooseExportFile
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool chooseExportFile (const QString &title, QString* path, ExportWriter::Format* format,
+--                                   int* linkType)
+--
+-- RETURNS: bool - false if the user cancelled.
+--
+-- NOTES:
+-- Asks for the file to export to. The format follows the file's extension and, for pcap, the user
+-- is also asked which of the user link types to give the file.
+--------------------------------------------------------------------------------------------------*/
+bool dcTerm::chooseExportFile(const QString &title, QString* path, ExportWriter::Format* format, int* linkType)
+{
+	*path = QFileDialog::getSaveFileName(this, title, QString(),
+		tr("Text (*.txt);;Hex Dump (*.hex);;CSV (*.csv);;pcap (*.pcap)"));
+	if (path->isEmpty())
+	{
+		return false;
+	}
+
+	*format = StreamExporter::formatForFile(*path);
+	*linkType = ExportWriter::LINKTYPE_USER0;
+	if (*format == ExportWriter::Pcap)
+	{
+		bool ok;
+		*linkType = QInputDialog::getInt(this, title, tr("Link type (147 to 162, DLT_USER0 to DLT_USER15):"),
+			ExportWriter::LINKTYPE_USER0, ExportWriter::LINKTYPE_USER0, ExportWriter::LINKTYPE_USER15, 1, &ok);
+		if (!ok)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: chooseIgnorePatterns
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: bool chooseIgnorePatterns (CaptureDiff* diff)
 --
--- Reads all the bits from the serial port and sends them to the console to be displayed.
+-- RETURNS: bool - false if the user cancelled.
+--
+-- NOTES:
+-- Asks for the regular expressions to ignore, one per line, starting from the last ones used, and
+-- gives them to diff. An invalid expression is reported and asked for again.
+--------------------------------------------------------------------------------------------------*/
+bool dcTerm::chooseIgnorePatterns(CaptureDiff* diff)
+{
+	for (;;)
+	{
+		bool ok;
+		QString patterns = QInputDialog::getMultiLineText(this, tr("Compare"),
+			tr("Ignore text matching these regular expressions, one per line:"), mIgnorePatterns, &ok);
+		if (!ok)
+		{
+			return false;
+		}
+
+		QString error;
+		if (diff->setIgnorePatterns(patterns.split('\n'), &error))
+		{
+			mIgnorePatterns = patterns;
+			return true;
+		}
+		QMessageBox::critical(this, tr("Error"), error);
+	}
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: showComparison
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void showComparison (CaptureDiff &diff, qint64 loaded)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Compares the loaded sides of diff, shows the report in the comparison window and the time taken
+-- in the status bar. loaded is the milliseconds already spent reading and hashing the sides.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::showComparison(CaptureDiff &diff, qint64 loaded)
+{
+	QElapsedTimer timer;
+	timer.start();
+	diff.compare();
+	qint64 compared = timer.elapsed();
+
+	if (!mDiffView)
+	{
+		mDiffView = new QPlainTextEdit(this);
+		mDiffView->setWindowFlags(Qt::Window);
+		mDiffView->setWindowTitle(tr("dcTerm - Compare"));
+		mDiffView->setReadOnly(true);
+		mDiffView->setLineWrapMode(QPlainTextEdit::NoWrap);
+		mDiffView->setFont(console->font());
+		mDiffView->resize(800, 600);
+	}
+	mDiffView->setPlainText(diff.report());
+	mDiffView->show();
+	mDiffView->raise();
+
+	ui.statusBar->showMessage(COMPARED_TEXT.arg(diff.lineCount(CaptureDiff::Old)).arg(diff.lineCount(CaptureDiff::New))
+		.arg(loaded).arg(compared));
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: populatePortMenu
+--
+-- DATE: September 29, 2017
+--
+-- REVISIONS:
+-- October 18, 2026 - Keeps the menu enabled when no ports are found and adds the simulated
+--     device.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void populatePortMenu (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Populates the port menu with the list of available communication ports on the computer,
+-- followed by the simulated device.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::populatePortMenu()
+{
+	QList<QSerialPortInfo> ports = QSerialPortInfo::availablePorts();
+	if (ports.size() == 0)
+	{
+		setWindowTitle(TITLE_UNDETECTABLE);
+	}
+
+	QAction* action;
+
+	for (int i = 0; i < ports.size(); i++)
+	{
+		action = new QAction(this);
+		action->setObjectName(ports[i].portName());
+		action->setText(ports[i].portName());
+
+		ui.menuPort->addAction(action);
+
+		connect(action, &QAction::triggered, this, &dcTerm::selectPort);
+	}
+
+	ui.menuPort->addSeparator();
+	connect(ui.menuPort->addAction(tr("Simulated Device...")), &QAction::triggered, this,
+		&dcTerm::selectSimulatedDevice);
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: createConsole
+--
+-- DATE: September 29, 2017
+--
+-- REVISIONS:
+-- October 18, 2026 - Puts the console in a splitter with the hex pane.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void createConsole (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Creates the console where incoming characters are displayed, and the hex pane beside it which
+-- starts hidden.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::createConsole()
+{
+	QSplitter* splitter = new QSplitter(Qt::Horizontal, this);
+	console = new Console(splitter);
+	mHexView = new HexView(&mSession->history(), splitter);
+	mHexView->hide();
+	splitter->addWidget(console);
+	splitter->addWidget(mHexView);
+	setCentralWidget(splitter);
+	console->setEnabled(false);
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: startConnection
+--
+-- DATE: September 29, 2017
+--
+-- REVISIONS:
+-- October 18, 2026 - Resets the trigger rules' match state.
+-- October 18, 2026 - Sets the character time used for timing estimates.
+-- October 18, 2026 - The session applies the settings and opens the port.
+-- October 18, 2026 - Shows the simulated device in the title.
+-- October 18, 2026 - Enables the lines menu for a serial port.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void startConnection (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Has the session apply the settings chosen by the users and start the serial port connection. If the port has openned, menu items are disabled/enabled accordingly and
+-- the window title is changed to show that the connection is openned.
+--
+-- QSerialPort is the Qt interface for interaction with a serial port on a computer.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::startConnection()
+{
+	setWindowTitle(TITLE_CONNECTING);
+	bool openned = mSession->open();
+	
+
+	if (openned)
+	{
+		ui.actionConnect->setEnabled(false);
+		ui.actionDisconnect->setEnabled(true);
+		console->setEnabled(true);
+		ui.menuSettings->setEnabled(false);
+		ui.menuPort->setEnabled(false);
+		mLinesMenu->setEnabled(mSession->hasControlLines());
+		if (mSession->hasControlLines())
+		{
+			updateLines(mSession->lines());
+		}
+
+		SimulatedSerialDevice* simulated = qobject_cast<SimulatedSerialDevice*>(mSession->device());
+		QString name = simulated ? simulated->description() : mSession->settings().portName;
+		setWindowTitle(TITLE_CONNECTED.arg(name));
+	}
+	else
+	{
+		QMessageBox::critical(this, tr("Error"), mSession->errorString());
+		ui.statusBar->showMessage(ERROR_CANNOT_OPEN);
+	}
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: stopConnection
+--
+-- DATE: September 29, 2017
+--
+-- REVISIONS:
+-- October 18, 2026 - The serial session closes the port.
+-- October 18, 2026 - Disables the lines menu.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void stopConnection (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Closes the serial port connection if it is open. If a port was closed, menu items are
+-- enabled/disabled accordingly and the window title is changed to show that the port has been
+-- disconnected.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::stopConnection()
+{
+	if (mSession->isOpen())
+	{
+		mSession->close();
+		ui.actionConnect->setEnabled(true);
+		ui.actionDisconnect->setEnabled(false);
+		console->setEnabled(false);
+		ui.menuSettings->setEnabled(true);
+		ui.menuPort->setEnabled(true);
+		mLinesMenu->setEnabled(false);
+		mLinesLabel->setText(LINES_LABEL_TEXT.arg("N/A"));
+		setWindowTitle(TITLE_DISCONNECTED);
+	}
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: setBitRate
+--
+-- DATE: September 29, 2017
+--
+-- REVISIONS:
+-- October 18, 2026 - Stores the setting in the serial session.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setBitRate (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when a menu item concerning baud rate is selected.
+--
+-- Saves the selected bit rate to a variable and changes the label in the status bar to reflect the
+-- change.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::setBitRate()
+{
+	QString bitRate(((QAction*)QObject::sender())->text());
+	mSession->settings().bitRate = bitRate.toInt();
+	mBitRateLabel->setText(BIT_RATE_LABEL_TEXT.arg(bitRate));
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: setDataBits
+--
+-- DATE: September 29, 2017
+--
+-- REVISIONS:
+-- October 18, 2026 - Stores the setting in the serial session.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setDataBits (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when a menu item concerning the number of data
+-- bits used is selected.
+--
+-- Saves the number of data bits to a variable and changes the label in the status bar to reflect
+-- the change.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::setDataBits()
+{
+	QString dataBits(((QAction*)QObject::sender())->text());
+	mSession->settings().dataBits = static_cast<QSerialPort::DataBits> (dataBits.toInt());
+	mDataBitsLabel->setText(DATA_BIT_LABEL_TEXT.arg(dataBits));
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: setParity
+--
+-- DATE: September 29, 2017
+--
+-- REVISIONS:
+-- October 18, 2026 - Stores the setting in the serial session.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setParity (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when a menu item concerning signal parity is
+-- selected.
+--
+-- Saves the number of parity bits to a variable and changes the label in the status bar to reflect
+-- the change.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::setParity()
+{
+	QString parity(((QAction*)QObject::sender())->text());
+	mParityLabel->setText(PARITY_LABEL_TEXT.arg(parity));
+	if (parity == QString("Even"))
+	{
+		mSession->settings().parity = QSerialPort::EvenParity;
+	}
+	if (parity == QString("Odd"))
+	{
+		mSession->settings().parity = QSerialPort::OddParity;
+	}
+	if (parity == QString("None"))
+	{
+		mSession->settings().parity = QSerialPort::NoParity;
+	}
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: setStopBits
+--
+-- DATE: September 29, 2017
+--
+-- REVISIONS:
+-- October 18, 2026 - Stores the setting in the serial session.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setStopBits (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when a menu item concerning the number of stop bits
+-- is selected.
+--
+-- Saves the number of stop bits to a variable and changes the label in the status bar to reflect
+-- the change.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::setStopBits()
+{
+	QString stopBits(((QAction*)QObject::sender())->text());
+	mSession->settings().stopBits = static_cast<QSerialPort::StopBits> (stopBits.toInt());
+	mStopBitsLabel->setText(STOP_BITS_LABEL_TEXT.arg(stopBits));
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: setFlowControl
+--
+-- DATE: September 29, 2017
+--
+-- REVISIONS:
+-- October 18, 2026 - Stores the setting in the serial session.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setFlowControl (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when a menu item concerning flow control is selected.
+--
+-- Saves the flow control setting to a variable and changes the label in the status bar to reflect
+-- the change.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::setFlowControl()
+{
+	QString flowControl(((QAction*)QObject::sender())->text());
+	mControlLabel->setText(FLOW_CONTROL_LABEL_TEXT.arg(flowControl));
+	if (flowControl == QString("No Flow Control"))
+	{
+		mSession->settings().flowControl = QSerialPort::NoFlowControl;
+	}
+	if (flowControl == QString("Hardware Control"))
+	{
+		mSession->settings().flowControl = QSerialPort::HardwareControl;
+	}
+	if (flowControl == QString("Software Control"))
+	{
+		mSession->settings().flowControl = QSerialPort::SoftwareControl;
+	}
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: setTuningProfile
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setTuningProfile (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when a profile in Settings > Tuning is selected.
+--
+-- Sets the read buffer size and low latency for the selected profile. Exclusive access is left as
+-- it is, since whether the port is shared has nothing to do with the kind of traffic.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::setTuningProfile()
+{
+	QString profile(((QAction*)QObject::sender())->text());
+	SerialSettings &settings = mSession->settings();
+	if (profile == tr("Default"))
+	{
+		settings.readBufferSize = 0;
+		mLowLatencyAction->setChecked(false);
+	}
+	if (profile == tr("Interactive"))
+	{
+		settings.readBufferSize = INTERACTIVE_READ_BUFFER;
+		mLowLatencyAction->setChecked(true);
+	}
+	if (profile == tr("Bulk"))
+	{
+		settings.readBufferSize = BULK_READ_BUFFER;
+		mLowLatencyAction->setChecked(false);
+	}
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: setReadBufferSize
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - 0 leaves the read buffer to the receive memory limit.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setReadBufferSize (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Settings > Tuning > Read
+-- Buffer Size.
+--
+-- Asks for the most kilobytes QSerialPort may hold before it stops reading the port and lets the
+-- device's flow control hold off the sender. 0 leaves it to the receive memory limit, which also
+-- caps any size given here.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::setReadBufferSize()
+{
+	bool ok;
+	int kilobytes = QInputDialog::getInt(this, tr("Read Buffer Size"),
+		tr("Read buffer size in KB, 0 for the receive memory limit:"),
+		static_cast<int>(mSession->settings().readBufferSize / 1024), 0, 1024 * 1024, 1, &ok);
+	if (ok)
+	{
+		mSession->settings().readBufferSize = static_cast<qint64>(kilobytes) * 1024;
+	}
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: setLowLatency
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setLowLatency (bool enabled)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user toggles Settings > Tuning > Low
+-- Latency.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::setLowLatency(bool enabled)
+{
+	mSession->settings().lowLatency = enabled;
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: setExclusiveAccess
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setExclusiveAccess (bool enabled)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user toggles Settings > Tuning > Exclusive
+-- Access.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::setExclusiveAccess(bool enabled)
+{
+	mSession->settings().exclusive = enabled;
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: detectSettings
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void detectSettings (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects File > Auto Detect.
+--
+-- Connects to the selected port and has the session try each bit rate in the Bit Rate menu, the
+-- most common first, with each framing. The device needs to be sending text while this runs.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::detectSettings()
+{
+	static const qint32 bitRates[] = { 115200, 9600, 57600, 38400, 19200, 4800, 2400, 1200 };
+
+	if (!mSession->isOpen())
+	{
+		startConnection();
+		if (!mSession->isOpen())
+		{
+			return;
+		}
+	}
+
+	QVector<qint32> candidates;
+	for (qint32 bitRate : bitRates)
+	{
+		candidates.append(bitRate);
+	}
+
+	if (mSession->startDetection(candidates))
+	{
+		ui.statusBar->showMessage(DETECTING_TEXT);
+	}
+	else
+	{
+		ui.statusBar->showMessage(DETECT_UNAVAILABLE_TEXT);
+	}
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: detectionFinished
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void detectionFinished (bool found)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the session has finished detecting.
+--
+-- Shows the settings found in the status bar labels, or that none were found. The port stays
+-- connected either way.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::detectionFinished(bool found)
+{
+	updateSettingsLabels();
+	if (!found)
+	{
+		ui.statusBar->showMessage(DETECT_FAILED_TEXT);
+		return;
+	}
+
+	const SerialSettings &settings = mSession->settings();
+	ui.statusBar->showMessage(DETECTED_TEXT.arg(settings.bitRate).arg(settings.dataBits)
+		.arg(parityName(settings.parity).toLower()));
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: setDataTerminalReady
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setDataTerminalReady (bool set)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user toggles Lines > DTR.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::setDataTerminalReady(bool set)
+{
+	if (!mSession->setDataTerminalReady(set))
+	{
+		updateLines(mSession->lines());
+	}
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: setRequestToSend
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setRequestToSend (bool set)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user toggles Lines > RTS. With hardware
+-- flow control the session refuses and says why.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::setRequestToSend(bool set)
+{
+	if (!mSession->setRequestToSend(set))
+	{
+		updateLines(mSession->lines());
+	}
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: sendBreak
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void sendBreak (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Lines > Send Break.
+--
+-- Asks how long to hold the break and has the session send it.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::sendBreak()
+{
+	bool ok;
+	int milliseconds = QInputDialog::getInt(this, tr("Send Break"), tr("Break length in milliseconds:"),
+		DEFAULT_BREAK_TIME, 1, 10000, 1, &ok);
+	if (!ok)
+	{
+		return;
+	}
+
+	if (mSession->sendBreak(milliseconds))
+	{
+		ui.statusBar->showMessage(BREAK_SENT_TEXT.arg(milliseconds));
+	}
+	else
+	{
+		ui.statusBar->showMessage(BREAK_FAILED_TEXT);
+	}
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: updateLines
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void updateLines (QSerialPort::PinoutSignals lines)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the session sees the control lines change.
+--
+-- Shows the lines in the status bar and keeps the DTR and RTS items in step with the port.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::updateLines(QSerialPort::PinoutSignals lines)
+{
+	mLinesLabel->setText(LINES_LABEL_TEXT.arg(SerialSession::lineText(lines)));
+
+	QSignalBlocker dtrBlocker(mDtrAction);
+	QSignalBlocker rtsBlocker(mRtsAction);
+	mDtrAction->setChecked(lines.testFlag(QSerialPort::DataTerminalReadySignal));
+	mRtsAction->setChecked(lines.testFlag(QSerialPort::RequestToSendSignal));
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: addBroadcastPort
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void addBroadcastPort (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Broadcast > Add Port.
+--
+-- Asks for one of the ports that is not already in use and opens it with the current settings,
+-- since the group is meant for identical devices.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::addBroadcastPort()
+{
+	QStringList used = mBroadcast->portNames();
+	if (mSession->isOpen())
+	{
+		used.append(mSession->settings().portName);
+	}
+
+	QStringList names;
+	for (const QSerialPortInfo &info : QSerialPortInfo::availablePorts())
+	{
+		if (!used.contains(info.portName()))
+		{
+			names.append(info.portName());
+		}
+	}
+
+	if (names.isEmpty())
+	{
+		ui.statusBar->showMessage(BROADCAST_NO_PORTS_TEXT);
+		return;
+	}
+
+	bool ok;
+	QString name = QInputDialog::getItem(this, tr("Add Port"), tr("Port to broadcast to:"), names, 0, false, &ok);
+	if (!ok)
+	{
+		return;
+	}
+
+	SerialSettings settings = mSession->settings();
+	settings.portName = name;
+	if (!mBroadcast->addPort(settings))
+	{
+		QMessageBox::critical(this, tr("Error"), mBroadcast->errorString());
+	}
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: setBroadcastEnabled
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setBroadcastEnabled (bool enabled)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user toggles Broadcast > Broadcast Input.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::setBroadcastEnabled(bool enabled)
+{
+	mBroadcast->setEnabled(enabled);
+	updateBroadcastLabel();
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: showBroadcastStatus
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void showBroadcastStatus (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Broadcast > Status.
+--
+-- Lists each port in the group with the bytes sent, still queued, dropped because the device fell
+-- too far behind, and received.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::showBroadcastStatus()
+{
+	QStringList lines;
+	for (int i = 0; i < mBroadcast->count(); i++)
+	{
+		BroadcastStatus status = mBroadcast->status(i);
+		lines.append(BROADCAST_STATUS_TEXT.arg(status.portName).arg(status.sent).arg(status.queued)
+			.arg(status.dropped).arg(status.received));
+	}
+
+	QMessageBox::information(this, tr("Broadcast"), lines.isEmpty() ? BROADCAST_EMPTY_TEXT : lines.join("\n"));
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: broadcastPortDropped
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void broadcastPortDropped (const QString &portName, const QString &message)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when a port in the group fails and is removed.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::broadcastPortDropped(const QString &portName, const QString &message)
+{
+	ui.statusBar->showMessage(BROADCAST_DROPPED_TEXT.arg(portName, message));
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: updateBroadcastLabel
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void updateBroadcastLabel (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when ports join or leave the group.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::updateBroadcastLabel()
+{
+	if (mBroadcast->count() == 0)
+	{
+		mBroadcastLabel->setText(BROADCAST_LABEL_TEXT.arg("Off"));
+		return;
+	}
+
+	QString ports = mBroadcast->portNames().join(", ");
+	mBroadcastLabel->setText(BROADCAST_LABEL_TEXT.arg(mBroadcast->isEnabled() ? ports : ports + " (paused)"));
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: updateSettingsLabels
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void updateSettingsLabels (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Sets the bit rate, data bits and parity labels from the session's settings, for when they were
+-- changed other than from the Settings menu.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::updateSettingsLabels()
+{
+	const SerialSettings &settings = mSession->settings();
+	mBitRateLabel->setText(BIT_RATE_LABEL_TEXT.arg(settings.bitRate));
+	mDataBitsLabel->setText(DATA_BIT_LABEL_TEXT.arg(settings.dataBits));
+	mParityLabel->setText(PARITY_LABEL_TEXT.arg(parityName(settings.parity)));
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: parityName
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: static QString parityName (QSerialPort::Parity parity)
+--
+-- RETURNS: QString - the name of parity as it appears in the Parity menu.
+--------------------------------------------------------------------------------------------------*/
+QString dcTerm::parityName(QSerialPort::Parity parity)
+{
+	if (parity == QSerialPort::EvenParity)
+	{
+		return QString("Even");
+	}
+	if (parity == QSerialPort::OddParity)
+	{
+		return QString("Odd");
+	}
+	return QString("None");
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: selectPort
+--
+-- DATE: September 29, 2017
+--
+-- REVISIONS:
+-- October 18, 2026 - Stores the setting in the serial session.
+-- October 18, 2026 - Switches back from a simulated device.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void selectPort (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects a serial port.
+--
+-- Saves the name of the port to a variable and changes the label in the status bar to reflect the
+-- change.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::selectPort()
+{
+	mSession->setDevice(nullptr);
+	mSession->settings().portName = ((QAction*)QObject::sender())->text();
+	mPortLabel->setText(PORT_LABEL_TEXT.arg(mSession->settings().portName));
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: selectSimulatedDevice
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void selectSimulatedDevice (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects the simulated device.
+--
+-- Asks for the simulator settings, in the form described in SimulatedSerialDevice.cpp, and uses
+-- the simulator in place of a serial port until a real port is selected again.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::selectSimulatedDevice()
+{
+	bool ok;
+	QString spec = QInputDialog::getText(this, tr("Simulated Device"),
+		tr("Settings (mode, rate, pattern, file, speed, parity, framing, reader, loopback):"),
+		QLineEdit::Normal, SIMULATED_DEVICE_DEFAULT, &ok);
+	if (!ok)
+	{
+		return;
+	}
+
+	SimulatedSerialDevice* device = new SimulatedSerialDevice();
+	QString error;
+	if (!device->configure(spec, &error))
+	{
+		delete device;
+		QMessageBox::critical(this, tr("Simulated Device"), error);
+		return;
+	}
+
+	mSession->setDevice(device);
+	mPortLabel->setText(PORT_LABEL_TEXT.arg(device->description()));
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: shareOverTcp
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void shareOverTcp (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Bridge > Share over TCP.
+--
+-- Asks for a local TCP port and starts the bridge's TCP server on the loopback interface.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::shareOverTcp()
+{
+	bool ok;
+	int port = QInputDialog::getInt(this, tr("Share over TCP"), tr("Local TCP port:"),
+		DEFAULT_BRIDGE_PORT, 1, 65535, 1, &ok);
+	if (!ok)
+	{
+		return;
+	}
+
+	if (!mBridge->startTcp(static_cast<quint16>(port)))
+	{
+		QMessageBox::critical(this, tr("Error"), mBridge->errorString());
+	}
+	updateBridgeLabel();
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: shareOverPty
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void shareOverPty (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects
+-- Bridge > Share over Pseudo-Terminal.
+--
+-- Creates a pseudo-terminal and shows the path other programs should open.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::shareOverPty()
+{
+	if (!mBridge->startPty())
+	{
+		QMessageBox::critical(this, tr("Error"), mBridge->errorString());
+	}
+	updateBridgeLabel();
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: stopSharing
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void stopSharing (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Bridge > Stop Sharing.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::stopSharing()
+{
+	mBridge->stop();
+	updateBridgeLabel();
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: updateBridgeLabel
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void updateBridgeLabel (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when bridge clients connect or disconnect.
+--
+-- Changes the label in the status bar to show the active bridge transports.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::updateBridgeLabel()
+{
+	mBridgeLabel->setText(BRIDGE_LABEL_TEXT.arg(mBridge->isActive() ? mBridge->description() : "Off"));
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: setFraming
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setFraming (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when a menu item concerning framing is selected.
+--
+-- Replaces the frame decoder with one for the selected framing, asking for the length header or
+-- delimiter where needed, and changes the label in the status bar to reflect the change. Choosing
+-- None removes the decoder so bytes are displayed as they arrive.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::setFraming()
+{
+	QString framing(((QAction*)QObject::sender())->text());
+	FrameDecoder* decoder = nullptr;
+
+	if (framing == QString("SLIP"))
+	{
+		decoder = new SlipDecoder();
+	}
+	if (framing == QString("COBS"))
+	{
+		decoder = new CobsDecoder();
+	}
+	if (framing == QString("Length-Prefixed..."))
+	{
+		QStringList headers;
+		headers << "1 byte" << "2 bytes, big endian" << "2 bytes, little endian"
+			<< "4 bytes, big endian" << "4 bytes, little endian";
+
+		bool ok;
+		QString header = QInputDialog::getItem(this, tr("Length-Prefixed"), tr("Length header:"),
+			headers, 1, false, &ok);
+		if (!ok)
+		{
+			return;
+		}
+		decoder = new LengthPrefixDecoder(header.left(1).toInt(), !header.endsWith("little endian"));
+	}
+	if (framing == QString("Delimiter..."))
+	{
+		bool ok;
+		QString delimiter = QInputDialog::getText(this, tr("Delimiter"),
+			tr("Frame delimiter (\\r, \\n, \\xNN escapes allowed):"), QLineEdit::Normal, "\\r\\n", &ok);
+		if (!ok || delimiter.isEmpty())
+		{
+			return;
+		}
+		decoder = new DelimiterDecoder(unescape(delimiter));
+	}
+
+	mSession->setDecoder(decoder);
+
+	if (decoder)
+	{
+		mFramingLabel->setText(FRAMING_LABEL_TEXT.arg(decoder->name()));
+	}
+	else
+	{
+		mFramingLabel->setText(FRAMING_LABEL_TEXT.arg("None"));
+	}
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: setCrcCheck
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setCrcCheck (bool enabled)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when Framing > Check CRC-16 is toggled.
+--
+-- The session keeps the setting so it also applies to decoders chosen later.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::setCrcCheck(bool enabled)
+{
+	mSession->setCrcCheck(enabled);
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: loadTriggers
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void loadTriggers (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Triggers > Load Rules.
+--
+-- Replaces the trigger rules with those in the chosen file. The format of the file is described
+-- in TriggerEngine.cpp.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::loadTriggers()
+{
+	QString path = QFileDialog::getOpenFileName(this, tr("Load Trigger Rules"), QString(),
+		tr("Trigger Rules (*.txt *.rules);;All Files (*)"));
+	if (path.isEmpty())
+	{
+		return;
+	}
+
+	QString error;
+	if (!mSession->triggers().loadRules(path, &error))
+	{
+		QMessageBox::critical(this, tr("Error"), error);
+		return;
+	}
+	mTriggersLabel->setText(TRIGGERS_LABEL_TEXT.arg(mSession->triggers().rules().size()));
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: clearTriggers
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void clearTriggers (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Triggers > Clear Rules.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::clearTriggers()
+{
+	mSession->triggers().setRules(QVector<TriggerRule>());
+	mTriggersLabel->setText(TRIGGERS_LABEL_TEXT.arg(0));
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: loadHighlights
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void loadHighlights (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Highlight > Load Rules.
+--
+-- Replaces the highlight rules with those in the chosen file. The format of the file is described
+-- in HighlightRules.cpp.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::loadHighlights()
+{
+	QString path = QFileDialog::getOpenFileName(this, tr("Load Highlight Rules"), QString(),
+		tr("Highlight Rules (*.txt *.rules);;All Files (*)"));
+	if (path.isEmpty())
+	{
+		return;
+	}
+
+	HighlightRules rules;
+	QString error;
+	if (!rules.loadRules(path, &error))
+	{
+		QMessageBox::critical(this, tr("Error"), error);
+		return;
+	}
+	console->SetHighlightRules(rules);
+	ui.statusBar->showMessage(HIGHLIGHT_LOADED_TEXT.arg(rules.rules().size()));
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: clearHighlights
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void clearHighlights (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Highlight > Clear Rules.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::clearHighlights()
+{
+	console->SetHighlightRules(HighlightRules());
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: startCapture
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void startCapture (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Capture > Start Capture.
+--
+-- Asks where to save the capture and starts recording everything sent and received.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::startCapture()
+{
+	QString path = QFileDialog::getSaveFileName(this, tr("Start Capture"), mSession->defaultCaptureName(),
+		tr("dcTerm Captures (*.dcap)"));
+	if (!path.isEmpty())
+	{
+		mSession->startCapture(path);
+	}
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: stopCapture
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void stopCapture (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Capture > Stop Capture.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::stopCapture()
+{
+	mSession->stopCapture();
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: updateCaptureLabel
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void updateCaptureLabel (const QString &fileName)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the session starts or stops a capture, either
+-- from the Capture menu or from a trigger rule.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::updateCaptureLabel(const QString &fileName)
+{
+	mCaptureLabel->setText(CAPTURE_LABEL_TEXT.arg(fileName.isEmpty() ? QString("Off") : QFileInfo(fileName).fileName()));
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: compareWithHistory
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Opens the hex pane when the first difference is older than the console's
+--     scrollback.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void compareWithHistory (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Capture > Compare with
+-- Known-Good.
+--
+-- Compares a known-good capture with what has been received in this session and scrolls the
+-- console and hex pane to the first line that differs. The console keeps only its last MAX_LINES
+-- lines, fewer if its memory budget trims it, while the history behind the hex pane goes back
+-- much further. When the line is no longer in the console, the hex pane is opened at it and the
+-- status bar says so, instead of leaving the console at its top line as if that were the
+-- difference.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::compareWithHistory()
+{
+	QString path = QFileDialog::getOpenFileName(this, tr("Known-Good Capture"), QString(),
+		tr("dcTerm Captures (*.dcap)"));
+	CaptureDiff diff;
+	if (path.isEmpty() || !chooseIgnorePatterns(&diff))
+	{
+		return;
+	}
+
+	QElapsedTimer timer;
+	timer.start();
+
+	QString error;
+	if (!diff.loadCapture(CaptureDiff::Old, path, &error))
+	{
+		QMessageBox::critical(this, tr("Error"), error);
+		return;
+	}
+	diff.loadHistory(CaptureDiff::New, mSession->history());
+	showComparison(diff, timer.elapsed());
+
+	if (diff.firstDifference() >= 0)
+	{
+		qint64 offset = diff.lineOffset(CaptureDiff::New, diff.firstDifference());
+		int lines = mSession->history().lineFromEnd(offset);
+		if (lines >= console->document()->blockCount())
+		{
+			mHexPaneAction->setChecked(true);
+			ui.statusBar->showMessage(ui.statusBar->currentMessage() + " "
+				+ DIFFERENCE_IN_HEX_TEXT.arg(diff.firstDifference() + 1));
+		}
+		mSyncing = true;
+		console->ScrollToLineFromEnd(lines);
+		mHexView->scrollToOffset(offset);
+		mSyncing = false;
+	}
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: compareCaptures
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void compareCaptures (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Capture > Compare Two
+-- Captures.
+--
+-- Compares a known-good capture with a new one without touching the session.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::compareCaptures()
+{
+	QString oldPath = QFileDialog::getOpenFileName(this, tr("Known-Good Capture"), QString(),
+		tr("dcTerm Captures (*.dcap)"));
+	if (oldPath.isEmpty())
+	{
+		return;
+	}
+	QString newPath = QFileDialog::getOpenFileName(this, tr("New Capture"), QString(),
+		tr("dcTerm Captures (*.dcap)"));
+	CaptureDiff diff;
+	if (newPath.isEmpty() || !chooseIgnorePatterns(&diff))
+	{
+		return;
+	}
+
+	QElapsedTimer timer;
+	timer.start();
+
+	QString error;
+	if (!diff.loadCapture(CaptureDiff::Old, oldPath, &error) || !diff.loadCapture(CaptureDiff::New, newPath, &error))
+	{
+		QMessageBox::critical(this, tr("Error"), error);
+		return;
+	}
+	showComparison(diff, timer.elapsed());
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: runScript
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void runScript (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Script > Run Script.
+--
+-- Asks for a script file and starts it. The script API is described in ScriptRunner.cpp.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::runScript()
+{
+	QString path = QFileDialog::getOpenFileName(this, tr("Run Script"), QString(),
+		tr("Scripts (*.js);;All Files (*)"));
+	if (path.isEmpty())
+	{
+		return;
+	}
+
+	QString error;
+	if (!mScript->start(path, &error))
+	{
+		QMessageBox::critical(this, tr("Error"), error);
+		return;
+	}
+	mScriptLabel->setText(SCRIPT_LABEL_TEXT.arg(mScript->scriptName()));
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: stopScript
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void stopScript (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Script > Stop Script.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::stopScript()
+{
+	mScript->stop();
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: scriptFinished
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void scriptFinished (bool ok, const QString &message)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when a script ends, whether it finished, failed or
+-- was stopped. Shows the outcome in the status bar.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::scriptFinished(bool ok, const QString &message)
+{
+	Q_UNUSED(ok);
+	mScriptLabel->setText(SCRIPT_LABEL_TEXT.arg("None"));
+	ui.statusBar->showMessage(QString("%1: %2").arg(mScript->scriptName()).arg(message));
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: exportHistory
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Streams the history to the exporter instead of copying it whole.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void exportHistory (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Export > Export History.
+--
+-- Exports the received history, which holds far more than the console shows. The exporter reads
+-- it a chunk at a time as the export thread asks for more, so the history is never copied whole.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::exportHistory()
+{
+	QString path;
+	ExportWriter::Format format;
+	int linkType;
+	if (!chooseExportFile(tr("Export History"), &path, &format, &linkType))
+	{
+		return;
+	}
+
+	QString error;
+	if (!mExporter->exportHistory(mSession->history(), CaptureFile::now(), path, format, linkType, &error))
+	{
+		QMessageBox::critical(this, tr("Error"), error);
+		return;
+	}
+	updateExportLabel(0);
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: exportCapture
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void exportCapture (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Export > Export Capture.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::exportCapture()
+{
+	QString capture = QFileDialog::getOpenFileName(this, tr("Export Capture"), QString(),
+		tr("dcTerm Captures (*.dcap)"));
+	if (capture.isEmpty())
+	{
+		return;
+	}
+
+	QString path;
+	ExportWriter::Format format;
+	int linkType;
+	if (!chooseExportFile(tr("Export Capture"), &path, &format, &linkType))
+	{
+		return;
+	}
+
+	QString error;
+	if (!mExporter->exportCapture(capture, path, format, linkType, &error))
+	{
+		QMessageBox::critical(this, tr("Error"), error);
+		return;
+	}
+	updateExportLabel(0);
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: stopExport
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void stopExport (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Export > Stop Export.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::stopExport()
+{
+	mExporter->stop();
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: updateExportLabel
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void updateExportLabel (int percent)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is called as the running export makes progress.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::updateExportLabel(int percent)
+{
+	mExportLabel->setText(EXPORT_LABEL_TEXT.arg(QString("%1%").arg(percent)));
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: exportFinished
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void exportFinished (bool ok, const QString &message)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is called when an export is done, has failed or was stopped.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::exportFinished(bool ok, const QString &message)
+{
+	Q_UNUSED(ok);
+	mExportLabel->setText(EXPORT_LABEL_TEXT.arg("None"));
+	ui.statusBar->showMessage(message);
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: setTimingEnabled
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setTimingEnabled (bool enabled)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user toggles Timing > Record Timing.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::setTimingEnabled(bool enabled)
+{
+	mSession->setTimingEnabled(enabled);
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: showTiming
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void showTiming (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Timing > Show Timing.
+--
+-- Opens the timing view, creating it the first time.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::showTiming()
+{
+	if (!mTimingView)
+	{
+		mTimingView = new TimingView(&mSession->timing(), this);
+	}
+	mTimingView->show();
+	mTimingView->raise();
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: clearTiming
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void clearTiming (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Timing > Clear Timing.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::clearTiming()
+{
+	mSession->clearTiming();
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: setLatencyEnabled
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setLatencyEnabled (bool enabled)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Timing > Measure Latency.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::setLatencyEnabled(bool enabled)
+{
+	mSession->setLatencyEnabled(enabled);
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: setLatencyTerminator
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setLatencyTerminator (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Timing > Answer Terminator.
+--
+-- Asks for the bytes that end the device's answer, e.g. OK\r\n. Left empty, an answer is timed
+-- at its first byte. The measurements so far are reset, as they were timed to a different point.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::setLatencyTerminator()
+{
+	bool ok;
+	QString terminator = QInputDialog::getText(this, tr("Answer Terminator"),
+		tr("End of answer, empty for its first byte (\\r, \\n, \\xNN escapes allowed):"),
+		QLineEdit::Normal, mLatencyTerminator, &ok);
+	if (!ok)
+	{
+		return;
+	}
+
+	mLatencyTerminator = terminator;
+	mSession->latency().setTerminator(unescape(terminator));
+	mSession->latency().clear();
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: exportLatency
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void exportLatency (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Timing > Export Latency.
+--
+-- Writes the latency distribution measured so far to a CSV file.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::exportLatency()
+{
+	QString path = QFileDialog::getSaveFileName(this, tr("Export Latency"), "latency.csv",
+		tr("CSV Files (*.csv)"));
+	if (path.isEmpty())
+	{
+		return;
+	}
+
+	QFile file(path);
+	if (!file.open(QIODevice::WriteOnly) || !mSession->latency().writeCsv(&file))
+	{
+		QMessageBox::critical(this, tr("Error"), file.errorString());
+		return;
+	}
+	ui.statusBar->showMessage(LATENCY_EXPORTED_TEXT.arg(mSession->latency().count()).arg(path));
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: resetLatency
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void resetLatency (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Timing > Reset Latency.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::resetLatency()
+{
+	mSession->latency().clear();
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: showStatistics
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void showStatistics (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Statistics > Show Statistics.
+--
+-- Opens the statistics window, creating it the first time.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::showStatistics()
+{
+	if (!mStatisticsView)
+	{
+		mStatisticsView = new StatisticsView(mSession, this);
+	}
+	mStatisticsView->show();
+	mStatisticsView->raise();
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: resetStatistics
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void resetStatistics (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Statistics > Reset Statistics.
+--
+-- Zeroes the traffic counts and starts the memory peaks over from the current use.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::resetStatistics()
+{
+	mSession->resetStatistics();
+	mSession->budget().resetPeaks();
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: setMemoryLimit
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void setMemoryLimit (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is triggered when the user selects Statistics > Memory Limits.
+--
+-- Asks which limit to change, then for the new limit in megabytes. The total limit may be 0 for
+-- none. The scrollback, capture, timing and highlight limits apply at once. The receive buffers
+-- and history are sized when the port is opened, so their limits apply the next time it is
+-- connected.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::setMemoryLimit()
+{
+	MemoryBudget &budget = mSession->budget();
+	QStringList names;
+	for (int i = 0; i < MemoryBudget::SUBSYSTEM_COUNT; i++)
+	{
+		names << MemoryBudget::name(static_cast<MemoryBudget::Subsystem>(i));
+	}
+	names << tr("Total");
+
+	bool ok;
+	QString name = QInputDialog::getItem(this, tr("Memory Limits"), tr("Limit to change:"), names, 0,
+		false, &ok);
+	if (!ok)
+	{
+		return;
+	}
+
+	const qint64 megabyte = 1024 * 1024;
+	int index = names.indexOf(name);
+	if (index == MemoryBudget::SUBSYSTEM_COUNT)
+	{
+		int megabytes = QInputDialog::getInt(this, tr("Memory Limits"),
+			tr("Total limit in MB, 0 for none:"), static_cast<int>(budget.totalLimit() / megabyte), 0,
+			MAX_MEMORY_LIMIT, 1, &ok);
+		if (ok)
+		{
+			budget.setTotalLimit(megabytes * megabyte);
+		}
+		return;
+	}
+
+	MemoryBudget::Subsystem subsystem = static_cast<MemoryBudget::Subsystem>(index);
+	QString label = tr("%1 limit in MB:").arg(name);
+	if (subsystem == MemoryBudget::Receive || subsystem == MemoryBudget::History)
+	{
+		label = tr("%1 limit in MB, from the next connection:").arg(name);
+	}
+	int current = static_cast<int>(qMax<qint64>(1, budget.limit(subsystem) / megabyte));
+	int megabytes = QInputDialog::getInt(this, tr("Memory Limits"), label, current, 1, MAX_MEMORY_LIMIT, 1,
+		&ok);
+	if (ok)
+	{
+		budget.setLimit(subsystem, megabytes * megabyte);
+	}
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: syncHexToConsole
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void syncHexToConsole (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is called when the console scrolls.
+--
+-- Scrolls the hex pane to the start of the console's top line. The two panes do not share
+-- positions, the console counts lines of text and the hex pane counts bytes, so lines are counted
+-- back from the newest byte, which both end on. mSyncing stops the scroll this causes in the hex
+-- pane from scrolling the console back.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::syncHexToConsole()
+{
+	if (mSyncing || !mHexView->isVisible())
+	{
+		return;
+	}
+
+	mSyncing = true;
+	QScrollBar* bar = console->verticalScrollBar();
+	if (bar->value() == bar->maximum())
+	{
+		mHexView->scrollToEnd();
+	}
+	else
+	{
+		mHexView->scrollToOffset(mSession->history().lineStart(console->TopLineFromEnd()));
+	}
+	mSyncing = false;
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: syncConsoleToHex
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void syncConsoleToHex (qint64 offset)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- This function is a Qt slot and is called when the hex pane scrolls to offset.
+--
+-- Scrolls the console to the line holding offset, the reverse of syncHexToConsole.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::syncConsoleToHex(qint64 offset)
+{
+	if (mSyncing)
+	{
+		return;
+	}
+
+	mSyncing = true;
+	if (mHexView->isAtEnd())
+	{
+		console->verticalScrollBar()->setValue(console->verticalScrollBar()->maximum());
+	}
+	else
+	{
+		console->ScrollToLineFromEnd(mSession->history().lineFromEnd(offset));
+	}
+	mSyncing = false;
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: displayData
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void displayData (const char* data, int size)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Called by the session with received bytes when no framing is selected. Shows them in the
+-- console.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::displayData(const char* data, int size)
+{
+	console->DisplayData(QByteArray::fromRawData(data, size));
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: displayFrame
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void displayFrame (const char* data, int length, FrameDecoder::FrameStatus status,
+--                               const QTime &time)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Called by the session with each decoded frame. Shows it as one row in the console.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::displayFrame(const char* data, int length, FrameDecoder::FrameStatus status, const QTime &time)
+{
+	console->DisplayFrame(data, length, status, time);
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: displayTransmitted
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void displayTransmitted (const char* data, int size, const QTime &time)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Called by the session with sent bytes when local echo is on. Shows them in the console inline
+-- with the received text, or as a row of their own when received data is shown as frames.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::displayTransmitted(const char* data, int size, const QTime &time)
+{
+	if (mSession->decoder())
+	{
+		console->DisplayTransmittedFrame(data, size, time);
+	}
+	else
+	{
+		console->DisplayTransmitted(QByteArray::fromRawData(data, size));
+	}
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: highlightLine
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void highlightLine (const QString &color)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Called by the session for a highlight trigger rule. color is any name QColor understands.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::highlightLine(const QString &color)
+{
+	console->HighlightLastLine(QColor(color));
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: beep
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void beep (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Called by the session for a beep trigger rule.
+--------------------------------------------------------------------------------------------------*/
+void dcTerm::beep()
+{
+	QApplication::beep();
+}
+
+/*-------------------------------------------------------------------------------------------------
+-- FUNCTION: showMessage
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void showMessage (const QString &message)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Called by the session to report a problem nobody asked about, such as a capture started by a
+-- trigger rule failing to open. Shows it in the status bar.
 --------------------------------------------------------------------------------------------------*/
-void dcTerm::readFromPort()
+void dcTerm::showMessage(const QString &message)
 {
-	QByteArray data = mPort->readAll();
-	console->DisplayData(data);
-	mPort->clear(QSerialPort::Input);
+	ui.statusBar->showMessage(message);
 }
@@ -1,14 +1,23 @@
 #pragma once
 
 #include <QLabel>
-#include <QSerialPort>
+#include <QPlainTextEdit>
 #include <QSerialPortInfo>
 #include <QtWidgets/QMainWindow>
 
+#include "BroadcastGroup.h"
+#include "CaptureDiff.h"
 #include "Console.h"
+#include "HexView.h"
+#include "ScriptRunner.h"
+#include "SerialBridge.h"
+#include "SerialSession.h"
+#include "StatisticsView.h"
+#include "StreamExporter.h"
+#include "TimingView.h"
 #include "ui_dcTerm.h"
 
-class dcTerm : public QMainWindow
+class dcTerm : public QMainWindow, public SessionView
 {
 	Q_OBJECT
 
@@ -30,9 +39,42 @@ private:
 	const QString PARITY_LABEL_TEXT = " Parity: %1 ";
 	const QString STOP_BITS_LABEL_TEXT = " Stop Bits: %1 ";
 	const QString FLOW_CONTROL_LABEL_TEXT = " Flow Control: %1 ";
+	const QString BRIDGE_LABEL_TEXT = " Bridge: %1 ";
+	const QString FRAMING_LABEL_TEXT = " Framing: %1 ";
+	const QString TRIGGERS_LABEL_TEXT = " Triggers: %1 ";
+	const QString CAPTURE_LABEL_TEXT = " Capture: %1 ";
+	const QString SCRIPT_LABEL_TEXT = " Script: %1 ";
+	const QString EXPORT_LABEL_TEXT = " Export: %1 ";
+	const QString LINES_LABEL_TEXT = " Lines: %1 ";
+	const QString BROADCAST_LABEL_TEXT = " Broadcast: %1 ";
+
+	const QString HIGHLIGHT_LOADED_TEXT = "Loaded %1 highlight rules.";
+	const QString LATENCY_EXPORTED_TEXT = "Exported %1 latencies to %2.";
+	const QString DETECTING_TEXT = "Detecting bit rate and framing...";
+	const QString DETECTED_TEXT = "Detected %1 baud, %2 data bits, %3 parity.";
+	const QString DETECT_FAILED_TEXT = "Could not detect the settings: not enough text was received.";
+	const QString DETECT_UNAVAILABLE_TEXT = "Detection needs a serial port.";
+	const QString BREAK_SENT_TEXT = "Sending a %1 ms break.";
+	const QString BREAK_FAILED_TEXT = "A break could not be sent on this port.";
+	const QString BROADCAST_NO_PORTS_TEXT = "There are no other ports to broadcast to.";
+	const QString BROADCAST_EMPTY_TEXT = "No ports have been added to the broadcast group.";
+	const QString BROADCAST_STATUS_TEXT = "%1: %2 sent, %3 queued, %4 dropped, %5 received";
+	const QString BROADCAST_DROPPED_TEXT = "%1 was removed from the broadcast group: %2";
+	const QString COMPARED_TEXT = "Compared %1 lines with %2 lines: %3 ms to load, %4 ms to compare.";
+	const QString DIFFERENCE_IN_HEX_TEXT = "Line %1 is past the console's scrollback, see the hex pane.";
+
+	const QString SIMULATED_DEVICE_DEFAULT = "mode=random,rate=11520";
+
+	const quint16 DEFAULT_BRIDGE_PORT = 7000;
+	const qint64 INTERACTIVE_READ_BUFFER = 64 * 1024;
+	const qint64 BULK_READ_BUFFER = 1024 * 1024;
+	const int MAX_MEMORY_LIMIT = 1024;
+	const int DEFAULT_BREAK_TIME = 250;
 
 	Ui::dcTermClass ui;
 	Console* console;
+	HexView* mHexView;
+	bool mSyncing;
 
 	QLabel* mPortLabel;
 	QLabel* mBitRateLabel;
@@ -40,20 +82,62 @@ private:
 	QLabel* mParityLabel;
 	QLabel* mStopBitsLabel;
 	QLabel* mControlLabel;
-
-	QSerialPort* mPort;
-
-	QString mPortName;
-	qint32 mBitRate;
-	QSerialPort::DataBits mDataBits;
-	QSerialPort::Parity mParity;
-	QSerialPort::StopBits mStopBits;
-	QSerialPort::FlowControl mControl;
+	QLabel* mBridgeLabel;
+	QLabel* mFramingLabel;
+	QLabel* mTriggersLabel;
+	QLabel* mCaptureLabel;
+	QLabel* mScriptLabel;
+	QLabel* mExportLabel;
+	QLabel* mLinesLabel;
+	QLabel* mBroadcastLabel;
+
+	SerialSession* mSession;
+	SerialBridge* mBridge;
+	BroadcastGroup* mBroadcast;
+	ScriptRunner* mScript;
+	StreamExporter* mExporter;
+	TimingView* mTimingView;
+	StatisticsView* mStatisticsView;
+	QPlainTextEdit* mDiffView;
+	QString mIgnorePatterns;
+	QString mLatencyTerminator;
+	QAction* mLowLatencyAction;
+	QAction* mExclusiveAction;
+	QMenu* mLinesMenu;
+	QAction* mDtrAction;
+	QAction* mRtsAction;
+	QAction* mHexPaneAction;
 
 	void initMenuConnections();
 	void populatePortMenu();
 	void createConsole();
 	void initStatusBarLabels();
+	void initBridgeMenu();
+	void initFramingMenu();
+	void initTriggerMenu();
+	void initHighlightMenu();
+	void initCaptureMenu();
+	void initScriptMenu();
+	void initExportMenu();
+	void initTimingMenu();
+	void initStatisticsMenu();
+	void initViewMenu();
+	void initTuningMenu();
+	void initLinesMenu();
+	void initBroadcastMenu();
+	void updateSettingsLabels();
+	static QString parityName(QSerialPort::Parity parity);
+
+	bool chooseExportFile(const QString &title, QString* path, ExportWriter::Format* format, int* linkType);
+	bool chooseIgnorePatterns(CaptureDiff* diff);
+	void showComparison(CaptureDiff &diff, qint64 loaded);
+
+	void displayData(const char* data, int size) Q_DECL_OVERRIDE;
+	void displayFrame(const char* data, int length, FrameDecoder::FrameStatus status, const QTime &time) Q_DECL_OVERRIDE;
+	void displayTransmitted(const char* data, int size, const QTime &time) Q_DECL_OVERRIDE;
+	void highlightLine(const QString &color) Q_DECL_OVERRIDE;
+	void beep() Q_DECL_OVERRIDE;
+	void showMessage(const QString &message) Q_DECL_OVERRIDE;
 
 private slots:
 	void startConnection();
@@ -64,9 +148,70 @@ private slots:
 	void setParity();
 	void setStopBits();
 	void setFlowControl();
+	void setTuningProfile();
+	void setReadBufferSize();
+	void setLowLatency(bool enabled);
+	void setExclusiveAccess(bool enabled);
+	void detectSettings();
+	void detectionFinished(bool found);
+
+	void setDataTerminalReady(bool set);
+	void setRequestToSend(bool set);
+	void sendBreak();
+	void updateLines(QSerialPort::PinoutSignals lines);
+
+	void addBroadcastPort();
+	void setBroadcastEnabled(bool enabled);
+	void showBroadcastStatus();
+	void broadcastPortDropped(const QString &portName, const QString &message);
+	void updateBroadcastLabel();
 
 	void selectPort();
+	void selectSimulatedDevice();
+
+	void shareOverTcp();
+	void shareOverPty();
+	void stopSharing();
+	void updateBridgeLabel();
+
+	void setFraming();
+	void setCrcCheck(bool enabled);
+
+	void loadTriggers();
+	void clearTriggers();
+
+	void loadHighlights();
+	void clearHighlights();
+
+	void startCapture();
+	void stopCapture();
+	void updateCaptureLabel(const QString &fileName);
+	void compareWithHistory();
+	void compareCaptures();
+
+	void runScript();
+	void stopScript();
+	void scriptFinished(bool ok, const QString &message);
+
+	void exportHistory();
+	void exportCapture();
+	void stopExport();
+	void updateExportLabel(int percent);
+	void exportFinished(bool ok, const QString &message);
+
+	void setTimingEnabled(bool enabled);
+	void showTiming();
+	void clearTiming();
+
+	void setLatencyEnabled(bool enabled);
+	void setLatencyTerminator();
+	void exportLatency();
+	void resetLatency();
+
+	void showStatistics();
+	void resetStatistics();
+	void setMemoryLimit();
 
-	void writeToPort(QByteArray &data);
-	void readFromPort();
+	void syncHexToConsole();
+	void syncConsoleToHex(qint64 offset);
 };
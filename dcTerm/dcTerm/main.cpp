@@ -5,10 +5,13 @@
 --
 -- FUNCTIONS:
 -- void main(int argc, char* argv[]);
+-- int runHeadless(int argc, char* argv[]);
 --
 -- DATE: September 29, 2017
 --
--- REVISIONS: N/A
+-- REVISIONS:
+-- October 18, 2026 - Added headless script runs.
+-- October 18, 2026 - Headless scripts can run against a simulated device.
 --
 -- DESIGNER: The Qt Company 
 --
@@ -17,16 +20,147 @@
 -- NOTES:
 -- The main entry point of the application. This file is automatically generated when starting a
 -- Qt GUI application.
+--
+-- When started with --script the window is not created. Instead the script is run against the
+-- port given with --port and the program exits with the script's result, which allows scripts to
+-- be run from a build or test server:
+--
+--     dcTerm --script test.js --port COM3 [--baud 115200]
+--
+-- With --simulate in place of --port the script runs against a SimulatedSerialDevice, which makes
+-- load tests repeatable without hardware:
+--
+--     dcTerm --script soak.js --simulate mode=random,rate=10000000,parity=0.00001
 --------------------------------------------------------------------------------------------------*/
 #include "dcTerm.h"
+#include "ScriptRunner.h"
+#include "SerialSession.h"
+#include "SimulatedSerialDevice.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QTextStream>
 #include <QtWidgets/QApplication>
 
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: runHeadless
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Runs the script against a SerialSession instead of a bare QSerialPort.
+-- October 18, 2026 - Added --simulate and the simulator's counts.
+-- October 18, 2026 - End lines with '\n' and flush explicitly, since endl is deprecated from
+--     Qt 5.15 and Qt::endl does not exist in 5.9.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int runHeadless (int argc, char* argv[])
+--
+-- RETURNS: int - 0 if the script finished without error, 1 otherwise.
+--
+-- NOTES:
+-- Opens a serial session 8N1 without flow control and runs the script against it without a
+-- window, or against a simulated device configured by --simulate. Script log messages, the result
+-- and the session's traffic counts are written to standard output. Script messages are flushed
+-- as they are logged; on the early error returns the stream's destructor flushes the message.
+--------------------------------------------------------------------------------------------------*/
+int runHeadless(int argc, char* argv[])
+{
+	QCoreApplication app(argc, argv);
+	QTextStream out(stdout);
+
+	QCommandLineParser parser;
+	QCommandLineOption scriptOption("script", "Run the script file without a window.", "file");
+	QCommandLineOption portOption("port", "The serial port to run the script against.", "name");
+	QCommandLineOption baudOption("baud", "The baud rate of the port.", "rate", "9600");
+	QCommandLineOption simulateOption("simulate", "Run the script against a simulated device.", "settings");
+	parser.addHelpOption();
+	parser.addOption(scriptOption);
+	parser.addOption(portOption);
+	parser.addOption(baudOption);
+	parser.addOption(simulateOption);
+	parser.process(app);
+
+	if (!parser.isSet(portOption) && !parser.isSet(simulateOption))
+	{
+		out << "--port or --simulate is required with --script" << '\n';
+		return 1;
+	}
+
+	SerialSession session;
+	session.settings().portName = parser.value(portOption);
+	session.settings().bitRate = parser.value(baudOption).toInt();
+	session.settings().flowControl = QSerialPort::NoFlowControl;
+
+	SimulatedSerialDevice* simulated = nullptr;
+	if (parser.isSet(simulateOption))
+	{
+		simulated = new SimulatedSerialDevice();
+		QString error;
+		if (!simulated->configure(parser.value(simulateOption), &error))
+		{
+			out << "--simulate: " << error << '\n';
+			delete simulated;
+			return 1;
+		}
+		session.settings().portName = simulated->description();
+		session.setDevice(simulated);
+	}
+
+	if (!session.open())
+	{
+		out << session.settings().portName << ": " << session.errorString() << '\n';
+		return 1;
+	}
+
+	ScriptRunner runner;
+	int result = 1;
+
+	QObject::connect(&session, &SerialSession::received, &runner, &ScriptRunner::feed);
+	QObject::connect(&runner, &ScriptRunner::sendRequested, &session, &SerialSession::write);
+	QObject::connect(&runner, &ScriptRunner::logMessage, [&out](const QString &message)
+	{
+		out << message << '\n';
+		out.flush();
+	});
+	QObject::connect(&runner, &ScriptRunner::finished, [&out, &result](bool ok, const QString &message)
+	{
+		out << message << '\n';
+		out.flush();
+		result = ok ? 0 : 1;
+		QCoreApplication::quit();
+	});
+
+	QString error;
+	if (!runner.start(parser.value(scriptOption), &error))
+	{
+		out << parser.value(scriptOption) << ": " << error << '\n';
+		return 1;
+	}
+
+	app.exec();
+
+	const SessionStatistics &stats = session.statistics();
+	out << "received " << stats.bytesReceived << " bytes in " << stats.reads << " reads, sent "
+		<< stats.bytesSent << " bytes in " << stats.writes << " writes" << '\n';
+	if (simulated)
+	{
+		out << "simulated " << simulated->bytesGenerated() << " bytes with " << simulated->errorsInjected()
+			<< " errors and " << simulated->overruns() << " overrun bytes" << '\n';
+	}
+	out.flush();
+	return result;
+}
+
 /*--------------------------------------------------------------------------------------------------
 -- FUNCTION: main
 --
 -- DATE: September 29, 2017
 --
--- REVISIONS: N/A
+-- REVISIONS:
+-- October 18, 2026 - Runs scripts headless when started with --script.
 --
 -- DESIGNER: The Qt Company 
 --
@@ -37,9 +171,18 @@
 -- NOTES:
 -- The entry point of the program.
 -- Creates a QApplication that is untouched by the developer and a developer defined dcTerm object.
+-- If --script is given the script is run headless instead.
 --------------------------------------------------------------------------------------------------*/
 int main(int argc, char* argv[])
 {
+	for (int i = 1; i < argc; i++)
+	{
+		if (qstrcmp(argv[i], "--script") == 0)
+		{
+			return runHeadless(argc, argv);
+		}
+	}
+
 	QApplication a(argc, argv);
 	dcTerm w;
 	w.show();
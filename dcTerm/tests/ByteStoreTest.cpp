@@ -0,0 +1,212 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: ByteStoreTest.cpp - Tests of the receive history ring and its line index.
+--
+-- PROGRAM: dcterm_tests
+--
+-- FUNCTIONS:
+-- void capacity();
+-- void wrapAround();
+-- void appendLargerThanCapacity();
+-- void lines();
+-- void clear();
+--
+-- QByteArray readAll(const ByteStore &store, qint64 offset);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--------------------------------------------------------------------------------------------------*/
+#include <QTest>
+
+#include "ByteStore.h"
+#include "ByteStoreTest.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: readAll
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: QByteArray readAll (const ByteStore &store, qint64 offset)
+--
+-- RETURNS: QByteArray - everything the store holds from offset on.
+--------------------------------------------------------------------------------------------------*/
+static QByteArray readAll(const ByteStore &store, qint64 offset)
+{
+	QByteArray out(store.capacity(), '\0');
+	out.resize(store.read(offset, out.data(), out.size()));
+	return out;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: capacity
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void capacity (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- The capacity is rounded down to a power of two and nothing is allocated until the first append.
+--------------------------------------------------------------------------------------------------*/
+void ByteStoreTest::capacity()
+{
+	QCOMPARE(ByteStore(1024).capacity(), 1024);
+	QCOMPARE(ByteStore(1).capacity(), 1);
+
+	ByteStore store(1000);
+	QCOMPARE(store.capacity(), 512);
+	QCOMPARE(store.memoryUsage(), 0);
+	QCOMPARE(store.begin(), Q_INT64_C(0));
+	QCOMPARE(store.end(), Q_INT64_C(0));
+
+	store.append("x", 1);
+	QVERIFY(store.memoryUsage() >= 512);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: wrapAround
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void wrapAround (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Once the ring is full the oldest bytes are dropped, and reads before begin() start at begin().
+--------------------------------------------------------------------------------------------------*/
+void ByteStoreTest::wrapAround()
+{
+	ByteStore store(16);
+	store.append("0123456789", 10);
+	store.append("abcdefghij", 10);
+
+	QCOMPARE(store.begin(), Q_INT64_C(4));
+	QCOMPARE(store.end(), Q_INT64_C(20));
+	QCOMPARE(readAll(store, 0), QByteArray("456789abcdefghij"));
+	QCOMPARE(readAll(store, 14), QByteArray("efghij"));
+
+	char out[4];
+	QCOMPARE(store.read(18, out, 4), 2);
+	QCOMPARE(QByteArray(out, 2), QByteArray("ij"));
+	QCOMPARE(store.read(20, out, 4), 0);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: appendLargerThanCapacity
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void appendLargerThanCapacity (void)
+--
+-- RETURNS: void.
+--------------------------------------------------------------------------------------------------*/
+void ByteStoreTest::appendLargerThanCapacity()
+{
+	ByteStore store(16);
+	store.append("abc", 3);
+	QByteArray data("ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789");
+	store.append(data.constData(), data.size());
+
+	QCOMPARE(store.end(), Q_INT64_C(39));
+	QCOMPARE(store.begin(), Q_INT64_C(23));
+	QCOMPARE(readAll(store, 0), data.right(16));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: lines
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void lines (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- A line ends at every '\r' and '\n', as in the console, and line 0 is the line in progress.
+--------------------------------------------------------------------------------------------------*/
+void ByteStoreTest::lines()
+{
+	ByteStore store(64);
+	store.append("a\nbb\r\nccc", 9);
+
+	QCOMPARE(store.lineCount(), 4);
+	QCOMPARE(store.lineStart(0), Q_INT64_C(6));
+	QCOMPARE(store.lineStart(1), Q_INT64_C(5));
+	QCOMPARE(store.lineStart(2), Q_INT64_C(2));
+	QCOMPARE(store.lineStart(3), Q_INT64_C(0));
+
+	QCOMPARE(store.lineFromEnd(7), 0);
+	QCOMPARE(store.lineFromEnd(2), 2);
+	QCOMPARE(store.lineFromEnd(1), 3);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: clear
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void clear (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Offsets keep counting after a clear so views holding an offset stay consistent.
+--------------------------------------------------------------------------------------------------*/
+void ByteStoreTest::clear()
+{
+	ByteStore store(16);
+	store.append("one\ntwo\n", 8);
+	store.clear();
+
+	QCOMPARE(store.begin(), store.end());
+	QCOMPARE(store.end(), Q_INT64_C(8));
+	QCOMPARE(store.lineCount(), 1);
+	QCOMPARE(readAll(store, 0), QByteArray());
+
+	qint64 start = store.end();
+	store.append("three", 5);
+	QCOMPARE(readAll(store, start), QByteArray("three"));
+	QCOMPARE(store.lineStart(0), store.begin());
+}
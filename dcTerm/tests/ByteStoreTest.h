@@ -0,0 +1,16 @@
+#pragma once
+
+#include <QObject>
+
+class ByteStoreTest
+	: public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void capacity();
+	void wrapAround();
+	void appendLargerThanCapacity();
+	void lines();
+	void clear();
+};
@@ -0,0 +1,214 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: CaptureDiffTest.cpp - Tests of the line diff between a capture and a known-good one.
+--
+-- PROGRAM: dcterm_tests
+--
+-- FUNCTIONS:
+-- void identical();
+-- void changedLines();
+-- void lineEndings();
+-- void ignorePatterns();
+-- void tooDifferent();
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--------------------------------------------------------------------------------------------------*/
+#include <QTest>
+
+#include "ByteStore.h"
+#include "CaptureDiff.h"
+#include "CaptureDiffTest.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: identical
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void identical (void)
+--
+-- RETURNS: void.
+--------------------------------------------------------------------------------------------------*/
+void CaptureDiffTest::identical()
+{
+	CaptureDiff diff;
+	diff.append(CaptureDiff::Old, "one\ntwo\n", 8);
+	diff.append(CaptureDiff::New, "one\ntwo\n", 8);
+
+	QVERIFY(diff.compare());
+	QCOMPARE(diff.firstDifference(), -1);
+	QVERIFY(diff.edits().isEmpty());
+	QCOMPARE(diff.report(), QString("The sides match: 2 lines.\n"));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: changedLines
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void changedLines (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- A changed line is a removal and an addition, and the report shows them in unified diff form.
+--------------------------------------------------------------------------------------------------*/
+void CaptureDiffTest::changedLines()
+{
+	CaptureDiff diff;
+	diff.append(CaptureDiff::Old, "a\nb\nc\nd\n", 8);
+	diff.append(CaptureDiff::New, "a\nB\nc\nd\ne\n", 10);
+
+	QVERIFY(diff.compare());
+	QVERIFY(diff.isComplete());
+	QCOMPARE(diff.firstDifference(), 1);
+
+	const QVector<DiffEdit> &edits = diff.edits();
+	QCOMPARE(edits.size(), 3);
+	QCOMPARE(edits[0].type, DiffEdit::Removed);
+	QCOMPARE(edits[0].oldLine, 1);
+	QCOMPARE(edits[1].type, DiffEdit::Added);
+	QCOMPARE(edits[1].newLine, 1);
+	QCOMPARE(edits[2].type, DiffEdit::Added);
+	QCOMPARE(edits[2].newLine, 4);
+
+	QCOMPARE(diff.report(), QString("3 lines removed or added, the first difference at line 2.\n"
+		"@@ -1 +1 @@\n"
+		" a\n"
+		"-b\n"
+		"+B\n"
+		" c\n"
+		" d\n"
+		"+e\n"));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: lineEndings
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void lineEndings (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- CRLF and LF lines compare equal, lines may arrive split across appends, and a history side
+-- reports offsets in the store's own numbering.
+--------------------------------------------------------------------------------------------------*/
+void CaptureDiffTest::lineEndings()
+{
+	ByteStore history(64);
+	history.append("skip\n", 5);
+	history.clear();
+	history.append("one\r\ntwo\r\nthree", 15);
+
+	CaptureDiff diff;
+	diff.loadHistory(CaptureDiff::Old, history);
+	diff.append(CaptureDiff::New, "on", 2);
+	diff.append(CaptureDiff::New, "e\ntw", 4);
+	diff.append(CaptureDiff::New, "o\nthree", 7);
+
+	QVERIFY(diff.compare());
+	QCOMPARE(diff.firstDifference(), -1);
+	QCOMPARE(diff.lineCount(CaptureDiff::Old), 3);
+	QCOMPARE(diff.lineText(CaptureDiff::Old, 1), QByteArray("two"));
+	QCOMPARE(diff.lineOffset(CaptureDiff::Old, 1), Q_INT64_C(10));
+	QCOMPARE(diff.lineOffset(CaptureDiff::New, 2), Q_INT64_C(8));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: ignorePatterns
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void ignorePatterns (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Text matching an ignore pattern is left out of the comparison but kept in the report.
+--------------------------------------------------------------------------------------------------*/
+void CaptureDiffTest::ignorePatterns()
+{
+	CaptureDiff diff;
+	QString error;
+	QVERIFY(!diff.setIgnorePatterns(QStringList() << "(unclosed", &error));
+	QVERIFY(error.startsWith("(unclosed: "));
+
+	QVERIFY(diff.setIgnorePatterns(QStringList() << "\\d\\d:\\d\\d:\\d\\d" << QString(), &error));
+	diff.append(CaptureDiff::Old, "12:00:01 boot\n12:00:02 ready\n", 29);
+	diff.append(CaptureDiff::New, "09:14:55 boot\n09:14:59 ready\n", 29);
+	QVERIFY(diff.compare());
+	QCOMPARE(diff.firstDifference(), -1);
+
+	diff.clear();
+	diff.append(CaptureDiff::Old, "12:00:01 boot\n", 14);
+	diff.append(CaptureDiff::New, "09:14:55 halt\n", 14);
+	QVERIFY(diff.compare());
+	QCOMPARE(diff.firstDifference(), 0);
+	QVERIFY(diff.report().contains("-12:00:01 boot\n+09:14:55 halt\n"));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: tooDifferent
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void tooDifferent (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Past MAX_DISTANCE edits the search gives up and only the first difference is known.
+--------------------------------------------------------------------------------------------------*/
+void CaptureDiffTest::tooDifferent()
+{
+	CaptureDiff diff;
+	for (int i = 0; i < CaptureDiff::MAX_DISTANCE + 100; i++)
+	{
+		QByteArray oldLine = "old " + QByteArray::number(i) + "\n";
+		QByteArray newLine = "new " + QByteArray::number(i) + "\n";
+		diff.append(CaptureDiff::Old, oldLine.constData(), oldLine.size());
+		diff.append(CaptureDiff::New, newLine.constData(), newLine.size());
+	}
+
+	QVERIFY(!diff.compare());
+	QVERIFY(!diff.isComplete());
+	QCOMPARE(diff.firstDifference(), 0);
+	QVERIFY(diff.report().startsWith("The sides differ by more than 2000 lines. They first differ at line 1:\n"
+		"-old 0\n-old 1\n-old 2\n+new 0\n"));
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <QObject>
+
+class CaptureDiffTest
+	: public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void identical();
+	void changedLines();
+	void lineEndings();
+	void ignorePatterns();
+	void tooDifferent();
+};
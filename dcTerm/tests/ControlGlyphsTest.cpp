@@ -0,0 +1,222 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: ControlGlyphsTest.cpp - Tests of the control character and invalid byte glyphs.
+--
+-- PROGRAM: dcterm_tests
+--
+-- FUNCTIONS:
+-- void controlCharacters();
+-- void invalidBytes();
+-- void splitSequence();
+-- void unfinishedSequence();
+-- void plainRun();
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--------------------------------------------------------------------------------------------------*/
+#include <QByteArray>
+#include <QTest>
+
+#include "ControlGlyphs.h"
+#include "ControlGlyphsTest.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: controlCharacters
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void controlCharacters (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Control characters are shown in caret notation, and neighbouring glyphs share one span.
+--------------------------------------------------------------------------------------------------*/
+void ControlGlyphsTest::controlCharacters()
+{
+	ControlGlyphs glyphs;
+	QString text;
+	QVector<GlyphSpan> spans;
+	glyphs.render("a\0b\x1b\x7f\t\r\n", 8, text, spans);
+
+	QCOMPARE(text, QString("a^@b^[^?\t\r\n"));
+	QCOMPARE(spans.size(), 2);
+	QCOMPARE(spans[0].start, 1);
+	QCOMPARE(spans[0].length, 2);
+	QVERIFY(!spans[0].invalid);
+	QCOMPARE(spans[1].start, 4);
+	QCOMPARE(spans[1].length, 4);
+	QVERIFY(!spans[1].invalid);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: invalidBytes
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void invalidBytes (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Bytes that cannot start or continue a UTF-8 sequence are shown in hex, including an encoded
+-- surrogate, while valid sequences are decoded.
+--------------------------------------------------------------------------------------------------*/
+void ControlGlyphsTest::invalidBytes()
+{
+	ControlGlyphs glyphs;
+	QString text;
+	QVector<GlyphSpan> spans;
+	glyphs.render("x\xff\xc3\xa9\xed\xa0", 6, text, spans);
+
+	QCOMPARE(text, QString::fromUtf8("x<FF>\xc3\xa9<ED><A0>"));
+	QCOMPARE(spans.size(), 2);
+	QCOMPARE(spans[0].start, 1);
+	QCOMPARE(spans[0].length, 4);
+	QVERIFY(spans[0].invalid);
+	QCOMPARE(spans[1].start, 6);
+	QCOMPARE(spans[1].length, 8);
+	QVERIFY(spans[1].invalid);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: splitSequence
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void splitSequence (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- A sequence cut by a read boundary is held back and decoded once the rest arrives.
+--------------------------------------------------------------------------------------------------*/
+void ControlGlyphsTest::splitSequence()
+{
+	ControlGlyphs glyphs;
+	QString text;
+	QVector<GlyphSpan> spans;
+	glyphs.render("\xe2", 1, text, spans);
+	glyphs.render("\x82", 1, text, spans);
+	QVERIFY(text.isEmpty());
+
+	glyphs.render("\xac!", 2, text, spans);
+	QCOMPARE(text, QString::fromUtf8("\xe2\x82\xac!"));
+	QVERIFY(spans.isEmpty());
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: unfinishedSequence
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void unfinishedSequence (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- A held back sequence that the next read does not finish is shown in hex, and reset() drops it.
+--------------------------------------------------------------------------------------------------*/
+void ControlGlyphsTest::unfinishedSequence()
+{
+	ControlGlyphs glyphs;
+	QString text;
+	QVector<GlyphSpan> spans;
+	glyphs.render("\xe2\x82", 2, text, spans);
+	glyphs.render("A", 1, text, spans);
+
+	QCOMPARE(text, QString("<E2><82>A"));
+	QCOMPARE(spans.size(), 1);
+	QCOMPARE(spans[0].length, 8);
+	QVERIFY(spans[0].invalid);
+
+	text.clear();
+	spans.clear();
+	glyphs.render("\xe2\x82", 2, text, spans);
+	glyphs.reset();
+	glyphs.render("A", 1, text, spans);
+	QCOMPARE(text, QString("A"));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: plainRun
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void plainRun (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- The vector scan must stop on the same byte as a byte-at-a-time scan, at every offset and
+-- alignment.
+--------------------------------------------------------------------------------------------------*/
+void ControlGlyphsTest::plainRun()
+{
+	QByteArray data;
+	quint32 seed = 1;
+	for (int i = 0; i < 4096; i++)
+	{
+		seed = seed * 1103515245 + 12345;
+		int kind = (seed >> 16) % 16;
+		char byte = static_cast<char>(0x20 + (seed >> 8) % 95);
+		if (kind == 0)
+		{
+			byte = static_cast<char>((seed >> 8) % 32);
+		}
+		else if (kind == 1)
+		{
+			byte = static_cast<char>(0x7F + (seed >> 8) % 129);
+		}
+		data.append(byte);
+	}
+
+	for (int i = 0; i < data.size(); i++)
+	{
+		int expected = i;
+		while (expected < data.size())
+		{
+			uchar byte = static_cast<uchar>(data[expected]);
+			if ((byte < 0x20 || byte >= 0x7F) && byte != '\t' && byte != '\n' && byte != '\r')
+			{
+				break;
+			}
+			expected++;
+		}
+		QCOMPARE(ControlGlyphs::plainRun(data.constData() + i, data.size() - i), expected - i);
+	}
+}
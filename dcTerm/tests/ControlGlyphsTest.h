@@ -0,0 +1,16 @@
+#pragma once
+
+#include <QObject>
+
+class ControlGlyphsTest
+	: public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void controlCharacters();
+	void invalidBytes();
+	void splitSequence();
+	void unfinishedSequence();
+	void plainRun();
+};
@@ -0,0 +1,410 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: FrameDecoderTest.cpp - Tests of the SLIP, COBS, length prefix and delimiter
+--                                     framers.
+--
+-- PROGRAM: dcterm_tests
+--
+-- FUNCTIONS:
+-- void slipFrames();
+-- void slipMalformed();
+-- void cobsFrames();
+-- void cobsLongBlock();
+-- void cobsMalformed();
+-- void lengthPrefixFrames();
+-- void delimiterFrames();
+-- void overlappingDelimiter();
+-- void crcCheck();
+-- void overflow();
+--
+-- Decoded decode(FrameDecoder &decoder, const QByteArray &stream, int chunkSize);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Add overlappingDelimiter.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- Every stream is fed one byte at a time, in small chunks and all at once, since a frame may be
+-- split across reads from the port at any byte.
+--------------------------------------------------------------------------------------------------*/
+#include <QTest>
+#include <QVector>
+
+#include "FrameDecoder.h"
+#include "FrameDecoderTest.h"
+
+namespace
+{
+	const int CHUNK_SIZES[] = { 1, 3, 1 << 20 };
+
+	struct Decoded
+	{
+		QVector<QByteArray> frames;
+		QVector<int> statuses;
+	};
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: decode
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: Decoded decode (FrameDecoder &decoder, const QByteArray &stream, int chunkSize)
+--
+-- RETURNS: Decoded - the frames decoded from stream and their statuses, in order.
+--
+-- NOTES:
+-- Resets decoder, then feeds it stream in chunks of chunkSize bytes.
+--------------------------------------------------------------------------------------------------*/
+static Decoded decode(FrameDecoder &decoder, const QByteArray &stream, int chunkSize)
+{
+	Decoded decoded;
+	decoder.reset();
+	for (int i = 0; i < stream.size(); i += chunkSize)
+	{
+		decoder.feed(stream.constData() + i, qMin(chunkSize, stream.size() - i),
+			[&decoded](const char* data, int length, FrameDecoder::FrameStatus status)
+		{
+			decoded.frames.append(QByteArray(data, length));
+			decoded.statuses.append(status);
+		});
+	}
+	return decoded;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: slipFrames
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void slipFrames (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Escaped END and ESC bytes are restored and the empty frame between two ENDs is skipped.
+--------------------------------------------------------------------------------------------------*/
+void FrameDecoderTest::slipFrames()
+{
+	QByteArray stream("\xC0" "hello" "\xC0\xC0" "wo\xDB\xDC" "rld\xDB\xDD" "\xC0");
+	QVector<QByteArray> frames;
+	frames << "hello" << QByteArray("wo\xC0" "rld\xDB");
+
+	SlipDecoder decoder;
+	for (int chunkSize : CHUNK_SIZES)
+	{
+		Decoded decoded = decode(decoder, stream, chunkSize);
+		QCOMPARE(decoded.frames, frames);
+		QCOMPARE(decoded.statuses, QVector<int>() << FrameDecoder::FrameOk << FrameDecoder::FrameOk);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: slipMalformed
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void slipMalformed (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- A bad escape spoils only its own frame; the next frame decodes normally.
+--------------------------------------------------------------------------------------------------*/
+void FrameDecoderTest::slipMalformed()
+{
+	QByteArray stream("ab\xDB" "xc\xC0" "ok\xC0");
+
+	SlipDecoder decoder;
+	for (int chunkSize : CHUNK_SIZES)
+	{
+		Decoded decoded = decode(decoder, stream, chunkSize);
+		QCOMPARE(decoded.frames, QVector<QByteArray>() << "abxc" << "ok");
+		QCOMPARE(decoded.statuses, QVector<int>() << FrameDecoder::FrameMalformed << FrameDecoder::FrameOk);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: cobsFrames
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void cobsFrames (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Zeros inside a frame come back, including a frame that is a single zero.
+--------------------------------------------------------------------------------------------------*/
+void FrameDecoderTest::cobsFrames()
+{
+	QByteArray stream("\x03\x11\x22\x02\x33\x00" "\x01\x01\x00", 9);
+	QVector<QByteArray> frames;
+	frames << QByteArray("\x11\x22\x00\x33", 4) << QByteArray(1, '\0');
+
+	CobsDecoder decoder;
+	for (int chunkSize : CHUNK_SIZES)
+	{
+		Decoded decoded = decode(decoder, stream, chunkSize);
+		QCOMPARE(decoded.frames, frames);
+		QCOMPARE(decoded.statuses, QVector<int>() << FrameDecoder::FrameOk << FrameDecoder::FrameOk);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: cobsLongBlock
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void cobsLongBlock (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- A block with code 0xFF holds 254 bytes and is not followed by a zero.
+--------------------------------------------------------------------------------------------------*/
+void FrameDecoderTest::cobsLongBlock()
+{
+	QByteArray payload(300, 'a');
+	QByteArray stream;
+	stream += '\xFF';
+	stream += payload.left(254);
+	stream += static_cast<char>(300 - 254 + 1);
+	stream += payload.mid(254);
+	stream += '\0';
+
+	CobsDecoder decoder;
+	for (int chunkSize : CHUNK_SIZES)
+	{
+		Decoded decoded = decode(decoder, stream, chunkSize);
+		QCOMPARE(decoded.frames, QVector<QByteArray>() << payload);
+		QCOMPARE(decoded.statuses, QVector<int>() << FrameDecoder::FrameOk);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: cobsMalformed
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void cobsMalformed (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- A delimiter in the middle of a block means bytes were lost.
+--------------------------------------------------------------------------------------------------*/
+void FrameDecoderTest::cobsMalformed()
+{
+	QByteArray stream("\x05\x11\x22\x00" "\x02\x44\x00", 7);
+
+	CobsDecoder decoder;
+	for (int chunkSize : CHUNK_SIZES)
+	{
+		Decoded decoded = decode(decoder, stream, chunkSize);
+		QCOMPARE(decoded.frames, QVector<QByteArray>() << "\x11\x22" << "\x44");
+		QCOMPARE(decoded.statuses, QVector<int>() << FrameDecoder::FrameMalformed << FrameDecoder::FrameOk);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: lengthPrefixFrames
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void lengthPrefixFrames (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Two byte big endian and four byte little endian headers, split across chunks like the payload.
+--------------------------------------------------------------------------------------------------*/
+void FrameDecoderTest::lengthPrefixFrames()
+{
+	QByteArray bigStream("\x00\x03" "abc" "\x00\x01" "x", 8);
+	QByteArray littleStream("\x02\x00\x00\x00" "hi" "\x01\x00\x00\x00" "!", 11);
+
+	LengthPrefixDecoder big(2, true);
+	LengthPrefixDecoder little(4, false);
+	for (int chunkSize : CHUNK_SIZES)
+	{
+		QCOMPARE(decode(big, bigStream, chunkSize).frames, QVector<QByteArray>() << "abc" << "x");
+		QCOMPARE(decode(little, littleStream, chunkSize).frames, QVector<QByteArray>() << "hi" << "!");
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: delimiterFrames
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void delimiterFrames (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- A false start of the delimiter is payload, and the delimiter is not part of the frame.
+--------------------------------------------------------------------------------------------------*/
+void FrameDecoderTest::delimiterFrames()
+{
+	QByteArray stream("one\r\ntwo\rx\r\n\r\n");
+
+	DelimiterDecoder decoder("\r\n");
+	for (int chunkSize : CHUNK_SIZES)
+	{
+		QCOMPARE(decode(decoder, stream, chunkSize).frames, QVector<QByteArray>() << "one" << "two\rx" << "");
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: overlappingDelimiter
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void overlappingDelimiter (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- A delimiter whose prefix repeats inside it, such as "aab", must still end a frame when a false
+-- start runs into the real delimiter, as in "aaab".
+--------------------------------------------------------------------------------------------------*/
+void FrameDecoderTest::overlappingDelimiter()
+{
+	QByteArray stream("aaabxaabaaaabab aab");
+
+	DelimiterDecoder decoder("aab");
+	for (int chunkSize : CHUNK_SIZES)
+	{
+		QCOMPARE(decode(decoder, stream, chunkSize).frames, QVector<QByteArray>() << "a" << "x" << "aa" << "ab ");
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: crcCheck
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void crcCheck (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- The CRC is the CRC-16/CCITT-FALSE check value for "123456789", stripped from a good frame and
+-- reported as an error when a byte of the frame is changed.
+--------------------------------------------------------------------------------------------------*/
+void FrameDecoderTest::crcCheck()
+{
+	QCOMPARE(FrameDecoder::crc16("123456789", 9), static_cast<quint16>(0x29B1));
+
+	QByteArray good("\x00\x0B" "123456789" "\x29\xB1", 13);
+	QByteArray bad = good;
+	bad[4] = '0';
+
+	LengthPrefixDecoder decoder(2, true);
+	decoder.setCrcCheck(true);
+	QVERIFY(decoder.crcCheck());
+	for (int chunkSize : CHUNK_SIZES)
+	{
+		Decoded decoded = decode(decoder, good + bad, chunkSize);
+		QCOMPARE(decoded.frames, QVector<QByteArray>() << "123456789" << "120456789");
+		QCOMPARE(decoded.statuses, QVector<int>() << FrameDecoder::FrameOk << FrameDecoder::FrameCrcError);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: overflow
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void overflow (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- A frame longer than the buffer is cut off at MAX_FRAME_SIZE and the decoder recovers for the
+-- next frame.
+--------------------------------------------------------------------------------------------------*/
+void FrameDecoderTest::overflow()
+{
+	QByteArray stream(FrameDecoder::MAX_FRAME_SIZE + 100, 'z');
+	stream += "\nnext\n";
+
+	DelimiterDecoder decoder("\n");
+	Decoded decoded = decode(decoder, stream, 4096);
+	QCOMPARE(decoded.frames.size(), 2);
+	QCOMPARE(decoded.frames[0].size(), static_cast<int>(FrameDecoder::MAX_FRAME_SIZE));
+	QCOMPARE(decoded.statuses[0], static_cast<int>(FrameDecoder::FrameOverflow));
+	QCOMPARE(decoded.frames[1], QByteArray("next"));
+	QCOMPARE(decoded.statuses[1], static_cast<int>(FrameDecoder::FrameOk));
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <QObject>
+
+class FrameDecoderTest
+	: public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void slipFrames();
+	void slipMalformed();
+	void cobsFrames();
+	void cobsLongBlock();
+	void cobsMalformed();
+	void lengthPrefixFrames();
+	void delimiterFrames();
+	void overlappingDelimiter();
+	void crcCheck();
+	void overflow();
+};
@@ -0,0 +1,146 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: HighlightRulesTest.cpp - Tests of matching highlight rules against a line.
+--
+-- PROGRAM: dcterm_tests
+--
+-- FUNCTIONS:
+-- void backreference();
+-- void overlappingRules();
+-- void sharedGroupNames();
+--
+-- HighlightRule rule(const QString &pattern);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--------------------------------------------------------------------------------------------------*/
+#include <QTest>
+#include <QVector>
+
+#include "HighlightRules.h"
+#include "HighlightRulesTest.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: rule
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: HighlightRule rule (const QString &pattern)
+--
+-- RETURNS: HighlightRule - a rule for pattern in plain red.
+--------------------------------------------------------------------------------------------------*/
+static HighlightRule rule(const QString &pattern)
+{
+	HighlightRule result = { pattern, "red", QString(), false, false, false };
+	return result;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: backreference
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void backreference (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- A rule after one with groups of its own keeps its group numbering, so \1 refers to its own
+-- first group.
+--------------------------------------------------------------------------------------------------*/
+void HighlightRulesTest::backreference()
+{
+	HighlightRules rules;
+	rules.setRules(QVector<HighlightRule>() << rule("(ERR)(OR)") << rule("(\\w)\\1"));
+
+	QVector<HighlightSpan> spans;
+	rules.match("abba", spans);
+	QCOMPARE(spans.size(), 1);
+	QCOMPARE(spans[0].rule, 1);
+	QCOMPARE(spans[0].start, 1);
+	QCOMPARE(spans[0].length, 2);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: overlappingRules
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void overlappingRules (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Both rules are found where they overlap, and the first rule's span comes last so its style is
+-- applied on top.
+--------------------------------------------------------------------------------------------------*/
+void HighlightRulesTest::overlappingRules()
+{
+	HighlightRules rules;
+	rules.setRules(QVector<HighlightRule>() << rule("ERROR") << rule("ERROR: \\w+"));
+
+	QVector<HighlightSpan> spans;
+	rules.match("ERROR: disk", spans);
+	QCOMPARE(spans.size(), 2);
+	QCOMPARE(spans[0].rule, 1);
+	QCOMPARE(spans[0].start, 0);
+	QCOMPARE(spans[0].length, 11);
+	QCOMPARE(spans[1].rule, 0);
+	QCOMPARE(spans[1].start, 0);
+	QCOMPARE(spans[1].length, 5);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: sharedGroupNames
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void sharedGroupNames (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Two rules that name a group the same would not compile as one expression, but each still
+-- matches on its own.
+--------------------------------------------------------------------------------------------------*/
+void HighlightRulesTest::sharedGroupNames()
+{
+	HighlightRules rules;
+	rules.setRules(QVector<HighlightRule>() << rule("(?<code>E\\d+)") << rule("(?<code>W\\d+)"));
+
+	QVector<HighlightSpan> spans;
+	rules.match("W12 E3", spans);
+	QCOMPARE(spans.size(), 2);
+	QCOMPARE(spans[0].rule, 1);
+	QCOMPARE(spans[0].start, 0);
+	QCOMPARE(spans[1].rule, 0);
+	QCOMPARE(spans[1].start, 4);
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <QObject>
+
+class HighlightRulesTest
+	: public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void backreference();
+	void overlappingRules();
+	void sharedGroupNames();
+};
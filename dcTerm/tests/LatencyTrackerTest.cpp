@@ -0,0 +1,336 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: LatencyTrackerTest.cpp - Tests of the request to response latency histogram.
+--
+-- PROGRAM: dcterm_tests
+--
+-- FUNCTIONS:
+-- void firstByte();
+-- void terminatorAcrossReads();
+-- void overlappingTerminator();
+-- void queuedRequests();
+-- void timeouts();
+-- void percentiles();
+-- void recentWindow();
+-- void csv();
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Tests the recent latency histograms.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--------------------------------------------------------------------------------------------------*/
+#include <QBuffer>
+#include <QList>
+#include <QTest>
+
+#include "LatencyTracker.h"
+#include "LatencyTrackerTest.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: firstByte
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void firstByte (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Without a terminator the first byte back answers the request, and only a line ending sent
+-- starts one.
+--------------------------------------------------------------------------------------------------*/
+void LatencyTrackerTest::firstByte()
+{
+	LatencyTracker tracker;
+	tracker.sent(0, "A", 1);
+	QCOMPARE(tracker.pending(), 0);
+	tracker.received(100, "x", 1);
+	QCOMPARE(tracker.count(), Q_UINT64_C(0));
+
+	tracker.sent(1000, "AT\r", 3);
+	QCOMPARE(tracker.pending(), 1);
+	tracker.received(1500, "O", 1);
+	tracker.received(1600, "K", 1);
+	QCOMPARE(tracker.count(), Q_UINT64_C(1));
+	QCOMPARE(tracker.minimum(), Q_INT64_C(500));
+	QCOMPARE(tracker.maximum(), Q_INT64_C(500));
+	QCOMPARE(tracker.pending(), 0);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: terminatorAcrossReads
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void terminatorAcrossReads (void)
+--
+-- RETURNS: void.
+--------------------------------------------------------------------------------------------------*/
+void LatencyTrackerTest::terminatorAcrossReads()
+{
+	LatencyTracker tracker;
+	tracker.setTerminator("OK\r\n");
+	tracker.sent(0, "AT\r\n", 4);
+	tracker.received(100, "O", 1);
+	tracker.received(200, "K\r", 2);
+	QCOMPARE(tracker.count(), Q_UINT64_C(0));
+	tracker.received(300, "\n", 1);
+	QCOMPARE(tracker.count(), Q_UINT64_C(1));
+	QCOMPARE(tracker.maximum(), Q_INT64_C(300));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: overlappingTerminator
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void overlappingTerminator (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- A restart on mismatch would lose the "aab" that ends "aaab".
+--------------------------------------------------------------------------------------------------*/
+void LatencyTrackerTest::overlappingTerminator()
+{
+	LatencyTracker tracker;
+	tracker.setTerminator("aab");
+	tracker.sent(0, "\n", 1);
+	tracker.received(50, "aaab", 4);
+	QCOMPARE(tracker.count(), Q_UINT64_C(1));
+	QCOMPARE(tracker.minimum(), Q_INT64_C(50));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: queuedRequests
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void queuedRequests (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Requests sent before the first answer are answered in order, each by its own terminator.
+--------------------------------------------------------------------------------------------------*/
+void LatencyTrackerTest::queuedRequests()
+{
+	LatencyTracker tracker;
+	tracker.setTerminator("\n");
+	tracker.sent(0, "a\n", 2);
+	tracker.sent(10, "b\n", 2);
+	QCOMPARE(tracker.pending(), 2);
+
+	tracker.received(100, "x\ny\n", 4);
+	QCOMPARE(tracker.count(), Q_UINT64_C(2));
+	QCOMPARE(tracker.pending(), 0);
+	QCOMPARE(tracker.minimum(), Q_INT64_C(90));
+	QCOMPARE(tracker.maximum(), Q_INT64_C(100));
+	QCOMPARE(tracker.mean(), 95.0);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: timeouts
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void timeouts (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- A request unanswered for longer than the timeout, or pushed out of a full queue, is counted as
+-- a timeout and never as a latency.
+--------------------------------------------------------------------------------------------------*/
+void LatencyTrackerTest::timeouts()
+{
+	LatencyTracker tracker;
+	QCOMPARE(tracker.timeout(), static_cast<qint64>(LatencyTracker::DEFAULT_TIMEOUT));
+	tracker.setTimeout(1000);
+
+	tracker.sent(0, "\n", 1);
+	tracker.received(2000, "x", 1);
+	QCOMPARE(tracker.count(), Q_UINT64_C(0));
+	QCOMPARE(tracker.timeouts(), Q_UINT64_C(1));
+
+	for (int i = 0; i <= LatencyTracker::MAX_PENDING; i++)
+	{
+		tracker.sent(3000, "\n", 1);
+	}
+	QCOMPARE(tracker.pending(), static_cast<int>(LatencyTracker::MAX_PENDING));
+	QCOMPARE(tracker.timeouts(), Q_UINT64_C(2));
+
+	tracker.clear();
+	QCOMPARE(tracker.pending(), 0);
+	QCOMPARE(tracker.timeouts(), Q_UINT64_C(0));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: percentiles
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void percentiles (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- With 32 sub-buckets a percentile is at most 1/32 above the true value, and never above the
+-- largest latency seen.
+--------------------------------------------------------------------------------------------------*/
+void LatencyTrackerTest::percentiles()
+{
+	LatencyTracker tracker;
+	for (int latency = 1; latency <= 1000; latency++)
+	{
+		qint64 start = latency * 10000;
+		tracker.sent(start, "\n", 1);
+		tracker.received(start + latency, "x", 1);
+	}
+	QCOMPARE(tracker.count(), Q_UINT64_C(1000));
+
+	qint64 median = tracker.percentile(50);
+	QVERIFY(median >= 500);
+	QVERIFY(median <= 500 + 500 / LatencyTracker::SUB_BUCKETS);
+	QCOMPARE(tracker.percentile(100), Q_INT64_C(1000));
+	QCOMPARE(tracker.percentile(0), Q_INT64_C(1));
+	QVERIFY(tracker.percentile(99) >= 990);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: recentWindow
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void recentWindow (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Slow answers in one interval and fast ones in the next. The recent figures hold both until the
+-- slow interval is more than an interval old, then only the fast ones, then nothing once the
+-- device goes quiet, while the overall figures keep everything.
+--------------------------------------------------------------------------------------------------*/
+void LatencyTrackerTest::recentWindow()
+{
+	const qint64 interval = LatencyTracker::WINDOW_INTERVAL;
+	LatencyTracker tracker;
+	for (int i = 0; i < 100; i++)
+	{
+		tracker.sent(i * 2000, "\n", 1);
+		tracker.received(i * 2000 + 1000, "x", 1);
+	}
+	for (int i = 0; i < 100; i++)
+	{
+		tracker.sent(interval + i * 2000, "\n", 1);
+		tracker.received(interval + i * 2000 + 10, "x", 1);
+	}
+
+	qint64 now = interval + 300000;
+	QCOMPARE(tracker.recentCount(now), Q_UINT64_C(200));
+	QCOMPARE(tracker.recentPercentile(50, now), Q_INT64_C(10));
+	QCOMPARE(tracker.recentPercentile(99, now), Q_INT64_C(1000));
+
+	now = 2 * interval + 1;
+	QCOMPARE(tracker.recentCount(now), Q_UINT64_C(100));
+	QCOMPARE(tracker.recentPercentile(99, now), Q_INT64_C(10));
+	QCOMPARE(tracker.percentile(99), Q_INT64_C(1000));
+	QCOMPARE(tracker.count(), Q_UINT64_C(200));
+
+	for (int i = 0; i < 100; i++)
+	{
+		tracker.sent(2 * interval + 500000 + i * 2000, "\n", 1);
+		tracker.received(2 * interval + 500000 + i * 2000 + 1000, "x", 1);
+	}
+	now = 2 * interval + 800000;
+	QCOMPARE(tracker.recentCount(now), Q_UINT64_C(200));
+	QCOMPARE(tracker.recentPercentile(99, now), Q_INT64_C(1000));
+	QCOMPARE(tracker.count(), Q_UINT64_C(300));
+
+	now = 5 * interval;
+	QCOMPARE(tracker.recentCount(now), Q_UINT64_C(0));
+	QCOMPARE(tracker.recentPercentile(50, now), Q_INT64_C(0));
+
+	tracker.clear();
+	QCOMPARE(tracker.recentCount(interval), Q_UINT64_C(0));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: csv
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void csv (void)
+--
+-- RETURNS: void.
+--------------------------------------------------------------------------------------------------*/
+void LatencyTrackerTest::csv()
+{
+	LatencyTracker tracker;
+	tracker.sent(0, "\n", 1);
+	tracker.received(10, "x", 1);
+	tracker.sent(100, "\n", 1);
+	tracker.received(300, "x", 1);
+
+	QBuffer buffer;
+	QVERIFY(buffer.open(QIODevice::WriteOnly));
+	QVERIFY(tracker.writeCsv(&buffer));
+
+	QList<QByteArray> rows = buffer.data().split('\n');
+	QCOMPARE(rows.size(), 4);
+	QCOMPARE(rows[0], QByteArray("latency_us,count,total_count,percentile"));
+	QCOMPARE(rows[1], QByteArray("10,1,1,50.000"));
+	QCOMPARE(rows[2], QByteArray("200,1,2,100.000"));
+	QVERIFY(rows[3].isEmpty());
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <QObject>
+
+class LatencyTrackerTest
+	: public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void firstByte();
+	void terminatorAcrossReads();
+	void overlappingTerminator();
+	void queuedRequests();
+	void timeouts();
+	void percentiles();
+	void recentWindow();
+	void csv();
+};
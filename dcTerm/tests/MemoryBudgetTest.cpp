@@ -0,0 +1,315 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: MemoryBudgetTest.cpp - Tests of the memory budget and the block pool charged to it.
+--
+-- PROGRAM: dcterm_tests
+--
+-- FUNCTIONS:
+-- void chargeAndRelease();
+-- void limits();
+-- void totalLimit();
+-- void poolReuse();
+-- void poolFull();
+-- void poolSharedBlock();
+-- void captureOverLimit();
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Tests the total limit and a capture that goes over its limit.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--------------------------------------------------------------------------------------------------*/
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "BlockPool.h"
+#include "CaptureFile.h"
+#include "CaptureReader.h"
+#include "MemoryBudget.h"
+#include "MemoryBudgetTest.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: chargeAndRelease
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void chargeAndRelease (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Peaks follow the highest use since the last reset and a release never goes below zero.
+--------------------------------------------------------------------------------------------------*/
+void MemoryBudgetTest::chargeAndRelease()
+{
+	MemoryBudget budget;
+	budget.charge(MemoryBudget::Receive, 1000);
+	budget.charge(MemoryBudget::Capture, 500);
+	budget.release(MemoryBudget::Receive, 400);
+	QCOMPARE(budget.current(MemoryBudget::Receive), Q_INT64_C(600));
+	QCOMPARE(budget.peak(MemoryBudget::Receive), Q_INT64_C(1000));
+	QCOMPARE(budget.total(), Q_INT64_C(1100));
+	QCOMPARE(budget.peakTotal(), Q_INT64_C(1500));
+
+	budget.set(MemoryBudget::Timing, 300);
+	QCOMPARE(budget.current(MemoryBudget::Timing), Q_INT64_C(300));
+
+	budget.resetPeaks();
+	QCOMPARE(budget.peak(MemoryBudget::Receive), Q_INT64_C(600));
+	QCOMPARE(budget.peakTotal(), Q_INT64_C(1400));
+
+	budget.release(MemoryBudget::Capture, 800);
+	QCOMPARE(budget.current(MemoryBudget::Capture), Q_INT64_C(0));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: limits
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void limits (void)
+--
+-- RETURNS: void.
+--------------------------------------------------------------------------------------------------*/
+void MemoryBudgetTest::limits()
+{
+	MemoryBudget budget;
+	budget.setLimit(MemoryBudget::History, 4096);
+	QCOMPARE(budget.limit(MemoryBudget::History), Q_INT64_C(4096));
+
+	budget.set(MemoryBudget::History, 4096);
+	QVERIFY(!budget.exceeded(MemoryBudget::History));
+	budget.charge(MemoryBudget::History, 1);
+	QVERIFY(budget.exceeded(MemoryBudget::History));
+	QVERIFY(!budget.exceeded(MemoryBudget::Scrollback));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: totalLimit
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void totalLimit (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- wouldExceed() checks both the subsystem's own limit and the total, and a total limit of 0 is
+-- no limit.
+--------------------------------------------------------------------------------------------------*/
+void MemoryBudgetTest::totalLimit()
+{
+	MemoryBudget budget;
+	budget.setTotalLimit(10000);
+	QCOMPARE(budget.totalLimit(), Q_INT64_C(10000));
+
+	budget.set(MemoryBudget::Scrollback, 6000);
+	budget.set(MemoryBudget::Timing, 3000);
+	QVERIFY(!budget.totalExceeded());
+	QVERIFY(!budget.wouldExceed(MemoryBudget::Timing, 1000));
+	QVERIFY(budget.wouldExceed(MemoryBudget::Timing, 1001));
+
+	budget.setLimit(MemoryBudget::Capture, 500);
+	QVERIFY(budget.wouldExceed(MemoryBudget::Capture, 501));
+
+	budget.charge(MemoryBudget::Highlight, 2000);
+	QVERIFY(budget.totalExceeded());
+	QVERIFY(!budget.exceeded(MemoryBudget::Highlight));
+
+	budget.setTotalLimit(0);
+	QVERIFY(!budget.totalExceeded());
+	QVERIFY(!budget.wouldExceed(MemoryBudget::Timing, 1000000));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: poolReuse
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void poolReuse (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- A released block is handed out again, still charged to the budget while it waits in the pool.
+--------------------------------------------------------------------------------------------------*/
+void MemoryBudgetTest::poolReuse()
+{
+	MemoryBudget budget;
+	{
+		BlockPool pool(1024, 4, &budget, MemoryBudget::Receive);
+		QByteArray block = pool.acquire();
+		QVERIFY(block.capacity() >= 1024);
+		block.append("data");
+		QCOMPARE(pool.allocations(), Q_INT64_C(1));
+		QCOMPARE(budget.current(MemoryBudget::Receive), Q_INT64_C(1024));
+
+		pool.release(block);
+		QVERIFY(block.isEmpty());
+		QCOMPARE(pool.freeBlocks(), 1);
+		QCOMPARE(budget.current(MemoryBudget::Receive), Q_INT64_C(1024));
+
+		block = pool.acquire();
+		QVERIFY(block.isEmpty());
+		QCOMPARE(pool.reuses(), Q_INT64_C(1));
+		QCOMPARE(pool.allocations(), Q_INT64_C(1));
+		QCOMPARE(pool.freeBlocks(), 0);
+		pool.release(block);
+	}
+	QCOMPARE(budget.current(MemoryBudget::Receive), Q_INT64_C(0));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: poolFull
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void poolFull (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Blocks released once the pool holds maxFree are freed and their charge released.
+--------------------------------------------------------------------------------------------------*/
+void MemoryBudgetTest::poolFull()
+{
+	MemoryBudget budget;
+	BlockPool pool(512, 2, &budget, MemoryBudget::Capture);
+	QByteArray blocks[3] = { pool.acquire(), pool.acquire(), pool.acquire() };
+	QCOMPARE(budget.current(MemoryBudget::Capture), Q_INT64_C(1536));
+
+	for (QByteArray &block : blocks)
+	{
+		pool.release(block);
+	}
+	QCOMPARE(pool.freeBlocks(), 2);
+	QCOMPARE(budget.current(MemoryBudget::Capture), Q_INT64_C(1024));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: poolSharedBlock
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void poolSharedBlock (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- A block still shared with a copy cannot be reused, since the copy would see it overwritten.
+--------------------------------------------------------------------------------------------------*/
+void MemoryBudgetTest::poolSharedBlock()
+{
+	MemoryBudget budget;
+	BlockPool pool(256, 4, &budget, MemoryBudget::Receive);
+	QByteArray block = pool.acquire();
+	block.append("shared");
+	QByteArray copy = block;
+
+	pool.release(block);
+	QCOMPARE(pool.freeBlocks(), 0);
+	QCOMPARE(budget.current(MemoryBudget::Receive), Q_INT64_C(0));
+	QCOMPARE(copy, QByteArray("shared"));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: captureOverLimit
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void captureOverLimit (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- With no room for a second block, records past the first block are dropped. Once there is room
+-- again the capture goes on after an event record saying what was lost.
+--------------------------------------------------------------------------------------------------*/
+void MemoryBudgetTest::captureOverLimit()
+{
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	QString path = dir.filePath("over.dcap");
+
+	MemoryBudget budget;
+	budget.setLimit(MemoryBudget::Capture, 0);
+	QByteArray data(1000, 'r');
+	const int fits = CaptureFile::BLOCK_SIZE / (CaptureFile::RECORD_HEADER_SIZE + data.size());
+
+	CaptureFile capture(&budget);
+	QVERIFY(capture.open(path));
+	for (int i = 0; i < fits + 10; i++)
+	{
+		capture.write(CaptureFile::Received, i, data);
+	}
+	QCOMPARE(capture.droppedBytes(), Q_INT64_C(10000));
+
+	budget.setLimit(MemoryBudget::Capture, 1024 * 1024);
+	capture.write(CaptureFile::Received, 100, data);
+	capture.close();
+	QCOMPARE(capture.droppedBytes(), Q_INT64_C(10000));
+
+	CaptureReader reader;
+	QString error;
+	QVERIFY2(reader.open(path, &error), qPrintable(error));
+	CaptureRecord record;
+	for (int i = 0; i < fits; i++)
+	{
+		QVERIFY(reader.next(record));
+		QCOMPARE(record.timestamp, static_cast<qint64>(i));
+	}
+
+	QVERIFY(reader.next(record));
+	QCOMPARE(record.direction, CaptureFile::Event);
+	QCOMPARE(record.timestamp, Q_INT64_C(100));
+	QCOMPARE(record.data, QByteArray("Capture fell behind: 10000 bytes in 10 records were not recorded."));
+
+	QVERIFY(reader.next(record));
+	QCOMPARE(record.direction, CaptureFile::Received);
+	QCOMPARE(record.data, data);
+	QVERIFY(!reader.next(record));
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <QObject>
+
+class MemoryBudgetTest
+	: public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void chargeAndRelease();
+	void limits();
+	void totalLimit();
+	void poolReuse();
+	void poolFull();
+	void poolSharedBlock();
+	void captureOverLimit();
+};
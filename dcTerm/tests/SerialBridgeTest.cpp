@@ -0,0 +1,157 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: SerialBridgeTest.cpp - Tests of the TCP bridge over a localhost loopback.
+--
+-- PROGRAM: dcterm_tests
+--
+-- FUNCTIONS:
+-- void broadcastToClients();
+-- void dataFromClient();
+-- void slowClientDropped();
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- The bridge listens on a port picked by the system so the tests never clash with a running
+-- dcTerm, and the clients are plain QTcpSockets in the same thread.
+--------------------------------------------------------------------------------------------------*/
+#include <QHostAddress>
+#include <QTcpSocket>
+#include <QTest>
+
+#include "SerialBridge.h"
+#include "SerialBridgeTest.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: broadcastToClients
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void broadcastToClients (void)
+--
+-- RETURNS: void.
+--------------------------------------------------------------------------------------------------*/
+void SerialBridgeTest::broadcastToClients()
+{
+	SerialBridge bridge;
+	QVERIFY(bridge.startTcp(0));
+	QVERIFY(bridge.tcpPort() != 0);
+
+	QTcpSocket first;
+	QTcpSocket second;
+	first.connectToHost(QHostAddress::LocalHost, bridge.tcpPort());
+	second.connectToHost(QHostAddress::LocalHost, bridge.tcpPort());
+	QVERIFY(first.waitForConnected(5000));
+	QVERIFY(second.waitForConnected(5000));
+	QTRY_COMPARE(bridge.clientCount(), 2);
+
+	bridge.broadcast("hello\r\n");
+	QTRY_COMPARE(first.bytesAvailable(), Q_INT64_C(7));
+	QTRY_COMPARE(second.bytesAvailable(), Q_INT64_C(7));
+	QCOMPARE(first.readAll(), QByteArray("hello\r\n"));
+	QCOMPARE(second.readAll(), QByteArray("hello\r\n"));
+
+	first.disconnectFromHost();
+	QTRY_COMPARE(bridge.clientCount(), 1);
+
+	bridge.stop();
+	QVERIFY(!bridge.isActive());
+	QCOMPARE(bridge.tcpPort(), static_cast<quint16>(0));
+	QTRY_COMPARE(second.state(), QAbstractSocket::UnconnectedState);
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: dataFromClient
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void dataFromClient (void)
+--
+-- RETURNS: void.
+--------------------------------------------------------------------------------------------------*/
+void SerialBridgeTest::dataFromClient()
+{
+	SerialBridge bridge;
+	QVERIFY(bridge.startTcp(0));
+
+	QByteArray received;
+	connect(&bridge, &SerialBridge::dataFromClient,
+		[&received](const QByteArray &data) { received += data; });
+
+	QTcpSocket client;
+	client.connectToHost(QHostAddress::LocalHost, bridge.tcpPort());
+	QVERIFY(client.waitForConnected(5000));
+	client.write("AT\r\n");
+	QTRY_COMPARE(received, QByteArray("AT\r\n"));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: slowClientDropped
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void slowClientDropped (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- A client that never reads is disconnected once its backlog passes the limit, while a client
+-- that keeps up stays connected and keeps receiving. The slow socket's read buffer is limited so
+-- Qt itself stops draining it and the backlog builds up in the bridge.
+--------------------------------------------------------------------------------------------------*/
+void SerialBridgeTest::slowClientDropped()
+{
+	const int chunkSize = 64 * 1024;
+
+	SerialBridge bridge;
+	bridge.setMaxBacklog(chunkSize);
+	QVERIFY(bridge.startTcp(0));
+
+	QTcpSocket fast;
+	QTcpSocket slow;
+	fast.connectToHost(QHostAddress::LocalHost, bridge.tcpPort());
+	slow.connectToHost(QHostAddress::LocalHost, bridge.tcpPort());
+	QVERIFY(fast.waitForConnected(5000));
+	QVERIFY(slow.waitForConnected(5000));
+	QTRY_COMPARE(bridge.clientCount(), 2);
+
+	QByteArray chunk(chunkSize, 'x');
+	slow.setReadBufferSize(1);
+	for (int i = 0; i < 1024 && bridge.clientCount() == 2; i++)
+	{
+		bridge.broadcast(chunk);
+		QByteArray drained;
+		QTRY_COMPARE((drained += fast.readAll()).size(), chunk.size());
+	}
+
+	QCOMPARE(bridge.clientCount(), 1);
+	QCOMPARE(bridge.droppedClients(), 1);
+	QVERIFY(bridge.description().contains("1 dropped as too slow"));
+	QTRY_COMPARE(slow.state(), QAbstractSocket::UnconnectedState);
+
+	bridge.broadcast("still here");
+	QTRY_COMPARE(fast.bytesAvailable(), Q_INT64_C(10));
+}
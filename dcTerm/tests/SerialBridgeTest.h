@@ -0,0 +1,14 @@
+#pragma once
+
+#include <QObject>
+
+class SerialBridgeTest
+	: public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void broadcastToClients();
+	void dataFromClient();
+	void slowClientDropped();
+};
@@ -0,0 +1,93 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: TestMain.cpp - Runs the unit tests of the core library.
+--
+-- PROGRAM: dcterm_tests
+--
+-- FUNCTIONS:
+-- int main(int argc, char* argv[]);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- Every test class is built into one executable. With no arguments every class is run; otherwise
+-- the first argument names the class to run and the rest are passed on to QTest, e.g.
+--
+--     dcterm_tests FrameDecoderTest -v2
+--
+-- CTest runs each class as a test of its own this way, so a failure is reported by class.
+--------------------------------------------------------------------------------------------------*/
+#include <QCoreApplication>
+#include <QStringList>
+#include <QTest>
+#include <QVector>
+
+#include "ByteStoreTest.h"
+#include "CaptureDiffTest.h"
+#include "ControlGlyphsTest.h"
+#include "FrameDecoderTest.h"
+#include "HighlightRulesTest.h"
+#include "LatencyTrackerTest.h"
+#include "MemoryBudgetTest.h"
+#include "SerialBridgeTest.h"
+#include "TimingRecorderTest.h"
+#include "TriggerEngineTest.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: main
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: int main (int argc, char* argv[])
+--
+-- RETURNS: int - the number of tests that failed, or -1 if no class has the name given.
+--------------------------------------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+	QCoreApplication app(argc, argv);
+
+	ByteStoreTest byteStore;
+	CaptureDiffTest captureDiff;
+	ControlGlyphsTest controlGlyphs;
+	FrameDecoderTest frameDecoder;
+	HighlightRulesTest highlightRules;
+	LatencyTrackerTest latencyTracker;
+	MemoryBudgetTest memoryBudget;
+	SerialBridgeTest serialBridge;
+	TimingRecorderTest timingRecorder;
+	TriggerEngineTest triggerEngine;
+
+	QVector<QObject*> tests;
+	tests << &byteStore << &captureDiff << &controlGlyphs << &frameDecoder << &highlightRules
+		<< &latencyTracker << &memoryBudget << &serialBridge << &timingRecorder << &triggerEngine;
+
+	QStringList arguments = app.arguments();
+	QString only;
+	if (arguments.size() > 1 && !arguments[1].startsWith('-'))
+	{
+		only = arguments.takeAt(1);
+	}
+
+	int failed = 0;
+	bool found = false;
+	for (QObject* test : tests)
+	{
+		if (only.isEmpty() || only == test->metaObject()->className())
+		{
+			found = true;
+			failed += QTest::qExec(test, arguments);
+		}
+	}
+	return found ? failed : -1;
+}
@@ -0,0 +1,194 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: TimingRecorderTest.cpp - Tests of the per-batch arrival timing record.
+--
+-- PROGRAM: dcterm_tests
+--
+-- FUNCTIONS:
+-- void batches();
+-- void indexedRange();
+-- void histogram();
+-- void lineEvents();
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--------------------------------------------------------------------------------------------------*/
+#include <QTest>
+#include <QVector>
+
+#include "TimingRecorder.h"
+#include "TimingRecorderTest.h"
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: batches
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void batches (void)
+--
+-- RETURNS: void.
+--------------------------------------------------------------------------------------------------*/
+void TimingRecorderTest::batches()
+{
+	TimingRecorder recorder;
+	recorder.setFormat(115200, 10);
+	QVERIFY(qAbs(recorder.byteTime() - 86.8056) < 0.001);
+
+	recorder.record(1000, 4);
+	recorder.record(2000, 1);
+	recorder.record(2000, 0);
+	recorder.record(5000, 2);
+	QCOMPARE(recorder.batchCount(), 3);
+	QCOMPARE(recorder.byteCount(), Q_INT64_C(7));
+	QCOMPARE(recorder.firstTimestamp(), Q_INT64_C(1000));
+	QCOMPARE(recorder.lastTimestamp(), Q_INT64_C(5000));
+
+	QVector<TimingBatch> out;
+	recorder.batches(1500, 5000, out);
+	QCOMPARE(out.size(), 2);
+	QCOMPARE(out[0].timestamp, Q_INT64_C(2000));
+	QCOMPARE(out[0].size, 1);
+	QCOMPARE(out[1].timestamp, Q_INT64_C(5000));
+	QCOMPARE(out[1].size, 2);
+
+	recorder.batches(0, 999, out);
+	QVERIFY(out.isEmpty());
+
+	recorder.clear();
+	QCOMPARE(recorder.batchCount(), 0);
+	recorder.batches(0, 10000, out);
+	QVERIFY(out.isEmpty());
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: indexedRange
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void indexedRange (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- A range far into a long record is decoded from the nearest index entry, and the record stays
+-- at a few bytes per batch.
+--------------------------------------------------------------------------------------------------*/
+void TimingRecorderTest::indexedRange()
+{
+	const int count = 5 * TimingRecorder::INDEX_INTERVAL;
+
+	TimingRecorder recorder;
+	recorder.setFormat(9600, 10);
+	for (int i = 0; i < count; i++)
+	{
+		recorder.record(10 * i, 1 + i % 3);
+	}
+	QVERIFY(recorder.memoryUsage() < 4 * count);
+
+	QVector<TimingBatch> out;
+	recorder.batches(30715, 30765, out);
+	QCOMPARE(out.size(), 5);
+	for (int n = 0; n < out.size(); n++)
+	{
+		int i = 3072 + n;
+		QCOMPARE(out[n].timestamp, static_cast<qint64>(10 * i));
+		QCOMPARE(out[n].size, 1 + i % 3);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: histogram
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void histogram (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- At 100 us a character, the bytes within a batch are 100 us apart (bucket 7, 64 to 128 us), and
+-- the 1000 us between two batches lands in bucket 10 (512 to 1024 us).
+--------------------------------------------------------------------------------------------------*/
+void TimingRecorderTest::histogram()
+{
+	TimingRecorder recorder;
+	recorder.setFormat(100000, 10);
+	recorder.record(0, 3);
+	recorder.record(1000, 1);
+
+	const QVector<quint64> &histogram = recorder.histogram();
+	QCOMPARE(histogram.size(), static_cast<int>(TimingRecorder::HISTOGRAM_BUCKETS));
+	QCOMPARE(histogram[7], Q_UINT64_C(2));
+	QCOMPARE(histogram[10], Q_UINT64_C(1));
+
+	quint64 total = 0;
+	for (quint64 n : histogram)
+	{
+		total += n;
+	}
+	QCOMPARE(total, Q_UINT64_C(3));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: lineEvents
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void lineEvents (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- A range of control line events comes with the state the lines were in before it, and an event
+-- stamped earlier than the last one is moved up to it.
+--------------------------------------------------------------------------------------------------*/
+void TimingRecorderTest::lineEvents()
+{
+	TimingRecorder recorder;
+	recorder.recordLines(100, 0x1);
+	recorder.recordLines(200, 0x3);
+	recorder.recordLines(300, 0x2);
+	recorder.recordLines(250, 0x6);
+	QCOMPARE(recorder.lastLineTimestamp(), Q_INT64_C(300));
+
+	QVector<LineEvent> out;
+	QCOMPARE(recorder.lineEvents(150, 250, out), 0x1u);
+	QCOMPARE(out.size(), 1);
+	QCOMPARE(out[0].timestamp, Q_INT64_C(200));
+	QCOMPARE(out[0].lines, 0x3u);
+
+	QCOMPARE(recorder.lineEvents(300, 300, out), 0x3u);
+	QCOMPARE(out.size(), 2);
+	QCOMPARE(out[1].lines, 0x6u);
+
+	QCOMPARE(recorder.lineEvents(0, 50, out), 0u);
+	QVERIFY(out.isEmpty());
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <QObject>
+
+class TimingRecorderTest
+	: public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void batches();
+	void indexedRange();
+	void histogram();
+	void lineEvents();
+};
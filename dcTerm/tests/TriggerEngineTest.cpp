@@ -0,0 +1,382 @@
+/*--------------------------------------------------------------------------------------------------
+-- SOURCE FILE: TriggerEngineTest.cpp - Tests of the Aho-Corasick matcher and trigger rules.
+--
+-- PROGRAM: dcterm_tests
+--
+-- FUNCTIONS:
+-- void overlappingPatterns();
+-- void patternAcrossChunks();
+-- void literalRules();
+-- void regexRules();
+-- void overlappingRegexRules();
+-- void regexPrompt();
+-- void regexAcrossChunks();
+-- void loadRules();
+-- void loadRulesError();
+--
+-- Hits process(TriggerEngine &engine, const QList<QByteArray> &chunks);
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS:
+-- October 18, 2026 - Add tests of overlapping regex rules, prompts and partial lines.
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- NOTES:
+-- Matches are compared as (rule, end) pairs with end counted from the start of the stream, sorted
+-- so rules that end on the same byte compare the same whichever is reported first.
+--------------------------------------------------------------------------------------------------*/
+#include <algorithm>
+
+#include <QList>
+#include <QPair>
+#include <QTemporaryFile>
+#include <QTest>
+#include <QVector>
+
+#include "AhoCorasick.h"
+#include "TriggerEngine.h"
+#include "TriggerEngineTest.h"
+
+namespace
+{
+	typedef QVector<QPair<int, int> > Hits;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: process
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: Hits process (TriggerEngine &engine, const QList<QByteArray> &chunks)
+--
+-- RETURNS: Hits - every match as (rule, end of the match in the whole stream), sorted.
+--------------------------------------------------------------------------------------------------*/
+static Hits process(TriggerEngine &engine, const QList<QByteArray> &chunks)
+{
+	Hits hits;
+	QVector<TriggerMatch> matches;
+	int base = 0;
+	for (const QByteArray &chunk : chunks)
+	{
+		matches.clear();
+		engine.process(chunk.constData(), chunk.size(), matches);
+		for (const TriggerMatch &match : matches)
+		{
+			hits.append(qMakePair(match.rule, base + match.end));
+		}
+		base += chunk.size();
+	}
+	std::sort(hits.begin(), hits.end());
+	return hits;
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: overlappingPatterns
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void overlappingPatterns (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- The textbook example: "ushers" holds "she" and "he" ending together and "hers" after them.
+--------------------------------------------------------------------------------------------------*/
+void TriggerEngineTest::overlappingPatterns()
+{
+	AhoCorasick matcher;
+	QCOMPARE(matcher.addPattern("he"), 0);
+	QCOMPARE(matcher.addPattern("she"), 1);
+	QCOMPARE(matcher.addPattern("his"), 2);
+	QCOMPARE(matcher.addPattern("hers"), 3);
+	matcher.build();
+	QCOMPARE(matcher.patternCount(), 4);
+
+	Hits hits;
+	QByteArray text("ushers");
+	int state = 0;
+	for (int i = 0; i < text.size(); i++)
+	{
+		state = matcher.next(state, static_cast<unsigned char>(text[i]));
+		for (int n = 0; n < matcher.matchCount(state); n++)
+		{
+			hits.append(qMakePair(matcher.matches(state)[n], i + 1));
+		}
+	}
+	std::sort(hits.begin(), hits.end());
+
+	QCOMPARE(hits, Hits() << qMakePair(0, 4) << qMakePair(1, 4) << qMakePair(3, 6));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: patternAcrossChunks
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void patternAcrossChunks (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- A partial match is kept from one chunk to the next until reset() forgets it.
+--------------------------------------------------------------------------------------------------*/
+void TriggerEngineTest::patternAcrossChunks()
+{
+	TriggerRule login = { TriggerRule::Literal, "login: ", TriggerRule::Send, "root\\r" };
+	TriggerEngine engine;
+	engine.setRules(QVector<TriggerRule>() << login);
+
+	QCOMPARE(process(engine, QList<QByteArray>() << "Welcome\r\nlog" << "in: "), Hits() << qMakePair(0, 16));
+
+	QVector<TriggerMatch> matches;
+	engine.process("log", 3, matches);
+	engine.reset();
+	QCOMPARE(process(engine, QList<QByteArray>() << "in: "), Hits());
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: literalRules
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void literalRules (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Escapes in literal patterns are turned into bytes and every rule that ends on a byte fires.
+--------------------------------------------------------------------------------------------------*/
+void TriggerEngineTest::literalRules()
+{
+	TriggerRule ok = { TriggerRule::Literal, "OK", TriggerRule::Beep, QString() };
+	TriggerRule lineOk = { TriggerRule::Literal, "\\r\\nOK", TriggerRule::Highlight, "green" };
+	TriggerEngine engine;
+	engine.setRules(QVector<TriggerRule>() << ok << lineOk);
+	QVERIFY(!engine.isEmpty());
+
+	QCOMPARE(process(engine, QList<QByteArray>() << "AT\r\nOK\r\nOK"),
+		Hits() << qMakePair(0, 6) << qMakePair(0, 10) << qMakePair(1, 6) << qMakePair(1, 10));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: regexRules
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void regexRules (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Both regex rules match the same line, one with a group of its own.
+--------------------------------------------------------------------------------------------------*/
+void TriggerEngineTest::regexRules()
+{
+	TriggerRule temp = { TriggerRule::Regex, "temp=(\\d+)", TriggerRule::Beep, QString() };
+	TriggerRule hum = { TriggerRule::Regex, "hum=\\d+", TriggerRule::Beep, QString() };
+	TriggerEngine engine;
+	engine.setRules(QVector<TriggerRule>() << temp << hum);
+
+	QCOMPARE(process(engine, QList<QByteArray>() << "sensor temp=41 hum=33\r\n"),
+		Hits() << qMakePair(0, 22) << qMakePair(1, 22));
+	QCOMPARE(process(engine, QList<QByteArray>() << "no reading\r\n"), Hits());
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: overlappingRegexRules
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void overlappingRegexRules (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Rules matching the same text all fire, and a backreference refers to the rule's own group.
+--------------------------------------------------------------------------------------------------*/
+void TriggerEngineTest::overlappingRegexRules()
+{
+	TriggerRule temp = { TriggerRule::Regex, "temp=\\d+", TriggerRule::Beep, QString() };
+	TriggerRule digits = { TriggerRule::Regex, "\\d+", TriggerRule::Beep, QString() };
+	TriggerRule repeated = { TriggerRule::Regex, "(\\w)\\1", TriggerRule::Beep, QString() };
+	TriggerEngine engine;
+	engine.setRules(QVector<TriggerRule>() << temp << digits << repeated);
+
+	QCOMPARE(process(engine, QList<QByteArray>() << "hello temp=41\r\n"),
+		Hits() << qMakePair(0, 14) << qMakePair(1, 14) << qMakePair(2, 14));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: regexPrompt
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void regexPrompt (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- A prompt is never followed by a line ending, so it must fire from the partial line, and only
+-- once when the line is later finished.
+--------------------------------------------------------------------------------------------------*/
+void TriggerEngineTest::regexPrompt()
+{
+	TriggerRule login = { TriggerRule::Regex, "login:\\s*$", TriggerRule::Send, "root\\r" };
+	TriggerEngine engine;
+	engine.setRules(QVector<TriggerRule>() << login);
+
+	QCOMPARE(process(engine, QList<QByteArray>() << "Welcome\r\nlog" << "in: " << "\r\n"),
+		Hits() << qMakePair(0, 16));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: regexAcrossChunks
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void regexAcrossChunks (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- Each rule fires as soon as it matches what has arrived of the line, and the same match is not
+-- reported again as the line grows.
+--------------------------------------------------------------------------------------------------*/
+void TriggerEngineTest::regexAcrossChunks()
+{
+	TriggerRule temp = { TriggerRule::Regex, "temp=\\d+", TriggerRule::Beep, QString() };
+	TriggerRule hum = { TriggerRule::Regex, "hum=\\d", TriggerRule::Beep, QString() };
+	TriggerEngine engine;
+	engine.setRules(QVector<TriggerRule>() << temp << hum);
+
+	QCOMPARE(process(engine, QList<QByteArray>() << "temp=4" << "1 hum" << "=3\r\n"),
+		Hits() << qMakePair(0, 6) << qMakePair(1, 14));
+	QCOMPARE(process(engine, QList<QByteArray>() << "temp=5 temp=6\n"),
+		Hits() << qMakePair(0, 14) << qMakePair(0, 14));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: loadRules
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void loadRules (void)
+--
+-- RETURNS: void.
+--------------------------------------------------------------------------------------------------*/
+void TriggerEngineTest::loadRules()
+{
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	file.write("# answer the prompt\n"
+		"\n"
+		"literal\tlogin:\\x20\tsend\troot\\r\n"
+		"regex\tpanic.*\tcapture-start\n");
+	file.close();
+
+	TriggerEngine engine;
+	QString error;
+	QVERIFY(engine.loadRules(file.fileName(), &error));
+	QCOMPARE(engine.rules().size(), 2);
+	QCOMPARE(engine.rules()[0].kind, TriggerRule::Literal);
+	QCOMPARE(engine.rules()[0].action, TriggerRule::Send);
+	QCOMPARE(engine.rules()[0].argument, QString("root\\r"));
+	QCOMPARE(engine.rules()[1].kind, TriggerRule::Regex);
+	QCOMPARE(engine.rules()[1].action, TriggerRule::StartCapture);
+
+	QCOMPARE(process(engine, QList<QByteArray>() << "login: "), Hits() << qMakePair(0, 7));
+}
+
+/*--------------------------------------------------------------------------------------------------
+-- FUNCTION: loadRulesError
+--
+-- DATE: October 18, 2026
+--
+-- REVISIONS: N/A
+--
+-- DESIGNER: Benny Wang
+--
+-- PROGRAMMER: Benny Wang
+--
+-- INTERFACE: void loadRulesError (void)
+--
+-- RETURNS: void.
+--
+-- NOTES:
+-- A bad line is reported by number and leaves the rules already loaded in place.
+--------------------------------------------------------------------------------------------------*/
+void TriggerEngineTest::loadRulesError()
+{
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	file.write("literal\tOK\tbeep\n"
+		"regex\t(unclosed\tbeep\n");
+	file.close();
+
+	TriggerRule ok = { TriggerRule::Literal, "OK", TriggerRule::Beep, QString() };
+	TriggerEngine engine;
+	engine.setRules(QVector<TriggerRule>() << ok << ok << ok);
+
+	QString error;
+	QVERIFY(!engine.loadRules(file.fileName(), &error));
+	QVERIFY(error.startsWith("Line 2:"));
+	QCOMPARE(engine.rules().size(), 3);
+}
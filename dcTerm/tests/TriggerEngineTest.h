@@ -0,0 +1,20 @@
+#pragma once
+
+#include <QObject>
+
+class TriggerEngineTest
+	: public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void overlappingPatterns();
+	void patternAcrossChunks();
+	void literalRules();
+	void regexRules();
+	void overlappingRegexRules();
+	void regexPrompt();
+	void regexAcrossChunks();
+	void loadRules();
+	void loadRulesError();
+};